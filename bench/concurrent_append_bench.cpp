@@ -0,0 +1,74 @@
+// Concurrent append throughput: concurrent_append_list against a dsl::list guarded by a mutex.
+//
+// One container is shared by all benchmark threads for a run, created in Setup and freed in
+// Teardown, and every thread appends count values per iteration; the iteration count is fixed to
+// bound the memory held. Run with --benchmark_out=<file> --benchmark_out_format=json to record
+// results.
+
+#include "concurrent_append_list.h"
+#include "list.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+
+namespace {
+
+    struct locked_list {
+        std::mutex m_mutex;
+        dsl::list<std::uint64_t> m_list;
+
+        void push_back(const std::uint64_t value) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_list.push_back(value);
+        }
+    };
+
+    std::unique_ptr<locked_list> shared_locked;
+    std::unique_ptr<dsl::concurrent_append_list<std::uint64_t>> shared_concurrent;
+
+
+    //*** Benchmarks ***//
+
+    void setup(const benchmark::State&) {
+        shared_locked = std::make_unique<locked_list>();
+        shared_concurrent = std::make_unique<dsl::concurrent_append_list<std::uint64_t>>();
+    }
+
+    void teardown(const benchmark::State&) {
+        shared_locked.reset();
+        shared_concurrent.reset();
+    }
+
+    template <class Container>
+    void run_appends(benchmark::State &state, Container &shared) {
+        auto count = static_cast<std::uint64_t>(state.range(0));
+        for (auto _ : state) {
+            for (std::uint64_t i = 0; i < count; ++i)
+                shared.push_back(i);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+    }
+
+    void bm_locked_list_append(benchmark::State &state) {
+        run_appends(state, *shared_locked);
+    }
+
+    void bm_concurrent_append(benchmark::State &state) {
+        run_appends(state, *shared_concurrent);
+    }
+
+}   // namespace
+
+
+BENCHMARK(bm_locked_list_append)
+    ->Setup(setup)->Teardown(teardown)
+    ->Arg(1 << 14)->Iterations(64)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(bm_concurrent_append)
+    ->Setup(setup)->Teardown(teardown)
+    ->Arg(1 << 14)->Iterations(64)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
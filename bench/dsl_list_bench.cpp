@@ -0,0 +1,300 @@
+// Compares the dsl containers against their standard library counterparts.
+//
+// Every benchmark is instantiated for three element sizes and three upstream memory resources,
+// with the standard containers using the std::pmr aliases so that both sides allocate from the
+// same resource. Run the dsl_list_bench_json target (or pass --benchmark_out=<file>
+// --benchmark_out_format=json) to record results for comparison between releases.
+
+#include "doubly_linked_list.h"
+#include "list.h"
+#include "singly_linked_list.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+namespace {
+
+    //*** Element types ***//
+
+    /**
+     * @brief Element of Size bytes, ordered by a leading key so that sorting does the same work
+     * regardless of the payload.
+     */
+    template <std::size_t Size>
+    struct payload {
+        std::uint64_t key;
+        std::byte padding[Size - sizeof(std::uint64_t)];
+
+        payload(std::uint64_t k = 0) : key(k), padding() {}
+
+        bool operator<(const payload &other) const noexcept { return key < other.key; }
+    };
+
+    template <>
+    struct payload<sizeof(std::uint64_t)> {
+        std::uint64_t key;
+
+        payload(std::uint64_t k = 0) : key(k) {}
+
+        bool operator<(const payload &other) const noexcept { return key < other.key; }
+    };
+
+
+    //*** Memory resources ***//
+
+    enum class resource_kind { new_delete, monotonic, pool };
+
+    const char* resource_name(const resource_kind kind) {
+        switch (kind) {
+            case resource_kind::new_delete: return "new_delete";
+            case resource_kind::monotonic:  return "monotonic";
+            default:                        return "pool";
+        }
+    }
+
+    /**
+     * @brief Owns the resource for a single benchmark iteration, so that monotonic and pool
+     * resources release everything between iterations.
+     */
+    class scoped_resource {
+    public:
+        explicit scoped_resource(const resource_kind kind) {
+            if (kind == resource_kind::monotonic)
+                m_resource = &m_monotonic.emplace();
+            else if (kind == resource_kind::pool)
+                m_resource = &m_pool.emplace();
+            else
+                m_resource = std::pmr::new_delete_resource();
+        }
+
+        std::pmr::memory_resource* get() const noexcept { return m_resource; }
+
+    private:
+        std::optional<std::pmr::monotonic_buffer_resource> m_monotonic;
+        std::optional<std::pmr::unsynchronized_pool_resource> m_pool;
+        std::pmr::memory_resource *m_resource = nullptr;
+    };
+
+
+    //*** Container traits ***//
+
+    template <class Container>
+    inline constexpr bool is_forward_v = false;
+
+    template <class Tp>
+    inline constexpr bool is_forward_v<dsl::singly_linked_list<Tp>> = true;
+
+    template <class Tp>
+    inline constexpr bool is_forward_v<std::pmr::forward_list<Tp>> = true;
+
+    template <class Container>
+    inline constexpr bool is_contiguous_v = false;
+
+    template <class Tp>
+    inline constexpr bool is_contiguous_v<dsl::list<Tp>> = true;
+
+    template <class Tp>
+    inline constexpr bool is_contiguous_v<std::pmr::vector<Tp>> = true;
+
+    template <class Container>
+    void append(Container &c, const std::uint64_t key) {
+        if constexpr (is_forward_v<Container>)
+            c.push_front(key);
+        else
+            c.push_back(key);
+    }
+
+    /**
+     * @brief Fills with count pseudo-random keys, so that sort has work to do.
+     */
+    template <class Container>
+    void fill(Container &c, const std::size_t count) {
+        std::mt19937_64 rng(count);
+        for (std::size_t i = 0; i < count; ++i)
+            append(c, rng());
+    }
+
+
+    //*** Benchmarks ***//
+
+    template <class Container>
+    void bm_push(benchmark::State &state, const resource_kind kind) {
+        auto count = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state) {
+            scoped_resource resource(kind);
+            Container c(resource.get());
+            for (std::size_t i = 0; i < count; ++i)
+                append(c, i);
+            benchmark::DoNotOptimize(c);
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    /**
+     * @brief Inserts and then erases at the middle of a filled container. The linked containers
+     * are handed an iterator to the middle, which is their intended use; the arrays shift.
+     *
+     * A monotonic resource never reuses what is erased, so with one the resource and container
+     * are rebuilt, untimed, every rebuild_interval iterations to bound the memory held.
+     */
+    template <class Container>
+    void bm_insert_erase_middle(benchmark::State &state, const resource_kind kind) {
+        constexpr std::size_t rebuild_interval = 1 << 14;
+
+        auto count = static_cast<std::size_t>(state.range(0));
+        std::optional<scoped_resource> resource;
+        std::optional<Container> c;
+        typename Container::iterator middle;
+
+        auto rebuild = [&] {
+            c.reset();
+            resource.emplace(kind);
+            c.emplace(resource->get());
+            fill(*c, count);
+            middle = std::next(c->begin(), count / 2);
+        };
+        rebuild();
+
+        std::size_t since_rebuild = 0;
+        for (auto _ : state) {
+            if (kind == resource_kind::monotonic && ++since_rebuild == rebuild_interval) {
+                state.PauseTiming();
+                rebuild();
+                since_rebuild = 0;
+                state.ResumeTiming();
+            }
+
+            if constexpr (is_forward_v<Container>) {
+                c->insert_after(middle, 1);
+                c->erase_after(middle);
+            } else if constexpr (is_contiguous_v<Container>) {
+                auto it = c->insert(std::next(c->begin(), count / 2), 1);
+                c->erase(it);
+            } else {
+                auto it = c->insert(middle, 1);
+                c->erase(it);
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * 2);
+    }
+
+    template <class Container>
+    void bm_iterate(benchmark::State &state, const resource_kind kind) {
+        auto count = static_cast<std::size_t>(state.range(0));
+        scoped_resource resource(kind);
+        Container c(resource.get());
+        fill(c, count);
+
+        for (auto _ : state) {
+            std::uint64_t sum = 0;
+            for (const auto &value : c)
+                sum += value.key;
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    template <class Container>
+    void bm_copy(benchmark::State &state, const resource_kind kind) {
+        auto count = static_cast<std::size_t>(state.range(0));
+        scoped_resource source_resource(kind);
+        Container source(source_resource.get());
+        fill(source, count);
+
+        for (auto _ : state) {
+            scoped_resource resource(kind);
+            Container c(source, resource.get());
+            benchmark::DoNotOptimize(c);
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    template <class Container>
+    void bm_sort(benchmark::State &state, const resource_kind kind) {
+        auto count = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state) {
+            state.PauseTiming();
+            scoped_resource resource(kind);
+            {
+                Container c(resource.get());
+                fill(c, count);
+                state.ResumeTiming();
+
+                if constexpr (is_contiguous_v<Container>)
+                    std::sort(c.begin(), c.end());
+                else
+                    c.sort();
+                benchmark::DoNotOptimize(c);
+
+                state.PauseTiming();
+            }
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+
+    //*** Registration ***//
+
+    constexpr resource_kind resource_kinds[] = { resource_kind::new_delete, resource_kind::monotonic, resource_kind::pool };
+
+    template <class Container>
+    void register_container(const std::string &container, const std::size_t element_size) {
+        for (auto kind : resource_kinds) {
+            auto suffix = "<" + std::to_string(element_size) + "B," + resource_name(kind) + ">";
+
+            benchmark::RegisterBenchmark((container + "/push" + suffix).c_str(), bm_push<Container>, kind)
+                ->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+            benchmark::RegisterBenchmark((container + "/insert_erase_middle" + suffix).c_str(), bm_insert_erase_middle<Container>, kind)
+                ->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+            benchmark::RegisterBenchmark((container + "/iterate" + suffix).c_str(), bm_iterate<Container>, kind)
+                ->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+            benchmark::RegisterBenchmark((container + "/copy" + suffix).c_str(), bm_copy<Container>, kind)
+                ->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+            benchmark::RegisterBenchmark((container + "/sort" + suffix).c_str(), bm_sort<Container>, kind)
+                ->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+        }
+    }
+
+    template <std::size_t Size>
+    void register_element_size() {
+        using value_t = payload<Size>;
+
+        register_container<dsl::list<value_t>>("dsl::list", Size);
+        register_container<std::pmr::vector<value_t>>("std::vector", Size);
+        register_container<dsl::singly_linked_list<value_t>>("dsl::singly_linked_list", Size);
+        register_container<std::pmr::forward_list<value_t>>("std::forward_list", Size);
+        register_container<dsl::doubly_linked_list<value_t>>("dsl::doubly_linked_list", Size);
+        register_container<std::pmr::list<value_t>>("std::list", Size);
+    }
+
+}   // namespace
+
+
+int main(int argc, char **argv) {
+    register_element_size<8>();
+    register_element_size<64>();
+    register_element_size<256>();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Fork/join benchmarks for work_stealing_pool, and the owner and thief paths of work_stealing_deque.
+//
+// fib recursively joins its two halves down to a serial cutoff, which makes it almost entirely
+// scheduling overhead above the cutoff; the serial version is the baseline. Run with
+// --benchmark_out=<file> --benchmark_out_format=json to record results.
+
+#include "work_stealing_pool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+
+namespace {
+
+    std::uint64_t fib_serial(const unsigned n) {
+        return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+    }
+
+    std::uint64_t fib_forked(dsl::work_stealing_pool &pool, const unsigned n, const unsigned cutoff) {
+        if (n <= cutoff)
+            return fib_serial(n);
+
+        std::uint64_t lhs = 0, rhs = 0;
+        pool.join([&] { lhs = fib_forked(pool, n - 1, cutoff); },
+                  [&] { rhs = fib_forked(pool, n - 2, cutoff); });
+        return lhs + rhs;
+    }
+
+
+    //*** Benchmarks ***//
+
+    void bm_fib_serial(benchmark::State &state) {
+        auto n = static_cast<unsigned>(state.range(0));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(fib_serial(n));
+    }
+
+    // range(0): n, range(1): serial cutoff, range(2): worker threads
+    void bm_fib_fork_join(benchmark::State &state) {
+        auto n = static_cast<unsigned>(state.range(0));
+        auto cutoff = static_cast<unsigned>(state.range(1));
+        dsl::work_stealing_pool pool(static_cast<std::size_t>(state.range(2)));
+
+        for (auto _ : state) {
+            std::uint64_t result = 0;
+            pool.run([&] { result = fib_forked(pool, n, cutoff); });
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    void bm_deque_push_pop(benchmark::State &state) {
+        auto count = state.range(0);
+        dsl::work_stealing_deque<std::intptr_t> deque;
+
+        for (auto _ : state) {
+            for (std::intptr_t i = 0; i < count; ++i)
+                deque.push(i);
+            while (auto value = deque.pop())
+                benchmark::DoNotOptimize(*value);
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    // The owner pushes and pops while one thief steals continuously
+    void bm_deque_contended(benchmark::State &state) {
+        auto count = state.range(0);
+        dsl::work_stealing_deque<std::intptr_t> deque;
+        std::atomic<bool> stop(false);
+
+        std::thread thief([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (auto value = deque.steal())
+                    benchmark::DoNotOptimize(*value);
+            }
+        });
+
+        for (auto _ : state) {
+            for (std::intptr_t i = 0; i < count; ++i)
+                deque.push(i);
+            while (auto value = deque.pop())
+                benchmark::DoNotOptimize(*value);
+        }
+
+        stop.store(true, std::memory_order_relaxed);
+        thief.join();
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+}   // namespace
+
+
+BENCHMARK(bm_fib_serial)->Arg(30);
+BENCHMARK(bm_fib_fork_join)
+    ->ArgsProduct({ { 30 }, { 10, 16, 20 }, { 1, 2, 4, 8 } })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_deque_push_pop)->Range(1 << 8, 1 << 16);
+BENCHMARK(bm_deque_contended)->Range(1 << 8, 1 << 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,461 @@
+#ifndef DSL_CHANNEL_H
+#define DSL_CHANNEL_H
+
+
+#include "executor.h"
+#include "singly_linked_list.h"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+
+namespace dsl {
+
+    namespace details {
+
+        /**
+         * @brief Test-and-test-and-set lock for critical sections of a few pointer updates, which
+         * yields the thread once spinning has gone on for long enough to suggest preemption.
+         */
+        class spin_lock {
+        public:
+            void lock() noexcept {
+                for (unsigned spins = 0; m_locked.exchange(true, std::memory_order_acquire); ) {
+                    while (m_locked.load(std::memory_order_relaxed)) {
+                        if (++spins > spin_limit)
+                            std::this_thread::yield();
+                    }
+                }
+            }
+
+            void unlock() noexcept {
+                m_locked.store(false, std::memory_order_release);
+            }
+
+        private:
+            static constexpr unsigned spin_limit = 64;
+
+            std::atomic<bool> m_locked{ false };
+        };
+
+        /**
+         * @brief Intrusive FIFO of the awaiters suspended on a channel. The awaiters live in the
+         * frames of their coroutines, so queueing one allocates nothing.
+         *
+         * @tparam Waiter Type with a Waiter* m_next member
+         */
+        template <class Waiter>
+        class waiter_queue {
+        public:
+            [[nodiscard]] bool empty() const noexcept {
+                return m_head == nullptr;
+            }
+
+            void push(Waiter *waiter) noexcept {
+                waiter->m_next = nullptr;
+                if (m_head)
+                    m_tail->m_next = waiter;
+                else
+                    m_head = waiter;
+                m_tail = waiter;
+            }
+
+            [[nodiscard]] Waiter* front() const noexcept {
+                return m_head;
+            }
+
+            Waiter* pop() noexcept {
+                auto waiter = m_head;
+                if (waiter)
+                    m_head = waiter->m_next;
+                return waiter;
+            }
+
+            // Detaches every waiter, returning the former head of the chain
+            Waiter* take() noexcept {
+                return std::exchange(m_head, nullptr);
+            }
+
+        private:
+            Waiter *m_head = nullptr;
+            Waiter *m_tail = nullptr;
+        };
+
+    }   // namespace details
+
+
+    /**
+     * @brief Asynchronous FIFO channel between coroutines: co_await ch.send(value) suspends while
+     * the channel is full, and co_await ch.receive() suspends while it is empty. Values are handed
+     * directly to a suspended receiver when there is one, and are otherwise buffered in a chain
+     * of singly_node, whose nodes are recycled rather than freed. A capacity of 0 makes every
+     * send wait for a receiver.
+     *
+     * Send and receive complete without suspending whenever they can; the channel state is then
+     * guarded by a spin lock held for a few pointer updates, not by a mutex. Coroutines woken by
+     * the other side are posted to the channel's executor and never resumed inline.
+     *
+     * After close(), sends complete with false and receives drain the buffer, then complete with
+     * an empty optional. No coroutine may be suspended on a channel when it is destroyed.
+     *
+     * @tparam Tp
+     */
+    template <typename Tp>
+    class channel {
+    private:
+        using node_t = details::singly_node<Tp>;
+        using node_base_t = details::singly_node_base<Tp>;
+
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = Tp;
+        using size_type = std::size_t;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        static constexpr size_type unbounded = std::numeric_limits<size_type>::max();
+
+        class send_awaiter;
+        class receive_awaiter;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit channel(executor &ex,
+                         const size_type capacity = unbounded,
+                         allocator_type allocator = {})
+            : m_executor(&ex)
+            , m_capacity(capacity)
+            , m_allocator(allocator)
+            , m_head()
+            , m_tail(&m_head)
+            , m_free(nullptr)
+            , m_size(0)
+            , m_closed(false)
+        {}
+
+        channel(const channel&) = delete;
+        channel& operator=(const channel&) = delete;
+
+
+        //* Destructor *//
+
+        ~channel();
+
+
+        //* Capacity *//
+
+        [[nodiscard]] size_type capacity() const noexcept {
+            return m_capacity;
+        }
+
+        [[nodiscard]] bool is_closed() const noexcept {
+            std::lock_guard<details::spin_lock> lock(m_lock);
+            return m_closed;
+        }
+
+
+        //* Modifiers *//
+
+        [[nodiscard]] send_awaiter send(const Tp &value) {
+            return send_awaiter(*this, value);
+        }
+
+        [[nodiscard]] send_awaiter send(Tp &&value) {
+            return send_awaiter(*this, std::move(value));
+        }
+
+        [[nodiscard]] receive_awaiter receive() noexcept {
+            return receive_awaiter(*this);
+        }
+
+        void close();
+
+
+    private:
+
+        //*** Members ***//
+
+        executor *m_executor;
+        size_type m_capacity;
+        allocator_type m_allocator;
+
+        mutable details::spin_lock m_lock;
+        node_base_t m_head;
+        node_base_t *m_tail;
+        node_base_t *m_free;
+        size_type m_size;
+        bool m_closed;
+
+        details::waiter_queue<send_awaiter> m_senders;
+        details::waiter_queue<receive_awaiter> m_receivers;
+
+
+        //*** Functions ***//
+
+        void push_value(Tp&&);
+        Tp pop_value();
+
+        bool suspend_sender(send_awaiter&, std::coroutine_handle<>);
+        bool suspend_receiver(receive_awaiter&, std::coroutine_handle<>);
+    };
+
+
+    /**
+     * @brief Awaitable returned by send. Resumes with true once the value is buffered or handed
+     * to a receiver, and with false if the channel is closed first.
+     */
+    template <typename Tp>
+    class channel<Tp>::send_awaiter {
+    public:
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(const std::coroutine_handle<> handle) {
+            return m_channel->suspend_sender(*this, handle);
+        }
+
+        bool await_resume() const noexcept {
+            return m_sent;
+        }
+
+    private:
+        friend class channel<Tp>;
+        friend class details::waiter_queue<send_awaiter>;
+
+        template <typename Up>
+        send_awaiter(channel &ch, Up &&value)
+            : m_channel(&ch)
+            , m_value(std::forward<Up>(value))
+            , m_sent(false)
+            , m_handle()
+            , m_next(nullptr) {}
+
+        channel *m_channel;
+        Tp m_value;
+        bool m_sent;
+        std::coroutine_handle<> m_handle;
+        send_awaiter *m_next;
+    };
+
+    /**
+     * @brief Awaitable returned by receive. Resumes with the next value, or with an empty
+     * optional once the channel is closed and drained.
+     */
+    template <typename Tp>
+    class channel<Tp>::receive_awaiter {
+    public:
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(const std::coroutine_handle<> handle) {
+            return m_channel->suspend_receiver(*this, handle);
+        }
+
+        std::optional<Tp> await_resume() {
+            return std::move(m_result);
+        }
+
+    private:
+        friend class channel<Tp>;
+        friend class details::waiter_queue<receive_awaiter>;
+
+        explicit receive_awaiter(channel &ch) noexcept
+            : m_channel(&ch)
+            , m_result()
+            , m_handle()
+            , m_next(nullptr) {}
+
+        channel *m_channel;
+        std::optional<Tp> m_result;
+        std::coroutine_handle<> m_handle;
+        receive_awaiter *m_next;
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    /**
+     * @brief Appends value to the buffer, reusing a recycled node if there is one.
+     * Must be called with the lock held.
+     */
+    template <typename Tp>
+    void channel<Tp>::push_value(Tp &&value) {
+        node_t *node;
+        if (m_free) {
+            node = static_cast<node_t*>(std::exchange(m_free, m_free->m_next));
+        } else {
+            node = m_allocator.template allocate_object<node_t>();
+            ::new (static_cast<void*>(node)) node_base_t();
+        }
+
+        try {
+            std::allocator_traits<allocator_type>::construct(m_allocator, std::addressof(node->m_value), std::move(value));
+        } catch (...) {
+            node->m_next = m_free;
+            m_free = node;
+            throw;
+        }
+
+        node->m_next = nullptr;
+        m_tail->m_next = node;
+        m_tail = node;
+        ++m_size;
+    }
+
+    /**
+     * @brief Removes the front of the buffer, recycling its node. Must be called with the lock
+     * held on a non-empty buffer.
+     */
+    template <typename Tp>
+    Tp channel<Tp>::pop_value() {
+        auto node = static_cast<node_t*>(m_head.m_next);
+        Tp value(std::move(node->m_value));
+
+        std::allocator_traits<allocator_type>::destroy(m_allocator, std::addressof(node->m_value));
+        m_head.m_next = node->m_next;
+        if (m_tail == node)
+            m_tail = &m_head;
+        --m_size;
+
+        node->m_next = m_free;
+        m_free = node;
+        return value;
+    }
+
+    /**
+     * @brief Completes a send without suspending if the channel is closed, a receiver is waiting
+     * or there is room in the buffer; otherwise queues the sender. Returns whether to suspend.
+     */
+    template <typename Tp>
+    bool channel<Tp>::suspend_sender(send_awaiter &sender, const std::coroutine_handle<> handle) {
+        receive_awaiter *receiver;
+        {
+            std::lock_guard<details::spin_lock> lock(m_lock);
+            if (m_closed)
+                return false;
+
+            // A waiting receiver is dequeued only once it holds the value, so that a throwing move leaves it queued
+            if ((receiver = m_receivers.front())) {
+                receiver->m_result.emplace(std::move(sender.m_value));
+                m_receivers.pop();
+            } else if (m_size < m_capacity) {
+                push_value(std::move(sender.m_value));
+            } else {
+                sender.m_handle = handle;
+                m_senders.push(&sender);
+                return true;
+            }
+        }
+
+        sender.m_sent = true;
+        if (receiver)
+            m_executor->post(receiver->m_handle);
+        return false;
+    }
+
+    /**
+     * @brief Completes a receive without suspending if a value is buffered or a sender is waiting,
+     * or if the channel is closed; otherwise queues the receiver. Returns whether to suspend.
+     *
+     * A waiting sender is dequeued only once its value has been taken, so that if taking it
+     * throws the sender stays queued; once dequeued, it is resumed even if the receive then throws.
+     */
+    template <typename Tp>
+    bool channel<Tp>::suspend_receiver(receive_awaiter &receiver, const std::coroutine_handle<> handle) {
+        auto resume = [this](send_awaiter *sender) {
+            sender->m_sent = true;
+            m_executor->post(sender->m_handle);
+        };
+
+        send_awaiter *sender = nullptr;
+        try {
+            std::lock_guard<details::spin_lock> lock(m_lock);
+            auto waiting = m_senders.front();
+
+            if (m_size) {
+                if (waiting) {
+                    push_value(std::move(waiting->m_value));
+                    sender = m_senders.pop();
+                }
+                receiver.m_result.emplace(pop_value());
+            } else if (waiting) {
+                receiver.m_result.emplace(std::move(waiting->m_value));
+                sender = m_senders.pop();
+            } else if (!m_closed) {
+                receiver.m_handle = handle;
+                m_receivers.push(&receiver);
+                return true;
+            }
+        } catch (...) {
+            if (sender)
+                resume(sender);
+            throw;
+        }
+
+        if (sender)
+            resume(sender);
+        return false;
+    }
+
+
+    //*** Public ***//
+
+    //* Destructor *//
+
+    template <typename Tp>
+    channel<Tp>::~channel() {
+        while (m_size)
+            pop_value();
+
+        while (m_free) {
+            auto node = static_cast<node_t*>(std::exchange(m_free, m_free->m_next));
+            m_allocator.deallocate_object(node);
+        }
+    }
+
+
+    //* Modifiers *//
+
+    /**
+     * @brief Closes the channel, resuming every suspended sender with false and every suspended
+     * receiver with an empty optional. Values already buffered can still be received.
+     */
+    template <typename Tp>
+    void channel<Tp>::close() {
+        send_awaiter *senders;
+        receive_awaiter *receivers;
+        {
+            std::lock_guard<details::spin_lock> lock(m_lock);
+            m_closed = true;
+            senders = m_senders.take();
+            receivers = m_receivers.take();
+        }
+
+        // Read the next link before posting, as a posted coroutine may resume and destroy its awaiter
+        while (senders)
+            m_executor->post(std::exchange(senders, senders->m_next)->m_handle);
+        while (receivers)
+            m_executor->post(std::exchange(receivers, receivers->m_next)->m_handle);
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_CHANNEL_H
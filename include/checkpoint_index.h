@@ -0,0 +1,293 @@
+#ifndef DSL_CHECKPOINT_INDEX_H
+#define DSL_CHECKPOINT_INDEX_H
+
+
+#include "list.h"
+#include "work_stealing_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+
+namespace dsl {
+
+    namespace details {
+
+        template <class List, typename = void>
+        inline constexpr bool has_size_v = false;
+
+        template <class List>
+        inline constexpr bool has_size_v<List, std::void_t<decltype(std::declval<const List&>().size())>> = true;
+
+        // The element count of list, walking it only if it does not keep one
+        template <class List>
+        std::size_t range_size(const List &list) {
+            if constexpr (has_size_v<List>)
+                return static_cast<std::size_t>(list.size());
+            else
+                return static_cast<std::size_t>(std::distance(list.begin(), list.end()));
+        }
+
+    }   // namespace details
+
+
+    /**
+     * @brief Records an iterator to every stride-th node of a linked list (or any forward range
+     * with stable iterators), which splits the list into chunks of about stride elements that
+     * can be traversed independently, e.g. by the parallel algorithms below.
+     *
+     * The first chunk starts at begin() and the last ends at end(), read from the list when the
+     * chunk is requested, so the index stays valid, though less balanced, across insertions
+     * anywhere in the list. Erasing a recorded node, or reordering the list (sort, splice,
+     * reverse, ...) invalidates it until rebuild() is called; debug builds assert, when a chunk
+     * is requested, that the list has not shrunk since, as erasing a recorded node implies.
+     * Building the index walks the list once; reusing it across scans is what makes them
+     * parallel end to end.
+     *
+     * @tparam List A container type, const-qualified for read-only traversal
+     */
+    template <class List>
+    class checkpoint_index {
+    public:
+
+        //*** Member Types ***//
+
+        using list_type = List;
+        using iterator = decltype(std::declval<List&>().begin());
+        using size_type = std::size_t;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit checkpoint_index(List &list, const size_type stride = 4096, allocator_type allocator = {})
+            : m_list(&list)
+            , m_stride(std::max<size_type>(stride, 1))
+            , m_boundaries(allocator)
+            , m_size(0)
+        { rebuild(); }
+
+
+        //* Access *//
+
+        [[nodiscard]] List& list() const noexcept {
+            return *m_list;
+        }
+
+        [[nodiscard]] size_type stride() const noexcept {
+            return m_stride;
+        }
+
+        [[nodiscard]] size_type chunk_count() const noexcept {
+            return m_boundaries.size() + 1;
+        }
+
+        [[nodiscard]] iterator chunk_begin(const size_type chunk) const {
+            assert_current();
+            return chunk == 0 ? m_list->begin() : m_boundaries[chunk - 1];
+        }
+
+        [[nodiscard]] iterator chunk_end(const size_type chunk) const {
+            assert_current();
+            return chunk == m_boundaries.size() ? m_list->end() : m_boundaries[chunk];
+        }
+
+
+        //* Modifiers *//
+
+        void rebuild();
+
+        void rebuild(const size_type stride) {
+            m_stride = std::max<size_type>(stride, 1);
+            rebuild();
+        }
+
+
+    private:
+
+        //*** Members ***//
+
+        List *m_list;
+        size_type m_stride;
+        dsl::list<iterator> m_boundaries;
+        size_type m_size;       // Of the list when the boundaries were recorded
+
+
+        //*** Functions ***//
+
+        void assert_current() const noexcept {
+            if constexpr (details::has_size_v<List>)
+                assert(static_cast<size_type>(m_list->size()) >= m_size && "checkpoint_index used after erasing from the list without rebuild()");
+        }
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Public ***//
+
+    //* Modifiers *//
+
+    /**
+     * @brief Records the boundaries afresh in a single walk of the list.
+     */
+    template <class List>
+    void checkpoint_index<List>::rebuild() {
+        m_boundaries.clear();
+        if constexpr (details::has_size_v<List>)
+            m_boundaries.reserve(static_cast<size_type>(m_list->size()) / m_stride);
+
+        size_type position = 0;
+        for (auto it = m_list->begin(), last = m_list->end(); it != last; ++it, ++position) {
+            if (position && position % m_stride == 0)
+                m_boundaries.push_back(it);
+        }
+        m_size = position;
+    }
+
+
+    namespace details {
+
+        template <class Tp>
+        struct is_checkpoint_index : std::false_type {};
+
+        template <class List>
+        struct is_checkpoint_index<checkpoint_index<List>> : std::true_type {};
+
+        template <class List>
+        using require_list = std::enable_if_t<!is_checkpoint_index<std::remove_const_t<List>>::value>;
+
+        struct identity {
+            template <typename Tp>
+            constexpr Tp&& operator()(Tp &&value) const noexcept {
+                return std::forward<Tp>(value);
+            }
+        };
+
+        /**
+         * @brief Chunk count per worker thread aimed for when an index is built on the fly,
+         * leaving idle workers something to steal when chunks take uneven time.
+         */
+        static constexpr std::size_t chunks_per_thread = 16;
+
+        template <class List>
+        std::size_t checkpoint_stride(const List &list, const work_stealing_pool &pool) {
+            auto size = range_size(list);
+            return std::max<std::size_t>(size / (pool.thread_count() * chunks_per_thread), 1);
+        }
+
+        /**
+         * @brief Applies f to every element of the chunks in [first, last), halving the range
+         * with a fork/join until single chunks are left.
+         */
+        template <class Index, class F>
+        void for_each_chunk(work_stealing_pool &pool, const Index &index, const std::size_t first, const std::size_t last, F &f) {
+            if (last - first == 1) {
+                for (auto it = index.chunk_begin(first), end = index.chunk_end(first); it != end; ++it)
+                    f(*it);
+                return;
+            }
+
+            auto middle = first + (last - first) / 2;
+            pool.join([&] { for_each_chunk(pool, index, first, middle, f); },
+                      [&] { for_each_chunk(pool, index, middle, last, f); });
+        }
+
+        /**
+         * @brief Reduces the transformed elements of the chunks in [first, last) in list order.
+         * Yields an empty optional for empty chunks, so that the caller applies init exactly once.
+         */
+        template <typename Tp, class Index, class Reduce, class Transform>
+        std::optional<Tp> reduce_chunks(work_stealing_pool &pool, const Index &index, const std::size_t first, const std::size_t last,
+                                        Reduce &reduce, Transform &transform) {
+            if (last - first == 1) {
+                std::optional<Tp> result;
+                for (auto it = index.chunk_begin(first), end = index.chunk_end(first); it != end; ++it) {
+                    if (result)
+                        *result = reduce(std::move(*result), transform(*it));
+                    else
+                        result.emplace(transform(*it));
+                }
+                return result;
+            }
+
+            auto middle = first + (last - first) / 2;
+            std::optional<Tp> lhs, rhs;
+            pool.join([&] { lhs = reduce_chunks<Tp>(pool, index, first, middle, reduce, transform); },
+                      [&] { rhs = reduce_chunks<Tp>(pool, index, middle, last, reduce, transform); });
+
+            if (!lhs)
+                return rhs;
+            if (rhs)
+                *lhs = reduce(std::move(*lhs), std::move(*rhs));
+            return lhs;
+        }
+
+    }   // namespace details
+
+
+    //*** Parallel Algorithms ***//
+
+    /**
+     * @brief Applies f to every element of the indexed list, one chunk per task on pool. f is
+     * called concurrently for different elements.
+     */
+    template <class List, class F>
+    void parallel_for_each(work_stealing_pool &pool, const checkpoint_index<List> &index, F f) {
+        details::for_each_chunk(pool, index, 0, index.chunk_count(), f);
+    }
+
+    /**
+     * @brief Reduces transform(element) over the indexed list with reduce, in list order but in an
+     * unspecified grouping, like std::transform_reduce: reduce must be associative, and init is
+     * applied exactly once.
+     */
+    template <class List, typename Tp, class Reduce = std::plus<>, class Transform = details::identity>
+    Tp parallel_reduce(work_stealing_pool &pool, const checkpoint_index<List> &index, Tp init,
+                       Reduce reduce = {}, Transform transform = {}) {
+        auto result = details::reduce_chunks<Tp>(pool, index, 0, index.chunk_count(), reduce, transform);
+        return result ? reduce(std::move(init), std::move(*result)) : init;
+    }
+
+    template <class List, class Predicate>
+    std::size_t parallel_count_if(work_stealing_pool &pool, const checkpoint_index<List> &index, Predicate pred) {
+        return parallel_reduce(pool, index, std::size_t(0), std::plus<>(),
+                               [&pred](const auto &value) -> std::size_t { return pred(value) ? 1 : 0; });
+    }
+
+
+    // Overloads building a temporary index sized for the pool
+
+    template <class List, class F, typename = details::require_list<List>>
+    void parallel_for_each(work_stealing_pool &pool, List &list, F f) {
+        checkpoint_index<List> index(list, details::checkpoint_stride(list, pool));
+        parallel_for_each(pool, index, std::move(f));
+    }
+
+    template <class List, typename Tp, class Reduce = std::plus<>, class Transform = details::identity,
+              typename = details::require_list<List>>
+    Tp parallel_reduce(work_stealing_pool &pool, List &list, Tp init, Reduce reduce = {}, Transform transform = {}) {
+        checkpoint_index<List> index(list, details::checkpoint_stride(list, pool));
+        return parallel_reduce(pool, index, std::move(init), std::move(reduce), std::move(transform));
+    }
+
+    template <class List, class Predicate, typename = details::require_list<List>>
+    std::size_t parallel_count_if(work_stealing_pool &pool, List &list, Predicate pred) {
+        checkpoint_index<List> index(list, details::checkpoint_stride(list, pool));
+        return parallel_count_if(pool, index, std::move(pred));
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_CHECKPOINT_INDEX_H
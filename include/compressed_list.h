@@ -0,0 +1,427 @@
+#ifndef DSL_COMPRESSED_LIST_H
+#define DSL_COMPRESSED_LIST_H
+
+
+#include "list.h"
+#include "packed_list.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace dsl {
+
+    namespace details {
+
+        inline unsigned bit_width(std::uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return value ? static_cast<unsigned>(word_bits - __builtin_clzll(value)) : 0;
+#else
+            unsigned width = 0;
+            for (; value; value >>= 1)
+                ++width;
+            return width;
+#endif
+        }
+
+        // Reads the width-bit field starting at bit position of a packed word array
+        inline std::uint64_t read_bits(const std::uint64_t *words, const std::size_t position, const unsigned width) noexcept {
+            if (width == 0)
+                return 0;
+
+            auto word = position / word_bits;
+            auto offset = position % word_bits;
+            auto value = words[word] >> offset;
+            if (offset + width > word_bits)
+                value |= words[word + 1] << (word_bits - offset);
+            return width == word_bits ? value : value & ((std::uint64_t(1) << width) - 1);
+        }
+
+        // Makes room for extra more elements, growing geometrically as list::reserve is exact
+        template <class List>
+        void reserve_extra(List &list, const std::size_t extra) {
+            auto needed = list.size() + extra;
+            if (needed > list.capacity())
+                list.reserve(std::max(needed, list.capacity() + list.capacity() / 2));
+        }
+
+    }   // namespace details
+
+
+    /**
+     * @brief Append-only sequence of non-decreasing unsigned integers (posting lists, timestamps,
+     * sorted IDs) compressed in blocks of block_size values. A full block is sealed into a header
+     * holding its first and last value, followed by the differences between consecutive values
+     * bit-packed at the width of the largest one (frame-of-reference); the values appended since
+     * the last full block stay uncompressed in an open tail block.
+     *
+     * Iteration decodes one delta per step, and skip_to() binary searches the block headers so
+     * that only the block containing the target is decoded.
+     *
+     * @tparam Int An unsigned integer type
+     */
+    template <typename Int>
+    class compressed_list {
+        static_assert(std::is_unsigned_v<Int> && sizeof(Int) <= sizeof(std::uint64_t),
+                      "compressed_list requires an unsigned integer type of at most 64 bits.");
+
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = Int;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using const_reference = Int;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        class const_iterator;
+        using iterator = const_iterator;
+
+        static constexpr size_type block_size = 128;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit compressed_list(allocator_type allocator = {})
+            : m_blocks(allocator)
+            , m_words(allocator)
+            , m_tail(allocator)
+        { m_tail.reserve(block_size); }
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        compressed_list(InputIt first, InputIt last, allocator_type allocator = {})
+            : compressed_list(allocator)
+        { append(first, last); }
+
+        compressed_list(std::initializer_list<Int> init, allocator_type allocator = {})
+            : compressed_list(init.begin(), init.end(), allocator)
+        {}
+
+
+        //* Element Access *//
+
+        [[nodiscard]] Int front() const noexcept {
+            return m_blocks.empty() ? m_tail.front() : m_blocks.front().m_first;
+        }
+
+        [[nodiscard]] Int back() const noexcept {
+            return m_tail.empty() ? m_blocks.back().m_last : m_tail.back();
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return m_words.get_allocator();
+        }
+
+
+        //* Iterators *//
+
+        const_iterator begin() const noexcept {
+            if (!m_blocks.empty())
+                return const_iterator(this, 0, 0, m_blocks.front().m_first);
+            return const_iterator(this, 0, 0, m_tail.empty() ? Int() : m_tail.front());
+        }
+
+        const_iterator cbegin() const noexcept {
+            return begin();
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(this, m_blocks.size(), m_tail.size(), Int());
+        }
+
+        const_iterator cend() const noexcept {
+            return end();
+        }
+
+
+        //* Capacity *//
+
+        [[nodiscard]] bool empty() const noexcept {
+            return m_tail.empty() && m_blocks.empty();
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return m_blocks.size() * block_size + m_tail.size();
+        }
+
+        [[nodiscard]] size_type block_count() const noexcept {
+            return m_blocks.size();
+        }
+
+        // Bytes of storage held, including unused capacity
+        [[nodiscard]] size_type memory_usage() const noexcept {
+            return m_blocks.capacity() * sizeof(block) + m_words.capacity() * sizeof(std::uint64_t)
+                 + m_tail.capacity() * sizeof(Int);
+        }
+
+        void shrink_to_fit() {
+            m_blocks.shrink_to_fit();
+            m_words.shrink_to_fit();
+        }
+
+
+        //* Modifiers *//
+
+        void clear() noexcept {
+            m_blocks.clear();
+            m_words.clear();
+            m_tail.clear();
+        }
+
+        void push_back(const Int);
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        void append(InputIt first, InputIt last) {
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+
+        void swap(compressed_list &other) {
+            m_blocks.swap(other.m_blocks);
+            m_words.swap(other.m_words);
+            m_tail.swap(other.m_tail);
+        }
+
+
+        //* Operations *//
+
+        const_iterator skip_to(const Int value) const {
+            return skip_to(begin(), value);
+        }
+
+        const_iterator skip_to(const_iterator, const Int) const;
+
+        void decode(Int*) const;
+
+
+    private:
+
+        //*** Members ***//
+
+        struct block {
+            Int m_first;
+            Int m_last;
+            size_type m_offset;     // Index of the block's first payload word
+            unsigned m_width;       // Bits per delta, 0 if all values are equal
+        };
+
+        list<block> m_blocks;
+        list<std::uint64_t> m_words;
+        list<Int> m_tail;
+
+
+        //*** Functions ***//
+
+        Int delta(const block &header, const size_type index) const noexcept {
+            auto position = header.m_offset * details::word_bits + (index - 1) * header.m_width;
+            return static_cast<Int>(details::read_bits(m_words.data(), position, header.m_width));
+        }
+
+        void seal();
+        void decode_block(const block&, Int*) const noexcept;
+    };
+
+
+    /**
+     * @brief Forward iterator holding the current value, so that each increment decodes only the
+     * next delta of the block.
+     */
+    template <typename Int>
+    class compressed_list<Int>::const_iterator {
+    public:
+        using value_type = Int;
+        using difference_type = std::ptrdiff_t;
+        using reference = Int;
+        using pointer = const Int*;
+        using iterator_category = std::forward_iterator_tag;
+
+        const_iterator() noexcept
+            : m_list(nullptr)
+            , m_block(0)
+            , m_index(0)
+            , m_value() {}
+
+        [[nodiscard]] Int operator*() const noexcept {
+            return m_value;
+        }
+
+        const_iterator& operator++() noexcept {
+            ++m_index;
+            if (m_block < m_list->m_blocks.size()) {
+                if (m_index < block_size) {
+                    m_value += m_list->delta(m_list->m_blocks[m_block], m_index);
+                    return *this;
+                }
+                ++m_block;
+                m_index = 0;
+                if (m_block < m_list->m_blocks.size()) {
+                    m_value = m_list->m_blocks[m_block].m_first;
+                    return *this;
+                }
+            }
+            if (m_index < m_list->m_tail.size())
+                m_value = m_list->m_tail[m_index];
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        [[nodiscard]] bool operator==(const const_iterator &other) const noexcept {
+            return m_block == other.m_block && m_index == other.m_index;
+        }
+
+        [[nodiscard]] bool operator!=(const const_iterator &other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        friend class compressed_list;
+
+        const_iterator(const compressed_list *list, const size_type block, const size_type index, const Int value) noexcept
+            : m_list(list)
+            , m_block(block)
+            , m_index(index)
+            , m_value(value) {}
+
+        const compressed_list *m_list;
+        size_type m_block;      // Sealed block, or the tail when equal to the block count
+        size_type m_index;
+        Int m_value;
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    /**
+     * @brief Compresses the first block_size values of the tail, packing their deltas into the
+     * payload a word at a time. Storage for the header and the payload is reserved before anything
+     * changes, so that a failed allocation leaves the tail whole to be sealed by the next push_back.
+     */
+    template <typename Int>
+    void compressed_list<Int>::seal() {
+        std::uint64_t widest = 0;
+        for (size_type i = 1; i < block_size; ++i)
+            widest |= static_cast<std::uint64_t>(m_tail[i] - m_tail[i - 1]);
+        auto width = details::bit_width(widest);
+
+        details::reserve_extra(m_blocks, 1);
+        details::reserve_extra(m_words, ((block_size - 1) * width + details::word_bits - 1) / details::word_bits);
+        m_blocks.push_back(block{ m_tail.front(), m_tail[block_size - 1], m_words.size(), width });
+
+        if (width) {
+            std::uint64_t accumulator = 0;
+            unsigned offset = 0;
+            for (size_type i = 1; i < block_size; ++i) {
+                auto value = static_cast<std::uint64_t>(m_tail[i] - m_tail[i - 1]);
+                accumulator |= value << offset;
+                offset += width;
+
+                if (offset >= details::word_bits) {
+                    m_words.push_back(accumulator);
+                    offset -= details::word_bits;
+                    accumulator = offset ? value >> (width - offset) : 0;
+                }
+            }
+
+            if (offset)
+                m_words.push_back(accumulator);
+        }
+        m_tail.erase(m_tail.begin(), m_tail.begin() + block_size);
+    }
+
+    /**
+     * @brief Unpacks the deltas of a sealed block into out and prefix sums them in place.
+     */
+    template <typename Int>
+    void compressed_list<Int>::decode_block(const block &header, Int *out) const noexcept {
+        out[0] = header.m_first;
+        if (header.m_width == 0) {
+            std::fill(out + 1, out + block_size, header.m_first);
+            return;
+        }
+
+        auto position = header.m_offset * details::word_bits;
+        for (size_type i = 1; i < block_size; ++i, position += header.m_width)
+            out[i] = static_cast<Int>(details::read_bits(m_words.data(), position, header.m_width));
+        for (size_type i = 1; i < block_size; ++i)
+            out[i] += out[i - 1];
+    }
+
+
+    //*** Public ***//
+
+    //* Modifiers *//
+
+    template <typename Int>
+    void compressed_list<Int>::push_back(const Int value) {
+        if (!empty() && value < back())
+            throw std::invalid_argument("Values must be appended in non-decreasing order.");
+
+        // A tail left full by a failed seal is sealed again here
+        m_tail.push_back(value);
+        if (m_tail.size() >= block_size)
+            seal();
+    }
+
+
+    //* Operations *//
+
+    /**
+     * @brief Returns an iterator to the first value not less than value, at or after from. The
+     * blocks are binary searched by their last value, then the one block found is decoded.
+     */
+    template <typename Int>
+    typename compressed_list<Int>::const_iterator compressed_list<Int>::skip_to(const_iterator from, const Int value) const {
+        if (from == end() || *from >= value)
+            return from;
+
+        auto first = m_blocks.begin() + from.m_block;
+        auto found = std::lower_bound(first, m_blocks.end(), value,
+                                      [](const block &header, const Int target) { return header.m_last < target; });
+
+        if (found == m_blocks.end()) {
+            auto start = m_tail.begin() + (from.m_block == m_blocks.size() ? from.m_index : 0);
+            auto it = std::lower_bound(start, m_tail.end(), value);
+            auto index = static_cast<size_type>(it - m_tail.begin());
+            return const_iterator(this, m_blocks.size(), index, it == m_tail.end() ? Int() : *it);
+        }
+
+        auto block_index = static_cast<size_type>(found - m_blocks.begin());
+        auto it = block_index == from.m_block ? from : const_iterator(this, block_index, 0, found->m_first);
+        while (*it < value)
+            ++it;
+        return it;
+    }
+
+    /**
+     * @brief Writes all size() values to out in order, a block at a time.
+     */
+    template <typename Int>
+    void compressed_list<Int>::decode(Int *out) const {
+        for (const auto &header : m_blocks) {
+            decode_block(header, out);
+            out += block_size;
+        }
+        std::copy(m_tail.begin(), m_tail.end(), out);
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_COMPRESSED_LIST_H
@@ -0,0 +1,19 @@
+#ifndef DSL_CONCURRENCY_BASE_H
+#define DSL_CONCURRENCY_BASE_H
+
+
+#include <cstddef>
+
+
+namespace dsl::details {
+
+    /**
+     * @brief Alignment that keeps atomics written by different threads on separate cache lines,
+     * so that they do not invalidate each other (false sharing).
+     */
+    inline constexpr std::size_t cache_line_size = 64;
+
+}   // namespace dsl::details
+
+
+#endif // DSL_CONCURRENCY_BASE_H
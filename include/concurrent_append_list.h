@@ -0,0 +1,414 @@
+#ifndef DSL_CONCURRENT_APPEND_LIST_H
+#define DSL_CONCURRENT_APPEND_LIST_H
+
+
+#include "concurrency_base.h"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+namespace dsl {
+
+    namespace details {
+
+        inline unsigned floor_log2(std::size_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(std::numeric_limits<unsigned long long>::digits - 1 - __builtin_clzll(value));
+#else
+            unsigned log = 0;
+            while (value >>= 1)
+                ++log;
+            return log;
+#endif
+        }
+
+    }   // namespace details
+
+
+    /**
+     * @brief Append-only sequence that any number of threads may push_back to concurrently, while
+     * others read it without locks. Elements live in segments of doubling capacity that are never
+     * moved or freed before the list, so references and iterators stay valid for its lifetime.
+     *
+     * A push reserves an index with a fetch-add, constructs the element in place, and marks its
+     * slot ready. The size seen by readers is the length of the ready prefix, which the writers
+     * advance together, so readers see elements in index order and never one under construction.
+     * Readers only load the size and the segment pointers: they are wait-free. Writers are not
+     * lock-free: a writer needing a segment that another writer is still installing spins (and
+     * then yields) until it is published, and a writer preempted mid-push delays publication of
+     * the elements reserved after it.
+     *
+     * Segments are allocated from the allocator's resource on demand by the first writer to need
+     * each one, so that resource must be thread-safe (new_delete_resource, the default, or a
+     * synchronized_pool_resource). Running out of memory while allocating a segment terminates,
+     * as the index already reserved could otherwise never be published.
+     *
+     * @tparam Tp
+     */
+    template <typename Tp>
+    class concurrent_append_list {
+        static_assert(std::is_nothrow_move_constructible_v<Tp>,
+                      "concurrent_append_list requires a nothrow move-constructible element type.");
+
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = Tp;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = Tp&;
+        using const_reference = const Tp&;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        template <bool Const> class basic_iterator;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit concurrent_append_list(const size_type first_segment_size = 64, allocator_type allocator = {})
+            : m_reserved(0)
+            , m_published(0)
+            , m_segments()
+            , m_allocating()
+            , m_allocator(allocator)
+            , m_first_shift(details::floor_log2(first_segment_size > 1 ? (first_segment_size - 1) * 2 : 1))
+        {}
+
+        concurrent_append_list(const concurrent_append_list&) = delete;
+        concurrent_append_list& operator=(const concurrent_append_list&) = delete;
+
+        ~concurrent_append_list();
+
+
+        //* Element Access *//
+
+        // pos must be less than a size() observed by the calling thread
+        reference operator[](const size_type pos) noexcept {
+            auto [segment, offset] = locate(pos);
+            return m_segments[segment].load(std::memory_order_acquire)[offset];
+        }
+
+        const_reference operator[](const size_type pos) const noexcept {
+            auto [segment, offset] = locate(pos);
+            return m_segments[segment].load(std::memory_order_acquire)[offset];
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return m_allocator;
+        }
+
+
+        //* Iterators *//
+
+        // end() is taken at the size published when it is called
+        iterator begin() noexcept { return iterator(this, 0); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        iterator end() noexcept { return iterator(this, size()); }
+        const_iterator end() const noexcept { return const_iterator(this, size()); }
+        const_iterator cend() const noexcept { return end(); }
+
+
+        //* Capacity *//
+
+        [[nodiscard]] bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        // The number of elements published, all of which are fully constructed and visible
+        [[nodiscard]] size_type size() const noexcept {
+            return m_published.load(std::memory_order_acquire);
+        }
+
+
+        //* Modifiers *//
+
+        size_type push_back(const Tp &value) {
+            return emplace_back(value);
+        }
+
+        size_type push_back(Tp &&value) {
+            return emplace_back(std::move(value));
+        }
+
+        template <class... Args>
+        size_type emplace_back(Args&&...);
+
+
+    private:
+
+        //*** Members ***//
+
+        static constexpr size_type max_segments = std::numeric_limits<size_type>::digits;
+        static constexpr unsigned spin_limit = 64;
+
+        alignas(details::cache_line_size) std::atomic<size_type> m_reserved;
+        alignas(details::cache_line_size) std::atomic<size_type> m_published;
+        alignas(details::cache_line_size) std::atomic<Tp*> m_segments[max_segments];
+        std::atomic<bool> m_allocating[max_segments];     // Claimed by the one writer allocating each segment
+        allocator_type m_allocator;
+        unsigned m_first_shift;
+
+
+        //*** Functions ***//
+
+        size_type segment_capacity(const size_type segment) const noexcept {
+            return size_type(1) << (m_first_shift + segment);
+        }
+
+        // Segment k holds the indices [2^(s + k) - 2^s, 2^(s + k + 1) - 2^s), for a first segment of 2^s
+        std::pair<size_type, size_type> locate(const size_type pos) const noexcept {
+            auto biased = pos + (size_type(1) << m_first_shift);
+            auto segment = details::floor_log2(biased) - m_first_shift;
+            return { segment, biased - segment_capacity(segment) };
+        }
+
+        static constexpr size_type flags_offset(const size_type capacity) noexcept {
+            return (capacity * sizeof(Tp) + alignof(std::atomic<bool>) - 1) / alignof(std::atomic<bool>) * alignof(std::atomic<bool>);
+        }
+
+        static constexpr size_type segment_alignment() noexcept {
+            return alignof(Tp) > alignof(std::atomic<bool>) ? alignof(Tp) : alignof(std::atomic<bool>);
+        }
+
+        std::atomic<bool>* ready_flags(Tp *segment, const size_type index) const noexcept {
+            return std::launder(reinterpret_cast<std::atomic<bool>*>(
+                reinterpret_cast<std::byte*>(segment) + flags_offset(segment_capacity(index))));
+        }
+
+        Tp* acquire_segment(const size_type) noexcept;
+        void publish() noexcept;
+    };
+
+
+    /**
+     * @brief Forward iterator caching the current segment, so that stepping within a segment is a
+     * pointer increment.
+     */
+    template <typename Tp>
+    template <bool Const>
+    class concurrent_append_list<Tp>::basic_iterator {
+    public:
+        using list_type = std::conditional_t<Const, const concurrent_append_list, concurrent_append_list>;
+        using value_type = Tp;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const Tp&, Tp&>;
+        using pointer = std::conditional_t<Const, const Tp*, Tp*>;
+        using iterator_category = std::forward_iterator_tag;
+
+        basic_iterator() noexcept
+            : m_list(nullptr)
+            , m_index(0)
+            , m_slot(nullptr)
+            , m_segment_end(nullptr) {}
+
+        template <bool WasConst, typename = std::enable_if_t<Const && !WasConst>>
+        basic_iterator(const basic_iterator<WasConst> &other) noexcept
+            : m_list(other.m_list)
+            , m_index(other.m_index)
+            , m_slot(other.m_slot)
+            , m_segment_end(other.m_segment_end) {}
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return *slot();
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            return slot();
+        }
+
+        basic_iterator& operator++() noexcept {
+            ++m_index;
+            if (!m_slot || ++m_slot == m_segment_end)
+                seek();
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        [[nodiscard]] bool operator==(const basic_iterator &other) const noexcept {
+            return m_index == other.m_index;
+        }
+
+        [[nodiscard]] bool operator!=(const basic_iterator &other) const noexcept {
+            return m_index != other.m_index;
+        }
+
+    private:
+        friend class concurrent_append_list;
+        template <bool> friend class basic_iterator;
+
+        basic_iterator(list_type *list, const size_type index) noexcept
+            : m_list(list)
+            , m_index(index)
+        { seek(); }
+
+        // The slot is null while the iterator is past the segments allocated when it last sought
+        pointer slot() const noexcept {
+            if (!m_slot)
+                seek();
+            return m_slot;
+        }
+
+        void seek() const noexcept {
+            auto [segment, offset] = m_list->locate(m_index);
+            auto slots = m_list->m_segments[segment].load(std::memory_order_acquire);
+            m_slot = slots ? slots + offset : nullptr;
+            m_segment_end = slots ? slots + m_list->segment_capacity(segment) : nullptr;
+        }
+
+        list_type *m_list;
+        size_type m_index;
+        mutable pointer m_slot;
+        mutable pointer m_segment_end;
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    /**
+     * @brief Returns segment index, allocating it if no writer has yet. Of the writers reaching a
+     * missing segment, the one that claims it allocates it, and the others wait for it to appear
+     * rather than allocating copies that would be discarded.
+     */
+    template <typename Tp>
+    Tp* concurrent_append_list<Tp>::acquire_segment(const size_type index) noexcept {
+        auto segment = m_segments[index].load(std::memory_order_acquire);
+        if (segment)
+            return segment;
+
+        if (m_allocating[index].exchange(true, std::memory_order_acquire)) {
+            for (unsigned spins = 0; !(segment = m_segments[index].load(std::memory_order_acquire)); ) {
+                if (++spins > spin_limit)
+                    std::this_thread::yield();
+            }
+            return segment;
+        }
+
+        auto capacity = segment_capacity(index);
+        auto bytes = flags_offset(capacity) + capacity * sizeof(std::atomic<bool>);
+
+        void *storage = nullptr;
+        try {
+            storage = m_allocator.resource()->allocate(bytes, segment_alignment());
+        } catch (...) {
+            std::terminate();
+        }
+
+        auto created = static_cast<Tp*>(storage);
+        auto flags = ready_flags(created, index);
+        for (size_type i = 0; i < capacity; ++i)
+            ::new (static_cast<void*>(flags + i)) std::atomic<bool>(false);
+
+        m_segments[index].store(created, std::memory_order_release);
+        return created;
+    }
+
+    /**
+     * @brief Advances the published size over every ready slot following it, in one CAS per run of
+     * ready slots. The ready flags and the size are accessed sequentially consistently, so that of
+     * a writer marking slot i ready and a writer that has just advanced the size to i, at least one
+     * sees the other's store.
+     */
+    template <typename Tp>
+    void concurrent_append_list<Tp>::publish() noexcept {
+        auto published = m_published.load(std::memory_order_seq_cst);
+        for (;;) {
+            auto ready = published;
+            for (;; ++ready) {
+                auto [index, offset] = locate(ready);
+                auto segment = m_segments[index].load(std::memory_order_acquire);
+                if (!segment || !ready_flags(segment, index)[offset].load(std::memory_order_seq_cst))
+                    break;
+            }
+
+            if (ready == published)
+                return;
+            if (m_published.compare_exchange_strong(published, ready, std::memory_order_seq_cst))
+                published = ready;
+        }
+    }
+
+
+    //*** Public ***//
+
+    //* Constructors *//
+
+    /**
+     * @brief Destroys every element. No other thread may be accessing the list.
+     */
+    template <typename Tp>
+    concurrent_append_list<Tp>::~concurrent_append_list() {
+        auto count = m_reserved.load(std::memory_order_acquire);
+
+        for (size_type index = 0, first = 0; index < max_segments; ++index) {
+            auto segment = m_segments[index].load(std::memory_order_acquire);
+            if (!segment)
+                break;
+
+            auto capacity = segment_capacity(index);
+            if constexpr (!std::is_trivially_destructible_v<Tp>) {
+                for (size_type i = 0; i < capacity && first + i < count; ++i)
+                    segment[i].~Tp();
+            }
+            m_allocator.resource()->deallocate(segment, flags_offset(capacity) + capacity * sizeof(std::atomic<bool>), segment_alignment());
+            first += capacity;
+        }
+    }
+
+
+    //* Modifiers *//
+
+    /**
+     * @brief Appends an element constructed from args and returns its index. If constructing it
+     * may throw, it is constructed before an index is reserved and then moved into place, so that
+     * an exception leaves no hole in the sequence.
+     */
+    template <typename Tp>
+    template <class... Args>
+    typename concurrent_append_list<Tp>::size_type concurrent_append_list<Tp>::emplace_back(Args&&... args) {
+        auto store = [this](auto &&... values) {
+            auto pos = m_reserved.fetch_add(1, std::memory_order_relaxed);
+            auto [index, offset] = locate(pos);
+            auto segment = acquire_segment(index);
+
+            ::new (static_cast<void*>(segment + offset)) Tp(std::forward<decltype(values)>(values)...);
+            ready_flags(segment, index)[offset].store(true, std::memory_order_seq_cst);
+            publish();
+            return pos;
+        };
+
+        if constexpr (std::is_nothrow_constructible_v<Tp, Args&&...>) {
+            return store(std::forward<Args>(args)...);
+        } else {
+            Tp value(std::forward<Args>(args)...);
+            return store(std::move(value));
+        }
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_CONCURRENT_APPEND_LIST_H
@@ -2,8 +2,11 @@
 #define DSL_DOUBLY_LINKED_LIST_H
 
 
+#include "instrumentation.h"
 #include "list_base.h"
 
+#include <algorithm>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
@@ -12,30 +15,33 @@
 
 namespace dsl {
 
-    template <typename Tp> class doubly_linked_list;
+    template <typename Tp, class Allocator = std::pmr::polymorphic_allocator<std::byte>> class doubly_linked_list;
 
     namespace details {
 
+        struct snapshot_access;
+
         template <typename Tp> struct doubly_node;
 
         /**
          * @brief Base representation for a node in a doubly linked list.
-         * Contains a non-owning raw pointer to the next node in the list
+         * Contains non-owning raw pointers to the previous and next nodes in the list.
+         * The list itself owns a base node that acts as the sentinel of a circular chain.
          * 
          * @tparam Tp 
          */
         template <typename Tp>
         struct doubly_node_base {
             doubly_node_base()
-                : m_prev(nullptr)
-                , m_next(nullptr) {}
+                : m_prev(this)
+                , m_next(this) {}
 
             // Explicitly disallow copy behaviour
             doubly_node_base(const doubly_node_base&) = delete;
             doubly_node_base& operator=(const doubly_node_base&) = delete;
 
-            doubly_node<Tp> *m_prev;
-            doubly_node<Tp> *m_next;
+            doubly_node_base *m_prev;
+            doubly_node_base *m_next;
         };   
 
         /**
@@ -69,38 +75,41 @@ namespace dsl {
 
             using iterator_category = std::bidirectional_iterator_tag;
             using pointer = const value_type*;
-            using reference = const value_type*&;
+            using reference = const value_type&;
 
 
             //*** Member Functions ***//
 
+            doubly_const_iterator() noexcept 
+                : m_curr(nullptr) {}
+
             [[nodiscard]] pointer operator->() const noexcept {
-                return std::addressof(m_curr->m_value);
+                return std::addressof(static_cast<doubly_node<Tp>*>(m_curr)->m_value);
             }
 
             [[nodiscard]] reference operator*() const noexcept {
-                return m_curr->m_value;
+                return static_cast<doubly_node<Tp>*>(m_curr)->m_value;
             }
 
-             doubly_const_iterator<Tp>& operator++() noexcept {
+            doubly_const_iterator& operator++() noexcept {
                 m_curr = m_curr->m_next;
                 return *this;
             }
 
-             doubly_const_iterator<Tp> operator++(int) noexcept {
+            doubly_const_iterator operator++(int) noexcept {
                 doubly_const_iterator it(*this);
                 ++(*this);
                 return it;
             }
 
-             doubly_const_iterator& operator--() noexcept {
+            doubly_const_iterator& operator--() noexcept {
                 m_curr = m_curr->m_prev;
                 return *this;
             }
 
-             doubly_const_iterator operator--(int) noexcept {
+            doubly_const_iterator operator--(int) noexcept {
                 doubly_const_iterator it(*this);
-                ++(*this);
+                --(*this);
                 return it;
             }
 
@@ -114,16 +123,22 @@ namespace dsl {
 
 
         protected:
-            friend class doubly_linked_list<Tp>;
+            template <typename, class> friend class dsl::doubly_linked_list;
 
             doubly_node_base<Tp> *m_curr;
 
             // Non-public explicit constructor to enable iterator construction for derived classes and friend classes
-             explicit doubly_const_iterator(const doubly_node_base<Tp> *curr) 
+            explicit doubly_const_iterator(const doubly_node_base<Tp> *curr) noexcept
                 : m_curr(const_cast<doubly_node_base<Tp>*>(curr)) {}
         };
 
 
+        /**
+         * @brief Iterator with non-const pointer and reference member types.
+         * Adheres to the named requirements of LegacyBidirectionalIterator.
+         * 
+         * @tparam Tp 
+         */
         template <typename Tp>
         class doubly_iterator : public doubly_const_iterator<Tp> {
         public:
@@ -139,63 +154,72 @@ namespace dsl {
 
             //*** Member Functions ***//
 
+            doubly_iterator() noexcept 
+                : doubly_const_iterator<Tp>() {}
+
             [[nodiscard]] pointer operator->() const noexcept {
-                return std::addressof(this->m_curr->m_value);
+                return std::addressof(static_cast<doubly_node<Tp>*>(this->m_curr)->m_value);
             }
 
             [[nodiscard]] reference operator*() const noexcept {
-                return this->m_curr->m_value;
+                return static_cast<doubly_node<Tp>*>(this->m_curr)->m_value;
             }
 
-             doubly_iterator& operator++() noexcept {
+            doubly_iterator& operator++() noexcept {
                 base_t::operator++();
                 return *this;
             }
 
-             doubly_iterator operator++(int) noexcept {
+            doubly_iterator operator++(int) noexcept {
                 doubly_iterator it(*this);
                 ++(*this);
                 return it;
             }
 
-             doubly_iterator& operator--() noexcept {
-                this->m_curr = this->m_curr->m_prev;
+            doubly_iterator& operator--() noexcept {
+                base_t::operator--();
                 return *this;
             }
 
-             doubly_iterator operator--(int) noexcept {
+            doubly_iterator operator--(int) noexcept {
                 doubly_iterator it(*this);
-                ++(*this);
+                --(*this);
                 return it;
             }
 
 
-            private:
-                friend class doubly_linked_list<Tp>;
+        private:
+            template <typename, class> friend class dsl::doubly_linked_list;
 
-                explicit doubly_iterator(const doubly_node_base<Tp> *curr) 
-                    : doubly_const_iterator<Tp>(curr) {}
+            explicit doubly_iterator(const doubly_node_base<Tp> *curr) noexcept
+                : doubly_const_iterator<Tp>(curr) {}
         };
 
     }   // namespace details
 
 
-    template <typename Tp>
-    class doubly_linked_list : public details::list_base<Tp> {
+    /**
+     * @brief Doubly-linked list container. The nodes form a circular chain through a sentinel
+     * owned by the list, so end() is always reachable from the last node and vice versa.
+     * 
+     * @tparam Tp 
+     */
+    template <typename Tp, class Allocator>
+    class doubly_linked_list : public details::list_base<doubly_linked_list<Tp, Allocator>, Tp, Allocator> {
     public:
 
         //*** Member Types ***//
 
-        using value_type = typename details::list_base<Tp>::value_type;
-        using size_type = typename details::list_base<Tp>::size_type;
-        using difference_type = typename details::list_base<Tp>::difference_type;
+        using value_type = typename details::list_base<doubly_linked_list<Tp, Allocator>, Tp, Allocator>::value_type;
+        using size_type = typename details::list_base<doubly_linked_list<Tp, Allocator>, Tp, Allocator>::size_type;
+        using difference_type = typename details::list_base<doubly_linked_list<Tp, Allocator>, Tp, Allocator>::difference_type;
 
-        using reference = typename details::list_base<Tp>::reference;
-        using const_reference = typename details::list_base<Tp>::const_reference;
+        using reference = typename details::list_base<doubly_linked_list<Tp, Allocator>, Tp, Allocator>::reference;
+        using const_reference = typename details::list_base<doubly_linked_list<Tp, Allocator>, Tp, Allocator>::const_reference;
 
-        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
-        using pointer = std::allocator_traits<allocator_type>::pointer;
-        using const_pointer = std::allocator_traits<allocator_type>::const_pointer;
+        using allocator_type = Allocator;
+        using pointer = typename std::allocator_traits<allocator_type>::pointer;
+        using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
 
         using iterator = typename details::doubly_iterator<Tp>;
         using const_iterator = typename details::doubly_const_iterator<Tp>;
@@ -208,28 +232,26 @@ namespace dsl {
         //* Constructors *//
 
         explicit doubly_linked_list(allocator_type allocator = {})
-            : details::list_base<Tp>()
-            , m_allocator(allocator)
-            , m_head(nullptr)
-            , m_tail(nullptr)
+            : details::list_base<doubly_linked_list<Tp, Allocator>, Tp, Allocator>(allocator)
+            , m_sentinel()
         {}
 
         doubly_linked_list(const size_type count, 
                            const Tp &value, 
                            allocator_type allocator = {})
             : doubly_linked_list(allocator)
-        { assign(count, value); }
+        { insert(end(), count, value); }
 
         explicit doubly_linked_list(const size_type count, 
                                     allocator_type allocator = {})
-            : doubly_linked_list(count, Tp(), allocator) 
-        {}
+            : doubly_linked_list(allocator) 
+        { resize(count); }
 
-        template <class InputIt>
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
         doubly_linked_list(InputIt first, InputIt last,
                            allocator_type allocator = {})
             : doubly_linked_list(allocator)
-        { insert(begin(), first, last); }
+        { insert(end(), first, last); }
 
         doubly_linked_list(std::initializer_list<Tp> init, 
                            allocator_type allocator = {})
@@ -240,9 +262,9 @@ namespace dsl {
         //* Copy Constructors *//
 
         doubly_linked_list(const doubly_linked_list &other, 
-                           allocator_type allocator = {})
-            : doubly_linked_list(other.size(), allocator)
-        { operator=(other); } 
+                           allocator_type allocator)
+            : doubly_linked_list(allocator)
+        { try_copy(other); } 
 
         doubly_linked_list(const doubly_linked_list &other)
             : doubly_linked_list(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())) 
@@ -252,13 +274,13 @@ namespace dsl {
         //* Move Constructors *//
         
         doubly_linked_list(doubly_linked_list &&other, 
-                           allocator_type allocator = {})
-            : doubly_linked_list(other.size(), allocator) 
+                           allocator_type allocator)
+            : doubly_linked_list(allocator) 
         { operator=(std::move(other)); }
 
-        doubly_linked_list(doubly_linked_list &&other)
-            : doubly_linked_list(other, other.get_allocator())
-        {}
+        doubly_linked_list(doubly_linked_list &&other) noexcept
+            : doubly_linked_list(other.get_allocator())
+        { swap(other); }
 
 
         //* Destructor *//
@@ -275,148 +297,212 @@ namespace dsl {
 
         //* Assign and allocator access *//
         
-         void assign(const size_type, const Tp&);
+        void assign(const size_type, const Tp&);
 
-        template <class InputIt>
-         void assign(InputIt, InputIt);
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        void assign(InputIt, InputIt);
 
-         void assign(std::initializer_list<Tp>);
+        void assign(std::initializer_list<Tp>);
 
-         allocator_type get_allocator() const noexcept;
+        allocator_type get_allocator() const noexcept;
 
 
         //* Element Access *//
 
-         reference front() {
-            return m_head->m_value;
+        reference front() {
+            return static_cast<node_t*>(m_sentinel.m_next)->m_value;
         }
 
-         const_reference front() const {
-            return m_head->m_value;
+        const_reference front() const {
+            return static_cast<node_t*>(m_sentinel.m_next)->m_value;
         }
 
-         reference back() {
-            return m_tail->m_value;
+        reference back() {
+            return static_cast<node_t*>(m_sentinel.m_prev)->m_value;
         }
 
-         const_reference back() const {
-            return m_tail->m_value;
+        const_reference back() const {
+            return static_cast<node_t*>(m_sentinel.m_prev)->m_value;
         }
 
 
         //* Iterators *//
 
-         iterator begin() noexcept {
-            return iterator(m_head);
+        iterator begin() noexcept {
+            return iterator(m_sentinel.m_next);
         }
 
-         const_iterator begin() const noexcept {
-            return const_iterator(m_head);
+        const_iterator begin() const noexcept {
+            return const_iterator(m_sentinel.m_next);
         }
 
-         const_iterator cbegin() const noexcept {
-            return const_iterator(m_head);
+        const_iterator cbegin() const noexcept {
+            return const_iterator(m_sentinel.m_next);
         }
 
-         iterator end() noexcept {
-            return iterator(m_tail);
+        iterator end() noexcept {
+            return iterator(&m_sentinel);
         }
 
-         const_iterator end() const noexcept {
-            return const_iterator(m_tail);
+        const_iterator end() const noexcept {
+            return const_iterator(&m_sentinel);
         }
 
-         const_iterator cend() const noexcept {
-            return const_iterator(m_tail);
+        const_iterator cend() const noexcept {
+            return const_iterator(&m_sentinel);
         }
 
-         reverse_iterator rbegin() noexcept {
-            return reverse_iterator(m_tail);
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator(end());
         }
 
-         const_reverse_iterator rbegin() const noexcept {
-            return const_reverse_iterator(m_tail);
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
         }
 
-         const_reverse_iterator crbegin() const noexcept {
-            return const_reverse_iterator(m_tail);
+        const_reverse_iterator crbegin() const noexcept {
+            return const_reverse_iterator(cend());
         }
 
-         reverse_iterator rend() noexcept {
-            return reverse_iterator(m_head);
+        reverse_iterator rend() noexcept {
+            return reverse_iterator(begin());
         }
 
-         const_reverse_iterator rend() const noexcept {
-            return const_reverse_iterator(m_head);
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
         }
 
-         const_reverse_iterator crend() const noexcept {
-            return const_reverse_iterator(m_head);
+        const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator(cbegin());
         }
 
 
         //* Modifiers *//
 
-         void clear() noexcept;
+        void clear() noexcept;
 
-         iterator insert(const_iterator, const Tp&);
-         iterator insert(const_iterator, Tp&&);
-         iterator insert(const_iterator, size_type, const Tp&);
+        iterator insert(const_iterator, const Tp&);
+        iterator insert(const_iterator, Tp&&);
+        iterator insert(const_iterator, size_type, const Tp&);
 
-        template <class InputIt>
-         iterator insert(const_iterator, InputIt, InputIt);
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        iterator insert(const_iterator, InputIt, InputIt);
 
-         iterator insert(const_iterator, std::initializer_list<Tp>);
+        iterator insert(const_iterator, std::initializer_list<Tp>);
 
         template <class... Args>
-         iterator emplace(const_iterator, Args&&...);
+        iterator emplace(const_iterator, Args&&...);
 
-         iterator erase(const_iterator);
-         iterator erase(const_iterator, const_iterator);
+        iterator erase(const_iterator);
+        iterator erase(const_iterator, const_iterator);
 
-         void push_back(const Tp&);
-         void push_back(Tp&&);
+        void push_back(const Tp&);
+        void push_back(Tp&&);
 
         template <class... Args>
-         reference emplace_back(Args&&...);
+        reference emplace_back(Args&&...);
 
-         void pop_back();
+        void pop_back();
 
-         void push_front(const Tp&);
-         void push_front(Tp&&);
+        void push_front(const Tp&);
+        void push_front(Tp&&);
 
         template <class... Args>
-         reference emplace_front(Args&&...);
+        reference emplace_front(Args&&...);
+
+        void pop_front();
+
+        void resize(const size_type);
+        void resize(const size_type, const Tp&);
+
+        void swap(doubly_linked_list&) noexcept(std::allocator_traits<allocator_type>::propagate_on_container_swap::value || 
+                                                std::allocator_traits<allocator_type>::is_always_equal::value);
+
+
+        //* Operations *//
+
+        void splice(const_iterator, doubly_linked_list&);
+        void splice(const_iterator, doubly_linked_list&&);
+        void splice(const_iterator, doubly_linked_list&, const_iterator);
+        void splice(const_iterator, doubly_linked_list&&, const_iterator);
+        void splice(const_iterator, doubly_linked_list&, const_iterator, const_iterator);
+        void splice(const_iterator, doubly_linked_list&&, const_iterator, const_iterator);
 
-         void pop_front();
+        void merge(doubly_linked_list&);
+        void merge(doubly_linked_list&&);
 
-         void resize(const size_type);
-         void resize(const size_type, const Tp&);
+        template <class Compare>
+        void merge(doubly_linked_list&, Compare);
 
-         void swap(doubly_linked_list&) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value);
+        template <class Compare>
+        void merge(doubly_linked_list&&, Compare);
+
+        void sort();
+
+        template <class Compare>
+        void sort(Compare);
+
+        void reverse() noexcept;
+
+        size_type unique();
+
+        template <class BinaryPredicate>
+        size_type unique(BinaryPredicate);
+
+
+        //* Memory Layout *//
+
+        void compact();
+        void compact(allocator_type);
+
+        [[nodiscard]] double fragmentation() const noexcept;
 
 
     private:
 
+        friend struct details::snapshot_access;
+
         //*** Using Directives ***//
 
         using node_base_t = typename details::doubly_node_base<Tp>;
         using node_t = typename details::doubly_node<Tp>;
 
+        using alloc_traits = std::allocator_traits<allocator_type>;
+        using node_allocator_type = typename alloc_traits::template rebind_alloc<node_t>;
+        using node_traits = std::allocator_traits<node_allocator_type>;
+
+        static_assert(std::is_same_v<typename node_traits::pointer, node_t*>, "dsl::doubly_linked_list requires an allocator with raw pointers.");
+
 
         //*** Members ***//
 
-        allocator_type m_allocator;
-        node_base_t *m_head;
-        node_base_t *m_tail;
+        node_base_t m_sentinel;
 
 
         //*** Functions ***//
 
         void try_copy(const doubly_linked_list&);
         void try_move(doubly_linked_list&&);
+        void swap_nodes(doubly_linked_list&) noexcept;
         void resize_erase(const size_type);
         void resize_emplace(const size_type, const Tp&);
+
+        template <class... Args>
+        node_t* create_node(Args&&...);
+        void destroy_node(node_base_t*) noexcept;
+
+        static node_t* allocate_node(allocator_type&);
+        static void deallocate_node(node_base_t*, allocator_type&) noexcept;
+
+        static void link_range(node_base_t*, node_base_t*, node_base_t*) noexcept;
+        static void unlink_range(node_base_t*, node_base_t*) noexcept;
+
+        template <class Compare>
+        static node_base_t* merge_chains(node_base_t*, node_base_t*, Compare&);
+
+        static size_type deallocate_chain(node_base_t*, allocator_type&) noexcept;
+        void rebind_allocator(const allocator_type&) noexcept;
+        void relink_prev() noexcept;
     };
 
 
@@ -425,29 +511,182 @@ namespace dsl {
 
     //*** Private ***//
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::try_copy(const doubly_linked_list<Tp> &other) {
-        clear();
-        for (const Tp &value : other) 
-            push_back(value);
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::try_copy(const doubly_linked_list<Tp, Allocator> &other) {
+        assign(other.begin(), other.end());
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::try_move(doubly_linked_list<Tp> &&other) {
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::try_move(doubly_linked_list<Tp, Allocator> &&other) {
         clear();
-        swap(other);
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            this->replace_allocator(other.allocator_ref());
+        swap_nodes(other);
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::resize_erase(const size_type count) {
-        auto first = std::advance(begin(), count);
+    /**
+     * @brief Exchanges the nodes of two lists whose allocators are known to be interchangeable.
+     * The sentinels stay in place, so the chains are exchanged by relinking their end nodes.
+     */
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::swap_nodes(doubly_linked_list &other) noexcept {
+        auto first = m_sentinel.m_next;
+        auto last = m_sentinel.m_prev;
+        auto other_first = other.m_sentinel.m_next;
+        auto other_last = other.m_sentinel.m_prev;
+
+        if (other.empty()) {
+            m_sentinel.m_next = m_sentinel.m_prev = &m_sentinel;
+        } else {
+            m_sentinel.m_next = other_first;
+            m_sentinel.m_prev = other_last;
+            other_first->m_prev = other_last->m_next = &m_sentinel;
+        }
+
+        if (this->empty()) {
+            other.m_sentinel.m_next = other.m_sentinel.m_prev = &other.m_sentinel;
+        } else {
+            other.m_sentinel.m_next = first;
+            other.m_sentinel.m_prev = last;
+            first->m_prev = last->m_next = &other.m_sentinel;
+        }
+
+        using std::swap;
+        swap(this->m_size, other.m_size);
+    }
+
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::resize_erase(const size_type count) {
+        // Walk from whichever end is closer to the first erased element
+        auto first = (count < this->m_size / 2) ? std::next(begin(), count) : std::prev(end(), this->m_size - count);
         erase(first, end());
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::resize_emplace(const size_type count, const Tp &value) {
-        for (auto i = 0; i < count; ++i) 
-            push_back(value);
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::resize_emplace(const size_type count, const Tp &value) {
+        insert(end(), count - this->m_size, value);
+    }
+
+    template <typename Tp, class Allocator>
+    template <class... Args>
+    typename doubly_linked_list<Tp, Allocator>::node_t* doubly_linked_list<Tp, Allocator>::create_node(Args &&...args) {
+        auto pNode = allocate_node(this->allocator_ref());
+
+        try {
+            alloc_traits::construct(this->allocator_ref(), std::addressof(pNode->m_value), std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate_node(pNode, this->allocator_ref());
+            throw;
+        }
+
+        details::record_event(this, container_event::node_allocation, sizeof(node_t));
+        return pNode;
+    }
+
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::destroy_node(node_base_t *node) noexcept {
+        auto pNode = static_cast<node_t*>(node);
+        alloc_traits::destroy(this->allocator_ref(), std::addressof(pNode->m_value));
+        deallocate_node(pNode, this->allocator_ref());
+        details::record_event(this, container_event::node_deallocation, sizeof(node_t));
+    }
+
+    /**
+     * @brief Links the detached chain first..last in front of pos.
+     */
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::link_range(node_base_t *pos, node_base_t *first, node_base_t *last) noexcept {
+        auto prev = pos->m_prev;
+        prev->m_next = first;
+        first->m_prev = prev;
+        last->m_next = pos;
+        pos->m_prev = last;
+    }
+
+    /**
+     * @brief Detaches the chain first..last from its neighbours, leaving its own links dangling.
+     */
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::unlink_range(node_base_t *first, node_base_t *last) noexcept {
+        first->m_prev->m_next = last->m_next;
+        last->m_next->m_prev = first->m_prev;
+    }
+
+    /**
+     * @brief Merges two null-terminated chains that are sorted with respect to comp by relinking
+     * their m_next pointers only. Elements of lhs precede equivalent elements of rhs.
+     */
+    template <typename Tp, class Allocator>
+    template <class Compare>
+    typename doubly_linked_list<Tp, Allocator>::node_base_t* doubly_linked_list<Tp, Allocator>::merge_chains(node_base_t *lhs, node_base_t *rhs, Compare &comp) {
+        node_base_t head;
+        auto tail = &head;
+
+        while (lhs && rhs) {
+            if (comp(static_cast<node_t*>(rhs)->m_value, static_cast<node_t*>(lhs)->m_value)) {
+                tail->m_next = rhs;
+                rhs = rhs->m_next;
+            } else {
+                tail->m_next = lhs;
+                lhs = lhs->m_next;
+            }
+            tail = tail->m_next;
+        }
+
+        tail->m_next = lhs ? lhs : rhs;
+        return head.m_next;
+    }
+
+    /**
+     * @brief Restores the m_prev pointers and closes the circular chain after the m_next
+     * chain starting at the sentinel has been rearranged and null-terminated.
+     */
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::relink_prev() noexcept {
+        node_base_t *prev = &m_sentinel;
+        for (auto node = m_sentinel.m_next; node; node = node->m_next) {
+            node->m_prev = prev;
+            prev = node;
+        }
+        prev->m_next = &m_sentinel;
+        m_sentinel.m_prev = prev;
+    }
+
+    template <typename Tp, class Allocator>
+    typename doubly_linked_list<Tp, Allocator>::node_t* doubly_linked_list<Tp, Allocator>::allocate_node(allocator_type &allocator) {
+        node_allocator_type node_allocator(allocator);
+        return node_traits::allocate(node_allocator, 1);
+    }
+
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::deallocate_node(node_base_t *node, allocator_type &allocator) noexcept {
+        node_allocator_type node_allocator(allocator);
+        node_traits::deallocate(node_allocator, static_cast<node_t*>(node), 1);
+    }
+
+    /**
+     * @brief Releases the raw storage of a null-terminated chain of nodes whose values are not constructed,
+     * and returns the number of nodes released.
+     */
+    template <typename Tp, class Allocator>
+    typename doubly_linked_list<Tp, Allocator>::size_type doubly_linked_list<Tp, Allocator>::deallocate_chain(node_base_t *node, allocator_type &allocator) noexcept {
+        size_type count = 0;
+        while (node) {
+            auto next = node->m_next;
+            deallocate_node(node, allocator);
+            node = next;
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Replaces the allocator once every node has been moved to memory obtained from the new one.
+     */
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::rebind_allocator(const allocator_type &allocator) noexcept {
+        if (this->allocator_ref() != allocator) 
+            this->replace_allocator(allocator);
     }
 
 
@@ -455,20 +694,28 @@ namespace dsl {
 
     //* Assignment Operator Overloads *//
 
-    template <typename Tp>
-    doubly_linked_list<Tp>& doubly_linked_list<Tp>::operator=(const doubly_linked_list<Tp> &other) {
-        if (this != &other) 
+    template <typename Tp, class Allocator>
+    doubly_linked_list<Tp, Allocator>& doubly_linked_list<Tp, Allocator>::operator=(const doubly_linked_list<Tp, Allocator> &other) {
+        if (this != &other) {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (this->allocator_ref() != other.allocator_ref()) 
+                    clear();
+                this->replace_allocator(other.allocator_ref());
+            }
             try_copy(other);
+        }
         return *this;
     }
 
-    template <typename Tp>
-    doubly_linked_list<Tp>& doubly_linked_list<Tp>::operator=(doubly_linked_list<Tp> &&other) {
-        if (this != other) {
-            if (m_allocator == other.m_allocator)
+    template <typename Tp, class Allocator>
+    doubly_linked_list<Tp, Allocator>& doubly_linked_list<Tp, Allocator>::operator=(doubly_linked_list<Tp, Allocator> &&other) {
+        if (this != &other) {
+            if (alloc_traits::propagate_on_container_move_assignment::value || this->allocator_ref() == other.allocator_ref()) {
                 try_move(std::move(other));
-            else
-                operator=(other);   // copy assignment
+            } else {
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+            }
         }
         return *this;
     }
@@ -476,214 +723,503 @@ namespace dsl {
 
     //* Assign and allocator access *//
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::assign(const size_type count, const Tp &value) {
-        resize(count);
-        for (auto it = begin(); it != end(); ++it) 
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::assign(const size_type count, const Tp &value) {
+        auto it = begin();
+        size_type i = 0;
+        for (; i < count && it != end(); ++i, ++it) 
             *it = value;
+
+        if (i < count) 
+            insert(end(), count - i, value);
+        else 
+            erase(it, end());
     }
 
-    template <typename Tp>
-    template <class InputIt>
-    void doubly_linked_list<Tp>::assign(InputIt first, InputIt last) {
-        resize(std::distance(first, last));
+    template <typename Tp, class Allocator>
+    template <class InputIt, typename>
+    void doubly_linked_list<Tp, Allocator>::assign(InputIt first, InputIt last) {
         auto it = begin();
-        for (; first != last && it != end(); ++first)
+        for (; first != last && it != end(); ++first, ++it)
             *it = *first;
+
+        if (first != last) 
+            insert(end(), first, last);
+        else 
+            erase(it, end());
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::assign(std::initializer_list<Tp> ilist) {
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::assign(std::initializer_list<Tp> ilist) {
         assign(ilist.begin(), ilist.end());
     }
 
-    template <typename Tp>
-    typename doubly_linked_list<Tp>::allocator_type doubly_linked_list<Tp>::get_allocator() const noexcept {
-        return m_allocator;
+    template <typename Tp, class Allocator>
+    typename doubly_linked_list<Tp, Allocator>::allocator_type doubly_linked_list<Tp, Allocator>::get_allocator() const noexcept {
+        return this->allocator_ref();
     }
 
 
     //* Modifiers *//
     
-    template <typename Tp>
-    void doubly_linked_list<Tp>::clear() noexcept {
+    /**
+     * @brief Destroys every element. Trivially destructible elements allocated from an arena are
+     * dropped in O(1) by detaching the chain, as deallocating their nodes would be a no-op.
+     */
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::clear() noexcept {
+        if constexpr (std::is_trivially_destructible_v<Tp>) {
+            if (!this->empty() && details::is_arena(this->allocator_ref())) {
+                m_sentinel.m_next = m_sentinel.m_prev = &m_sentinel;
+                // One event per dropped node, so that instrumentation counters stay balanced; the loop
+                // compiles away when the container is not instrumented
+                for (size_type i = 0; i < this->m_size; ++i) 
+                    details::record_event(this, container_event::node_deallocation, sizeof(node_t));
+                this->m_size = 0;
+                return;
+            }
+        }
+
         erase(begin(), end());
     }
 
-    template <typename Tp>
-    typename doubly_linked_list<Tp>::iterator doubly_linked_list<Tp>::insert(const_iterator pos, const Tp &value) {
+    template <typename Tp, class Allocator>
+    typename doubly_linked_list<Tp, Allocator>::iterator doubly_linked_list<Tp, Allocator>::insert(const_iterator pos, const Tp &value) {
         return emplace(pos, value);
     }
 
-    template <typename Tp>
-    typename doubly_linked_list<Tp>::iterator doubly_linked_list<Tp>::insert(const_iterator pos, Tp &&value) {
+    template <typename Tp, class Allocator>
+    typename doubly_linked_list<Tp, Allocator>::iterator doubly_linked_list<Tp, Allocator>::insert(const_iterator pos, Tp &&value) {
         return emplace(pos, std::move(value));
     }
 
-    template <typename Tp>
-    typename doubly_linked_list<Tp>::iterator doubly_linked_list<Tp>::insert(const_iterator pos, const size_type count, const Tp &value) {
-        auto it = dynamic_cast<iterator>(pos);
-        for (auto i = 0; i < count; ++i) 
+    template <typename Tp, class Allocator>
+    typename doubly_linked_list<Tp, Allocator>::iterator doubly_linked_list<Tp, Allocator>::insert(const_iterator pos, const size_type count, const Tp &value) {
+        auto it = iterator(pos.m_curr);
+        for (size_type i = 0; i < count; ++i) 
             it = emplace(it, value);
         return it;
     }
 
-    template <typename Tp>
-    template <class InputIt>
-    typename doubly_linked_list<Tp>::iterator doubly_linked_list<Tp>::insert(const_iterator pos, InputIt first, InputIt last) {
-        auto it = dynamic_cast<iterator>(pos);
+    template <typename Tp, class Allocator>
+    template <class InputIt, typename>
+    typename doubly_linked_list<Tp, Allocator>::iterator doubly_linked_list<Tp, Allocator>::insert(const_iterator pos, InputIt first, InputIt last) {
+        auto prev = pos.m_curr->m_prev;
         for (; first != last; ++first) 
-            it = emplace(it, *first);
-        return it;
+            emplace(pos, *first);
+        return iterator(prev->m_next);
     }
 
-    template <typename Tp>
-    typename doubly_linked_list<Tp>::iterator doubly_linked_list<Tp>::insert(const_iterator pos, std::initializer_list<Tp> ilist) {
+    template <typename Tp, class Allocator>
+    typename doubly_linked_list<Tp, Allocator>::iterator doubly_linked_list<Tp, Allocator>::insert(const_iterator pos, std::initializer_list<Tp> ilist) {
         return insert(pos, ilist.begin(), ilist.end());
     }
 
-    template <typename Tp>
+    template <typename Tp, class Allocator>
     template <class... Args>
-    typename doubly_linked_list<Tp>::iterator doubly_linked_list<Tp>::emplace(const_iterator pos, Args &&...args) {
-        auto pNode = static_cast<node_t*>(m_allocator.resource()->allocate(sizeof(node_t), alignof(node_t)));
-
-        try {
-            m_allocator.construct(std::addressof(pNode->m_value), std::forward<Args>(args)...);
-        } catch (...) {
-            m_allocator.resource()->deallocate(pNode, sizeof(node_t), alignof(node_t));
-            throw;
+    typename doubly_linked_list<Tp, Allocator>::iterator doubly_linked_list<Tp, Allocator>::emplace(const_iterator pos, Args &&...args) {
+        node_base_t *pNode = create_node(std::forward<Args>(args)...);
+        if constexpr (instrumentation_policy<doubly_linked_list<Tp, Allocator>>::enabled) {
+            // Only the ends have a known index without a walk
+            auto position = pos.m_curr == m_sentinel.m_next ? 0 : pos.m_curr == &m_sentinel ? this->m_size : unknown_position;
+            details::record_event(this, container_event::insertion, this->m_size + 1, position);
         }
+        link_range(pos.m_curr, pNode, pNode);
 
-        pNode->m_next = pos.m_curr->m_next;
-        pNode->m_prev = pos.m_curr;
-        pos.m_curr->m_next->m_prev = pNode;
-        pos.m_curr->m_next = pNode;
-
-        if (pos.m_curr == m_tail) 
-            m_tail = pNode;
-        else if (pos.m_curr == m_head) 
-            m_head = pNode;
-        
         ++this->m_size;
-        return dynamic_cast<iterator>(pos);
+        return iterator(pNode);
     }
 
-    template <typename Tp>
-    typename doubly_linked_list<Tp>::iterator doubly_linked_list<Tp>::erase(const_iterator pos) {
+    template <typename Tp, class Allocator>
+    typename doubly_linked_list<Tp, Allocator>::iterator doubly_linked_list<Tp, Allocator>::erase(const_iterator pos) {
         return erase(pos, std::next(pos));
     }
 
-    template <typename Tp>
-    typename doubly_linked_list<Tp>::iterator doubly_linked_list<Tp>::erase(const_iterator first, const_iterator last) {
-        auto next = first.m_curr;
-        auto past = last.m_curr;
+    template <typename Tp, class Allocator>
+    typename doubly_linked_list<Tp, Allocator>::iterator doubly_linked_list<Tp, Allocator>::erase(const_iterator first, const_iterator last) {
+        if (first == last) 
+            return iterator(last.m_curr);
 
-        if (past == nullptr) 
-            m_tail = first.m_curr->m_prev;
-        
-        first.m_curr = past;
-        
-        while (next != last) {
+        unlink_range(first.m_curr, last.m_curr->m_prev);
+
+        auto next = first.m_curr;
+        while (next != last.m_curr) {
             auto old = next;
             next = next->m_next;
             --this->m_size;
-            std::allocator_traits<allocator_type>::destroy(m_allocator, std::addressof(old));
-            m_allocator.resource()->deallocate(old, sizeof(node_t), alignof(node_t));
+            destroy_node(old);
         }
 
-        return dynamic_cast<iterator>(first);
+        return iterator(last.m_curr);
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::push_back(const Tp &value) {
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::push_back(const Tp &value) {
         emplace_back(value);
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::push_back(Tp &&value) {
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::push_back(Tp &&value) {
         emplace_back(std::move(value));
     }
 
-    template <typename Tp>
+    template <typename Tp, class Allocator>
     template <class... Args>
-    typename doubly_linked_list<Tp>::reference doubly_linked_list<Tp>::emplace_back(Args &&...args) {
+    typename doubly_linked_list<Tp, Allocator>::reference doubly_linked_list<Tp, Allocator>::emplace_back(Args &&...args) {
         auto it = emplace(end(), std::forward<Args>(args)...);
         return *it;
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::pop_back() {
-        erase(end());
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::pop_back() {
+        erase(std::prev(end()));
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::push_front(const Tp &value) {
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::push_front(const Tp &value) {
         emplace_front(value);
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::push_front(Tp &&value) {
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::push_front(Tp &&value) {
         emplace_front(std::move(value));
     }
 
-    template <typename Tp>
+    template <typename Tp, class Allocator>
     template <class... Args>
-    typename doubly_linked_list<Tp>::reference doubly_linked_list<Tp>::emplace_front(Args &&...args) {
+    typename doubly_linked_list<Tp, Allocator>::reference doubly_linked_list<Tp, Allocator>::emplace_front(Args &&...args) {
         auto it = emplace(begin(), std::forward<Args>(args)...);
         return *it;
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::resize(const size_type count) {
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::pop_front() {
+        erase(begin());
+    }
+
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::resize(const size_type count) {
         if (count < this->m_size) 
             resize_erase(count);
-        else if (count > this->m_size) 
-            resize_emplace(count, Tp());
-        this->m_size = count;
+        else 
+            while (this->m_size < count) 
+                emplace_back();
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::resize(const size_type count, const Tp &value) {
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::resize(const size_type count, const Tp &value) {
         if (count < this->m_size) 
             resize_erase(count);
         else if (count > this->m_size) 
             resize_emplace(count, value);
-        this->m_size = count;
     }
 
-    template <typename Tp>
-    void doubly_linked_list<Tp>::swap(doubly_linked_list<Tp> &other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
-        if (m_allocator == other.m_allocator) {
-            auto head = other.empty() ? m_tail : other.m_head;
-            auto other_head = this->empty() ? other.m_tail : m_head;
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::swap(doubly_linked_list<Tp, Allocator> &other) noexcept(std::allocator_traits<allocator_type>::propagate_on_container_swap::value || 
+                                                                                                    std::allocator_traits<allocator_type>::is_always_equal::value) {
+        if (this == &other || !(alloc_traits::propagate_on_container_swap::value || this->allocator_ref() == other.allocator_ref())) 
+            return;
+
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+            this->swap_allocator(other);
+        swap_nodes(other);
+    }
+
+
+    //* Operations *//
+
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::splice(const_iterator pos, doubly_linked_list<Tp, Allocator> &other) {
+        if (this == &other || other.empty()) 
+            return;
 
-            auto tail = other.empty() ? m_head : other.m_tail;
-            auto other_tail = this->empty() ? other.m_head : m_tail;
+        auto first = other.m_sentinel.m_next;
+        auto last = other.m_sentinel.m_prev;
+        unlink_range(first, last);
+        link_range(pos.m_curr, first, last);
 
-            swap(this->m_size, other.m_size);
-            m_head = head;
-            other.m_head = other_head;
-            m_tail = tail;
-            other.m_tail = other_tail;
+        this->m_size += other.m_size;
+        other.m_size = 0;
+    }
+
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::splice(const_iterator pos, doubly_linked_list<Tp, Allocator> &&other) {
+        splice(pos, other);
+    }
+
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::splice(const_iterator pos, doubly_linked_list<Tp, Allocator> &other, const_iterator it) {
+        auto node = it.m_curr;
+        if (pos.m_curr == node || pos.m_curr == node->m_next) 
+            return;
+
+        unlink_range(node, node);
+        link_range(pos.m_curr, node, node);
+
+        --other.m_size;
+        ++this->m_size;
+    }
+
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::splice(const_iterator pos, doubly_linked_list<Tp, Allocator> &&other, const_iterator it) {
+        splice(pos, other, it);
+    }
+
+    /**
+     * @brief Moves the nodes in [first, last) of other in front of pos. Relinking is O(1); when
+     * other is a different list, the range is additionally walked once to keep both sizes accurate.
+     */
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::splice(const_iterator pos, doubly_linked_list<Tp, Allocator> &other, const_iterator first, const_iterator last) {
+        if (first == last || pos == last) 
+            return;
+
+        if (this != &other) {
+            auto count = static_cast<size_type>(std::distance(first, last));
+            details::record_event(this, container_event::traversal, count);
+            other.m_size -= count;
+            this->m_size += count;
         }
+
+        auto range_first = first.m_curr;
+        auto range_last = last.m_curr->m_prev;
+        unlink_range(range_first, range_last);
+        link_range(pos.m_curr, range_first, range_last);
+    }
+
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::splice(const_iterator pos, doubly_linked_list<Tp, Allocator> &&other, const_iterator first, const_iterator last) {
+        splice(pos, other, first, last);
     }
 
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::merge(doubly_linked_list<Tp, Allocator> &other) {
+        merge(other, std::less<>());
+    }
 
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::merge(doubly_linked_list<Tp, Allocator> &&other) {
+        merge(other, std::less<>());
+    }
 
-    //*** Non-Member Function Implementations ***//
+    /**
+     * @brief Merges the sorted list other into this sorted list by relinking nodes, without
+     * copying or allocating. Elements of *this precede equivalent elements of other.
+     */
+    template <typename Tp, class Allocator>
+    template <class Compare>
+    void doubly_linked_list<Tp, Allocator>::merge(doubly_linked_list<Tp, Allocator> &other, Compare comp) {
+        if (this == &other || other.empty()) 
+            return;
+
+        auto first = begin();
+        auto other_first = other.begin();
+
+        while (first != end() && other_first != other.end()) {
+            if (comp(*other_first, *first)) {
+                // Move the whole run of other's elements that precede *first in one step
+                auto run_last = std::next(other_first);
+                while (run_last != other.end() && comp(*run_last, *first)) 
+                    ++run_last;
+
+                auto range_first = other_first.m_curr;
+                auto range_last = run_last.m_curr->m_prev;
+                unlink_range(range_first, range_last);
+                link_range(first.m_curr, range_first, range_last);
+                other_first = run_last;
+            } else {
+                ++first;
+            }
+        }
 
-    template <typename Tp>
-    bool operator==(const doubly_linked_list<Tp> &lhs, const doubly_linked_list<Tp> &rhs) noexcept {
-        return (lhs.size() != rhs.size()) ? false : std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        if (other_first != other.end()) {
+            auto range_first = other_first.m_curr;
+            auto range_last = other.m_sentinel.m_prev;
+            unlink_range(range_first, range_last);
+            link_range(&m_sentinel, range_first, range_last);
+        }
+
+        this->m_size += other.m_size;
+        other.m_size = 0;
+    }
+
+    template <typename Tp, class Allocator>
+    template <class Compare>
+    void doubly_linked_list<Tp, Allocator>::merge(doubly_linked_list<Tp, Allocator> &&other, Compare comp) {
+        merge(other, comp);
+    }
+
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::sort() {
+        sort(std::less<>());
     }
 
-    template <typename Tp>
-    bool operator!=(const doubly_linked_list<Tp> &lhs, const doubly_linked_list<Tp> &rhs) {
-        return !operator==(lhs, rhs);
+    /**
+     * @brief Stable bottom-up merge sort. Nodes are relinked in place, so no element is copied or 
+     * moved and no memory is allocated; the pending runs are held in a fixed array of chain heads
+     * where bin i holds a sorted run of 2^i nodes.
+     */
+    template <typename Tp, class Allocator>
+    template <class Compare>
+    void doubly_linked_list<Tp, Allocator>::sort(Compare comp) {
+        if (this->m_size < 2) 
+            return;
+
+        node_base_t *bins[64] = {};
+        std::size_t fill = 0;
+
+        m_sentinel.m_prev->m_next = nullptr;
+        auto node = m_sentinel.m_next;
+
+        while (node) {
+            auto carry = node;
+            node = node->m_next;
+            carry->m_next = nullptr;
+
+            // Older runs sit in the bins, so they are passed first to keep the sort stable
+            std::size_t i = 0;
+            for (; i < fill && bins[i]; ++i) {
+                carry = merge_chains(bins[i], carry, comp);
+                bins[i] = nullptr;
+            }
+
+            bins[i] = carry;
+            if (i == fill) 
+                ++fill;
+        }
+
+        node_base_t *result = nullptr;
+        for (std::size_t i = 0; i < fill; ++i) 
+            if (bins[i]) 
+                result = merge_chains(bins[i], result, comp);
+
+        m_sentinel.m_next = result;
+        relink_prev();
     }
 
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::reverse() noexcept {
+        auto node = static_cast<node_base_t*>(&m_sentinel);
+        do {
+            std::swap(node->m_prev, node->m_next);
+            node = node->m_prev;
+        } while (node != &m_sentinel);
+    }
+
+    template <typename Tp, class Allocator>
+    typename doubly_linked_list<Tp, Allocator>::size_type doubly_linked_list<Tp, Allocator>::unique() {
+        return unique(std::equal_to<>());
+    }
+
+    template <typename Tp, class Allocator>
+    template <class BinaryPredicate>
+    typename doubly_linked_list<Tp, Allocator>::size_type doubly_linked_list<Tp, Allocator>::unique(BinaryPredicate pred) {
+        auto old_size = this->m_size;
+        if (this->m_size < 2) 
+            return 0;
+
+        auto first = begin();
+        auto next = std::next(first);
+
+        while (next != end()) {
+            if (pred(*first, *next)) {
+                next = erase(next);
+            } else {
+                first = next;
+                ++next;
+            }
+        }
+
+        return old_size - this->m_size;
+    }
+
+
+    //* Memory Layout *//
+
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::compact() {
+        compact(this->allocator_ref());
+    }
+
+    /**
+     * @brief Reallocates every node from allocator in iteration order and relinks them, so that a
+     * traversal walks memory sequentially again. All new nodes are obtained before any old node is
+     * released, which keeps the allocator from recycling the scattered holes; with a fresh
+     * std::pmr::monotonic_buffer_resource or unsynchronized_pool_resource the nodes end up
+     * contiguous. The list adopts allocator afterwards. Invalidates all iterators and references.
+     *
+     * Provides the strong exception guarantee unless moving Tp may throw and Tp is not copyable.
+     */
+    template <typename Tp, class Allocator>
+    void doubly_linked_list<Tp, Allocator>::compact(allocator_type allocator) {
+        node_base_t chain;
+        node_base_t *tail = &chain;
+        chain.m_next = nullptr;
+
+        // Obtain every node up front, so that once values start moving only a throwing copy can fail
+        try {
+            for (size_type i = 0; i < this->m_size; ++i) {
+                auto node = allocate_node(allocator);
+                details::record_event(this, container_event::node_allocation, sizeof(node_t));
+                node->m_next = nullptr;
+                tail->m_next = node;
+                tail = node;
+            }
+        } catch (...) {
+            for (auto count = deallocate_chain(chain.m_next, allocator); count; --count) 
+                details::record_event(this, container_event::node_deallocation, sizeof(node_t));
+            throw;
+        }
+
+        auto dest = chain.m_next;
+        size_type built = 0;
+        try {
+            for (auto src = m_sentinel.m_next; built < this->m_size; src = src->m_next, dest = dest->m_next, ++built) 
+                alloc_traits::construct(allocator, std::addressof(static_cast<node_t*>(dest)->m_value), 
+                                        std::move_if_noexcept(static_cast<node_t*>(src)->m_value));
+        } catch (...) {
+            dest = chain.m_next;
+            for (size_type i = 0; i < built; ++i, dest = dest->m_next) 
+                alloc_traits::destroy(allocator, std::addressof(static_cast<node_t*>(dest)->m_value));
+            for (auto count = deallocate_chain(chain.m_next, allocator); count; --count) 
+                details::record_event(this, container_event::node_deallocation, sizeof(node_t));
+            throw;
+        }
+
+        auto src = m_sentinel.m_next;
+        for (size_type i = 0; i < this->m_size; ++i) {
+            auto old = src;
+            src = src->m_next;
+            destroy_node(old);
+        }
+
+        if (this->m_size) {
+            m_sentinel.m_next = chain.m_next;
+            relink_prev();
+        }
+        rebind_allocator(allocator);
+    }
+
+    /**
+     * @brief Estimates how far the node order diverges from address order, as the fraction of links
+     * whose target does not directly follow the current node in memory. Returns 0 for a perfectly
+     * sequential layout and approaches 1 when every hop lands somewhere unrelated.
+     */
+    template <typename Tp, class Allocator>
+    double doubly_linked_list<Tp, Allocator>::fragmentation() const noexcept {
+        if (this->m_size < 2) 
+            return 0.0;
+
+        size_type jumps = 0;
+        auto node = m_sentinel.m_next;
+        for (size_type i = 1; i < this->m_size; ++i, node = node->m_next) 
+            if (!details::is_sequential(node, node->m_next, sizeof(node_t))) 
+                ++jumps;
+
+        return static_cast<double>(jumps) / static_cast<double>(this->m_size - 1);
+    }
 
 }   // namespace dsl
 
 
-#endif // DSL_DOUBLY_LINKED_LIST_H
\ No newline at end of file
+#endif // DSL_DOUBLY_LINKED_LIST_H
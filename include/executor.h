@@ -0,0 +1,215 @@
+#ifndef DSL_EXECUTOR_H
+#define DSL_EXECUTOR_H
+
+
+#if __cplusplus < 202002L
+#error "executor.h requires C++20 coroutines."
+#endif
+
+#include <algorithm>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace dsl {
+
+    /**
+     * @brief Resumes coroutines handed to it by the asynchronous containers (such as a channel
+     * waking a suspended receiver). post may run the coroutine at any later point, on any thread
+     * the executor owns, but never inline.
+     */
+    class executor {
+    public:
+        virtual void post(std::coroutine_handle<>) = 0;
+
+    protected:
+        executor() = default;
+        ~executor() = default;
+    };
+
+
+    /**
+     * @brief Single-threaded executor. Posted coroutines are queued and resumed in order by run(),
+     * on the thread calling it. Not thread-safe: post must be called from that same thread.
+     */
+    class run_loop : public executor {
+    public:
+        run_loop() = default;
+
+        run_loop(const run_loop&) = delete;
+        run_loop& operator=(const run_loop&) = delete;
+
+        void post(const std::coroutine_handle<> handle) override {
+            m_ready.push_back(handle);
+        }
+
+        /**
+         * @brief Resumes queued coroutines, including those posted while running, until none is left.
+         */
+        void run() {
+            while (!m_ready.empty()) {
+                auto handle = m_ready.front();
+                m_ready.pop_front();
+                handle.resume();
+            }
+        }
+
+    private:
+        std::deque<std::coroutine_handle<>> m_ready;
+    };
+
+
+    /**
+     * @brief Executor resuming posted coroutines on a fixed set of worker threads. The
+     * destructor lets the workers finish every coroutine posted before it, then joins them.
+     */
+    class thread_pool : public executor {
+    public:
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit thread_pool(const std::size_t thread_count = std::thread::hardware_concurrency())
+            : m_stopping(false)
+        {
+            auto count = std::max<std::size_t>(thread_count, 1);
+            m_threads.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+                m_threads.emplace_back([this] { work(); });
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+
+        //* Destructor *//
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_ready_cv.notify_all();
+
+            for (auto &thread : m_threads)
+                thread.join();
+        }
+
+
+        //* Access *//
+
+        [[nodiscard]] std::size_t thread_count() const noexcept {
+            return m_threads.size();
+        }
+
+
+        //* Modifiers *//
+
+        void post(const std::coroutine_handle<> handle) override {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_ready.push_back(handle);
+            }
+            m_ready_cv.notify_one();
+        }
+
+
+    private:
+        void work() {
+            for (;;) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_ready_cv.wait(lock, [this] { return m_stopping || !m_ready.empty(); });
+                if (m_ready.empty())
+                    return;
+
+                auto handle = m_ready.front();
+                m_ready.pop_front();
+                lock.unlock();
+
+                handle.resume();
+            }
+        }
+
+        std::mutex m_mutex;
+        std::condition_variable m_ready_cv;
+        std::deque<std::coroutine_handle<>> m_ready;
+        bool m_stopping;
+        std::vector<std::thread> m_threads;
+    };
+
+
+    /**
+     * @brief Coroutine type for work started with spawn. The coroutine is created suspended, is
+     * resumed first by the executor it is spawned on, and frees itself on completion; it cannot
+     * be awaited. An exception escaping it terminates the program.
+     */
+    class detached_task {
+    public:
+        struct promise_type {
+            detached_task get_return_object() noexcept {
+                return detached_task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept { return {}; }
+
+            void return_void() const noexcept {}
+            void unhandled_exception() const noexcept { std::terminate(); }
+        };
+
+        detached_task(detached_task &&other) noexcept
+            : m_handle(std::exchange(other.m_handle, {})) {}
+
+        detached_task& operator=(detached_task&&) = delete;
+
+        // A task that was never spawned is destroyed without running
+        ~detached_task() {
+            if (m_handle)
+                m_handle.destroy();
+        }
+
+        friend void spawn(executor&, detached_task);
+
+    private:
+        explicit detached_task(const std::coroutine_handle<promise_type> handle) noexcept
+            : m_handle(handle) {}
+
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+    /**
+     * @brief Starts task by posting it to ex.
+     */
+    inline void spawn(executor &ex, detached_task task) {
+        ex.post(std::exchange(task.m_handle, {}));
+    }
+
+
+    /**
+     * @brief Awaitable moving the awaiting coroutine onto ex, e.g. co_await dsl::schedule_on(pool).
+     */
+    class schedule_on {
+    public:
+        explicit schedule_on(executor &ex) noexcept
+            : m_executor(&ex) {}
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(const std::coroutine_handle<> handle) const { m_executor->post(handle); }
+        void await_resume() const noexcept {}
+
+    private:
+        executor *m_executor;
+    };
+
+}   // namespace dsl
+
+
+#endif // DSL_EXECUTOR_H
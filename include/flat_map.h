@@ -0,0 +1,122 @@
+#ifndef DSL_FLAT_MAP_H
+#define DSL_FLAT_MAP_H
+
+
+#include "flat_tree.h"
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+
+namespace dsl {
+
+    /**
+     * @brief Sorted map of unique keys whose (key, value) pairs are stored contiguously in a
+     * dsl::list; see flat_set for the lookup and bulk-build behaviour. Mapped values may be
+     * modified through iterators, but keys must not be, as that would break the ordering.
+     *
+     * @tparam Key
+     * @tparam Tp
+     * @tparam Compare
+     */
+    template <typename Key, typename Tp, typename Compare = std::less<Key>>
+    class flat_map : public details::flat_tree<std::pair<Key, Tp>, Key, details::first_key, Compare> {
+    private:
+        using base_t = details::flat_tree<std::pair<Key, Tp>, Key, details::first_key, Compare>;
+
+    public:
+
+        //*** Member Types ***//
+
+        using mapped_type = Tp;
+        using typename base_t::value_type;
+        using typename base_t::size_type;
+        using typename base_t::allocator_type;
+        using typename base_t::iterator;
+        using typename base_t::const_iterator;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit flat_map(const Compare &compare = Compare(), allocator_type allocator = {})
+            : base_t(compare, allocator)
+        {}
+
+        explicit flat_map(allocator_type allocator)
+            : base_t(Compare(), allocator)
+        {}
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        flat_map(InputIt first, InputIt last, const Compare &compare = Compare(), allocator_type allocator = {})
+            : base_t(compare, allocator)
+        { insert(first, last); }
+
+        flat_map(std::initializer_list<value_type> init, const Compare &compare = Compare(), allocator_type allocator = {})
+            : base_t(compare, allocator)
+        { insert(init.begin(), init.end()); }
+
+
+        //* Element Access *//
+
+        Tp& at(const Key &key) {
+            auto it = this->find(key);
+            if (it == this->end())
+                throw std::out_of_range("Key not found.");
+            return it->second;
+        }
+
+        const Tp& at(const Key &key) const {
+            auto it = this->find(key);
+            if (it == this->end())
+                throw std::out_of_range("Key not found.");
+            return it->second;
+        }
+
+        Tp& operator[](const Key &key) {
+            return try_emplace(key).first->second;
+        }
+
+
+        //* Modifiers *//
+
+        std::pair<iterator, bool> insert(const value_type &value) {
+            return this->insert_unique(value.first, value);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value) {
+            return this->insert_unique(value.first, std::move(value));
+        }
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        void insert(InputIt first, InputIt last) {
+            this->insert_range(first, last);
+        }
+
+        void insert(std::initializer_list<value_type> init) {
+            this->insert_range(init.begin(), init.end());
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+            return this->insert_unique(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                       std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template <class M>
+        std::pair<iterator, bool> insert_or_assign(const Key &key, M &&value) {
+            auto result = try_emplace(key, std::forward<M>(value));
+            if (!result.second)
+                result.first->second = std::forward<M>(value);
+            return result;
+        }
+    };
+
+}   // namespace dsl
+
+
+#endif // DSL_FLAT_MAP_H
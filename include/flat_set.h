@@ -0,0 +1,85 @@
+#ifndef DSL_FLAT_SET_H
+#define DSL_FLAT_SET_H
+
+
+#include "flat_tree.h"
+
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+
+namespace dsl {
+
+    /**
+     * @brief Sorted set of unique keys stored contiguously in a dsl::list, for read-mostly data:
+     * lookups are branchless binary searches (or Eytzinger searches once build_index() is
+     * called), while single insertions and erasures shift the elements after them. Build from
+     * unsorted input through the range constructor or insert(first, last), which sort and
+     * deduplicate once.
+     *
+     * @tparam Key
+     * @tparam Compare
+     */
+    template <typename Key, typename Compare = std::less<Key>>
+    class flat_set : public details::flat_tree<Key, Key, details::identity_key, Compare> {
+    private:
+        using base_t = details::flat_tree<Key, Key, details::identity_key, Compare>;
+
+    public:
+
+        //*** Member Types ***//
+
+        using typename base_t::value_type;
+        using typename base_t::size_type;
+        using typename base_t::allocator_type;
+        using typename base_t::iterator;
+        using typename base_t::const_iterator;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit flat_set(const Compare &compare = Compare(), allocator_type allocator = {})
+            : base_t(compare, allocator)
+        {}
+
+        explicit flat_set(allocator_type allocator)
+            : base_t(Compare(), allocator)
+        {}
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        flat_set(InputIt first, InputIt last, const Compare &compare = Compare(), allocator_type allocator = {})
+            : base_t(compare, allocator)
+        { insert(first, last); }
+
+        flat_set(std::initializer_list<Key> init, const Compare &compare = Compare(), allocator_type allocator = {})
+            : base_t(compare, allocator)
+        { insert(init.begin(), init.end()); }
+
+
+        //* Modifiers *//
+
+        std::pair<iterator, bool> insert(const Key &key) {
+            return this->insert_unique(key, key);
+        }
+
+        std::pair<iterator, bool> insert(Key &&key) {
+            return this->insert_unique(key, std::move(key));
+        }
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        void insert(InputIt first, InputIt last) {
+            this->insert_range(first, last);
+        }
+
+        void insert(std::initializer_list<Key> init) {
+            this->insert_range(init.begin(), init.end());
+        }
+    };
+
+}   // namespace dsl
+
+
+#endif // DSL_FLAT_SET_H
@@ -0,0 +1,430 @@
+#ifndef DSL_FLAT_TREE_H
+#define DSL_FLAT_TREE_H
+
+
+#include "list.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+
+namespace dsl::details {
+
+    struct identity_key {
+        template <typename Tp>
+        constexpr const Tp& operator()(const Tp &value) const noexcept {
+            return value;
+        }
+    };
+
+    struct first_key {
+        template <typename Pair>
+        constexpr const auto& operator()(const Pair &value) const noexcept {
+            return value.first;
+        }
+    };
+
+    inline void prefetch(const void *address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        static_cast<void>(address);
+#endif
+    }
+
+    inline unsigned trailing_ones(std::size_t bits) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(~static_cast<unsigned long long>(bits)));
+#else
+        unsigned count = 0;
+        for (; bits & 1; bits >>= 1)
+            ++count;
+        return count;
+#endif
+    }
+
+
+    /**
+     * @brief Sorted, duplicate-free storage shared by flat_set and flat_map: the values sit in
+     * key order in a dsl::list, and lookups binary-search it without branching on the outcome of
+     * each comparison, which the compiler turns into conditional moves.
+     *
+     * For large, read-mostly sets, build_index() additionally lays a copy of the keys out in
+     * Eytzinger (breadth-first) order, in which the nodes visited by a search are packed towards
+     * the front and the descendants four levels down are contiguous, so they can be prefetched
+     * while the comparisons above them run. The index costs a key and a size_type per element,
+     * and is dropped by every modification until it is built again.
+     *
+     * @tparam Value
+     * @tparam Key
+     * @tparam KeyOf Projects a Value to its Key
+     * @tparam Compare
+     */
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    class flat_tree {
+    public:
+
+        //*** Member Types ***//
+
+        using key_type = Key;
+        using value_type = Value;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using key_compare = Compare;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        // The values of a set are its keys, so they are never mutable through an iterator
+        using const_iterator = typename list<Value>::const_iterator;
+        using iterator = std::conditional_t<std::is_same_v<Value, Key>, const_iterator, typename list<Value>::iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+
+        //*** Member Functions ***//
+
+        //* Iterators *//
+
+        iterator begin() noexcept { return m_values.begin(); }
+        const_iterator begin() const noexcept { return m_values.cbegin(); }
+        const_iterator cbegin() const noexcept { return m_values.cbegin(); }
+
+        iterator end() noexcept { return m_values.end(); }
+        const_iterator end() const noexcept { return m_values.cend(); }
+        const_iterator cend() const noexcept { return m_values.cend(); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+
+        //* Capacity *//
+
+        [[nodiscard]] bool empty() const noexcept {
+            return m_values.empty();
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return m_values.size();
+        }
+
+        void reserve(const size_type capacity) {
+            m_values.reserve(capacity);
+        }
+
+        void shrink_to_fit() {
+            m_values.shrink_to_fit();
+        }
+
+        [[nodiscard]] key_compare key_comp() const {
+            return m_compare;
+        }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept {
+            return m_values.get_allocator();
+        }
+
+
+        //* Lookup *//
+
+        iterator lower_bound(const Key &key) { return begin() + lower_bound_index(key); }
+        const_iterator lower_bound(const Key &key) const { return begin() + lower_bound_index(key); }
+
+        iterator upper_bound(const Key&);
+        const_iterator upper_bound(const Key&) const;
+
+        iterator find(const Key&);
+        const_iterator find(const Key&) const;
+
+        std::pair<iterator, iterator> equal_range(const Key &key) {
+            auto first = find(key);
+            return { first, first == end() ? first : std::next(first) };
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+            auto first = find(key);
+            return { first, first == end() ? first : std::next(first) };
+        }
+
+        [[nodiscard]] bool contains(const Key &key) const {
+            return find(key) != end();
+        }
+
+        [[nodiscard]] size_type count(const Key &key) const {
+            return contains(key) ? 1 : 0;
+        }
+
+
+        //* Index *//
+
+        void build_index();
+
+        void drop_index() noexcept {
+            m_layout.clear();
+            m_ranks.clear();
+            m_indexed = false;
+        }
+
+        [[nodiscard]] bool has_index() const noexcept {
+            return m_indexed;
+        }
+
+
+        //* Modifiers *//
+
+        void clear() noexcept {
+            drop_index();
+            m_values.clear();
+        }
+
+        iterator erase(const_iterator pos) {
+            drop_index();
+            return begin() + (m_values.erase(pos) - m_values.begin());
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            drop_index();
+            return begin() + (m_values.erase(first, last) - m_values.begin());
+        }
+
+        size_type erase(const Key&);
+
+
+        //*** Non-Member Functions ***//
+
+        friend bool operator==(const flat_tree &lhs, const flat_tree &rhs) {
+            return lhs.m_values == rhs.m_values;
+        }
+
+        friend bool operator!=(const flat_tree &lhs, const flat_tree &rhs) {
+            return !(lhs == rhs);
+        }
+
+
+    protected:
+        flat_tree(const Compare &compare, allocator_type allocator)
+            : m_values(allocator)
+            , m_layout(allocator)
+            , m_ranks(allocator)
+            , m_compare(compare)
+            , m_indexed(false)
+        {}
+
+        template <class... Args>
+        std::pair<iterator, bool> insert_unique(const Key&, Args&&...);
+
+        template <class InputIt>
+        void insert_range(InputIt, InputIt);
+
+        size_type lower_bound_index(const Key&) const;
+
+
+    private:
+
+        //*** Members ***//
+
+        // Descendants this many times deeper in the Eytzinger layout are prefetched (four levels)
+        static constexpr size_type prefetch_stride = 16;
+
+        list<Value> m_values;
+        list<Key> m_layout;             // Keys in Eytzinger order, when indexed
+        list<size_type> m_ranks;        // Position in m_values of each key of m_layout
+        Compare m_compare;
+        bool m_indexed;
+
+
+        //*** Functions ***//
+
+        const Key& key_of(const Value &value) const noexcept {
+            return KeyOf()(value);
+        }
+
+        size_type binary_lower_bound(const Key&) const;
+        size_type eytzinger_lower_bound(const Key&) const;
+        void assign_ranks(const size_type, size_type&) noexcept;
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Protected ***//
+
+    /**
+     * @brief Inserts the value constructed from args unless key is present, in which case
+     * nothing is constructed.
+     */
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    template <class... Args>
+    std::pair<typename flat_tree<Value, Key, KeyOf, Compare>::iterator, bool>
+    flat_tree<Value, Key, KeyOf, Compare>::insert_unique(const Key &key, Args &&...args) {
+        auto pos = lower_bound_index(key);
+        if (pos < m_values.size() && !m_compare(key, key_of(m_values[pos])))
+            return { begin() + pos, false };
+
+        drop_index();
+        m_values.emplace(m_values.cbegin() + pos, std::forward<Args>(args)...);
+        return { begin() + pos, true };
+    }
+
+    /**
+     * @brief Bulk insertion: appends the range, sorts it on its own and merges it into the
+     * existing values, then removes duplicates, for O(n + k log k) overall. Of equivalent
+     * values, the one already present, or else the first in the range, is kept.
+     */
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    template <class InputIt>
+    void flat_tree<Value, Key, KeyOf, Compare>::insert_range(InputIt first, InputIt last) {
+        auto less = [this](const Value &lhs, const Value &rhs) { return m_compare(key_of(lhs), key_of(rhs)); };
+        auto equivalent = [this](const Value &lhs, const Value &rhs) { return !m_compare(key_of(lhs), key_of(rhs)); };
+
+        drop_index();
+        auto old_size = static_cast<difference_type>(m_values.size());
+        m_values.insert(m_values.cend(), first, last);
+
+        auto middle = m_values.begin() + old_size;
+        std::stable_sort(middle, m_values.end(), less);
+        std::inplace_merge(m_values.begin(), middle, m_values.end(), less);
+        m_values.erase(std::unique(m_values.begin(), m_values.end(), equivalent), m_values.end());
+    }
+
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    typename flat_tree<Value, Key, KeyOf, Compare>::size_type flat_tree<Value, Key, KeyOf, Compare>::lower_bound_index(const Key &key) const {
+        return m_indexed ? eytzinger_lower_bound(key) : binary_lower_bound(key);
+    }
+
+
+    //*** Private ***//
+
+    /**
+     * @brief Binary search whose only branch is the loop condition, which depends on the size
+     * alone: each step halves the range and picks its upper half with a conditional move.
+     */
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    typename flat_tree<Value, Key, KeyOf, Compare>::size_type flat_tree<Value, Key, KeyOf, Compare>::binary_lower_bound(const Key &key) const {
+        auto n = m_values.size();
+        if (n == 0)
+            return 0;
+
+        auto data = m_values.data();
+        auto base = data;
+        while (n > 1) {
+            auto half = n / 2;
+            base = m_compare(key_of(base[half]), key) ? base + half : base;
+            n -= half;
+        }
+
+        return static_cast<size_type>(base - data) + m_compare(key_of(*base), key);
+    }
+
+    /**
+     * @brief Descends the Eytzinger layout from the root (position 1, children 2j and 2j + 1),
+     * going right past every key that compares less. The lower bound is the last node where the
+     * search went left, which is recovered by stripping the trailing right turns and that left
+     * turn from the final position.
+     */
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    typename flat_tree<Value, Key, KeyOf, Compare>::size_type flat_tree<Value, Key, KeyOf, Compare>::eytzinger_lower_bound(const Key &key) const {
+        auto n = m_layout.size();
+        auto layout = m_layout.data();
+
+        size_type j = 1;
+        while (j <= n) {
+            if (j * prefetch_stride <= n)
+                prefetch(layout + j * prefetch_stride - 1);
+            j = 2 * j + m_compare(layout[j - 1], key);
+        }
+
+        j >>= trailing_ones(j) + 1;
+        return j ? m_ranks[j - 1] : m_values.size();
+    }
+
+    // In-order walk of the implicit tree, handing out sorted positions
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    void flat_tree<Value, Key, KeyOf, Compare>::assign_ranks(const size_type j, size_type &next) noexcept {
+        if (j > m_ranks.size())
+            return;
+
+        assign_ranks(2 * j, next);
+        m_ranks[j - 1] = next++;
+        assign_ranks(2 * j + 1, next);
+    }
+
+
+    //*** Public ***//
+
+    //* Lookup *//
+
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    typename flat_tree<Value, Key, KeyOf, Compare>::iterator flat_tree<Value, Key, KeyOf, Compare>::upper_bound(const Key &key) {
+        auto it = lower_bound(key);
+        return it != end() && !m_compare(key, key_of(*it)) ? std::next(it) : it;
+    }
+
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    typename flat_tree<Value, Key, KeyOf, Compare>::const_iterator flat_tree<Value, Key, KeyOf, Compare>::upper_bound(const Key &key) const {
+        auto it = lower_bound(key);
+        return it != end() && !m_compare(key, key_of(*it)) ? std::next(it) : it;
+    }
+
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    typename flat_tree<Value, Key, KeyOf, Compare>::iterator flat_tree<Value, Key, KeyOf, Compare>::find(const Key &key) {
+        auto it = lower_bound(key);
+        return it != end() && !m_compare(key, key_of(*it)) ? it : end();
+    }
+
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    typename flat_tree<Value, Key, KeyOf, Compare>::const_iterator flat_tree<Value, Key, KeyOf, Compare>::find(const Key &key) const {
+        auto it = lower_bound(key);
+        return it != end() && !m_compare(key, key_of(*it)) ? it : end();
+    }
+
+
+    //* Index *//
+
+    /**
+     * @brief Builds the Eytzinger index over the current values, in O(n).
+     */
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    void flat_tree<Value, Key, KeyOf, Compare>::build_index() {
+        drop_index();
+
+        auto n = m_values.size();
+        m_ranks.resize(n);
+        size_type next = 0;
+        assign_ranks(1, next);
+
+        m_layout.reserve(n);
+        for (auto rank : m_ranks)
+            m_layout.push_back(key_of(m_values[rank]));
+
+        m_indexed = true;
+    }
+
+
+    //* Modifiers *//
+
+    template <typename Value, typename Key, class KeyOf, class Compare>
+    typename flat_tree<Value, Key, KeyOf, Compare>::size_type flat_tree<Value, Key, KeyOf, Compare>::erase(const Key &key) {
+        auto it = find(key);
+        if (it == end())
+            return 0;
+
+        erase(it);
+        return 1;
+    }
+
+}   // namespace dsl::details
+
+
+#endif // DSL_FLAT_TREE_H
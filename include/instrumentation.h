@@ -0,0 +1,161 @@
+#ifndef DSL_INSTRUMENTATION_H
+#define DSL_INSTRUMENTATION_H
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+
+namespace dsl {
+
+    /**
+     * @brief Container-internal events that can be recorded by an instrumentation policy.
+     */
+    enum class container_event : std::uint8_t {
+        reallocation,         // count: bytes moved to the new buffer, position: new capacity
+        node_allocation,      // count: bytes allocated for the node
+        node_deallocation,    // count: bytes returned for the node
+        insertion,            // count: size after the insertion, position: index of the first new element
+        traversal             // count: nodes walked by an internal traversal
+    };
+
+    /**
+     * @brief Position reported for an insertion into the middle of a linked list, whose index
+     * is not known without a walk.
+     */
+    inline constexpr std::size_t unknown_position = std::numeric_limits<std::size_t>::max();
+
+    struct event_record {
+        container_event kind;
+        const void *container;
+        std::size_t count;
+        std::size_t position;
+    };
+
+
+    /**
+     * @brief Compile-time instrumentation policy of a container type. The primary template is
+     * disabled, and the containers test enabled with if constexpr, so that an uninstrumented
+     * container carries no code or state for it. Instrumentation is opted into per container type
+     * by specializing this template, typically by deriving from one of the policies below:
+     *
+     *     template <>
+     *     struct dsl::instrumentation_policy<dsl::list<order>> : dsl::thread_counters_policy {};
+     *
+     * The specialization must be visible before the container's members are instantiated.
+     * record must not throw, as it is called from noexcept members.
+     *
+     * @tparam Container
+     */
+    template <class Container>
+    struct instrumentation_policy {
+        static constexpr bool enabled = false;
+
+        static void record(const event_record&) noexcept {}
+    };
+
+
+    /**
+     * @brief Running totals of the events recorded on a thread.
+     */
+    struct event_counters {
+        std::uint64_t reallocations = 0;
+        std::uint64_t bytes_moved = 0;
+        std::uint64_t node_allocations = 0;
+        std::uint64_t node_deallocations = 0;
+        std::uint64_t insertions = 0;
+        std::uint64_t front_insertions = 0;
+        std::uint64_t back_insertions = 0;
+        std::uint64_t longest_traversal = 0;
+    };
+
+    /**
+     * @brief Policy accumulating events into counters local to the recording thread, so that
+     * recording needs no synchronization. Every container type using this policy shares the counters.
+     */
+    struct thread_counters_policy {
+        static constexpr bool enabled = true;
+
+        static event_counters& counters() noexcept {
+            thread_local event_counters local;
+            return local;
+        }
+
+        static void reset() noexcept {
+            counters() = event_counters();
+        }
+
+        static void record(const event_record &event) noexcept {
+            auto &local = counters();
+            switch (event.kind) {
+                case container_event::reallocation:
+                    ++local.reallocations;
+                    local.bytes_moved += event.count;
+                    break;
+                case container_event::node_allocation:
+                    ++local.node_allocations;
+                    break;
+                case container_event::node_deallocation:
+                    ++local.node_deallocations;
+                    break;
+                case container_event::insertion:
+                    ++local.insertions;
+                    if (event.position == 0)
+                        ++local.front_insertions;
+                    else if (event.position + 1 == event.count)
+                        ++local.back_insertions;
+                    break;
+                case container_event::traversal:
+                    local.longest_traversal = std::max<std::uint64_t>(local.longest_traversal, event.count);
+                    break;
+            }
+        }
+    };
+
+    /**
+     * @brief Policy forwarding every event to a process-wide callback, which may be swapped at any
+     * time from any thread. The callback runs on the thread that triggered the event.
+     */
+    struct callback_policy {
+        using callback_type = void (*)(const event_record&) noexcept;
+
+        static constexpr bool enabled = true;
+
+        static void set_callback(const callback_type callback) noexcept {
+            slot().store(callback, std::memory_order_release);
+        }
+
+        static void record(const event_record &event) noexcept {
+            if (auto callback = slot().load(std::memory_order_acquire))
+                callback(event);
+        }
+
+    private:
+        static std::atomic<callback_type>& slot() noexcept {
+            static std::atomic<callback_type> callback{ nullptr };
+            return callback;
+        }
+    };
+
+
+    namespace details {
+
+        /**
+         * @brief Hands an event to the instrumentation policy of the container type, if it is enabled.
+         */
+        template <class Container>
+        inline void record_event(const Container *container, const container_event kind,
+                                 const std::size_t count, const std::size_t position = unknown_position) noexcept {
+            if constexpr (instrumentation_policy<Container>::enabled)
+                instrumentation_policy<Container>::record(event_record{ kind, container, count, position });
+        }
+
+    }   // namespace details
+
+}   // namespace dsl
+
+
+#endif // DSL_INSTRUMENTATION_H
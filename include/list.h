@@ -2,21 +2,26 @@
 #define DSL_LIST_H
 
 
+#include "instrumentation.h"
 #include "list_base.h"
 
 #include <algorithm>
+#include <cstring>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
 #include <memory_resource>
 #include <stdexcept>
+#include <type_traits>
 
 
 namespace dsl {
 
+    template <typename Tp, class Allocator = std::pmr::polymorphic_allocator<std::byte>> class list;
+
     namespace details {
 
-        static const std::size_t growth_multiplier = 1.5;
+        struct snapshot_access;
 
         /**
          * @brief Iterator with const pointer and reference types.
@@ -41,81 +46,97 @@ namespace dsl {
 
             //*** Member Functions ***//
 
-            list_const_iterator() noexcept 
+            constexpr list_const_iterator() noexcept 
                 : m_ptr(nullptr) {}
 
-            list_const_iterator(const pointer ptr) noexcept 
-                : m_ptr(const_cast<pointer>(ptr)) {}
+            constexpr list_const_iterator(const value_type *ptr) noexcept 
+                : m_ptr(const_cast<value_type*>(ptr)) {}
 
-            [[nodiscard]] reference operator*() const noexcept { 
+            [[nodiscard]] constexpr reference operator*() const noexcept { 
                 return *m_ptr;
             }
 
-            [[nodiscard]] pointer operator->() const noexcept {
+            [[nodiscard]] constexpr pointer operator->() const noexcept {
                 return m_ptr;
             }
 
-            list_const_iterator& operator++() noexcept {
+            constexpr list_const_iterator& operator++() noexcept {
                 m_ptr++;
                 return *this;
             }
 
-            list_const_iterator operator++(int) noexcept {
+            constexpr list_const_iterator operator++(int) noexcept {
                 list_const_iterator it(*this);
                 ++(*this);
                 return it;
             }
 
-            list_const_iterator& operator--() noexcept {
+            constexpr list_const_iterator& operator--() noexcept {
                 m_ptr--;
                 return *this;
             }
 
-            list_const_iterator operator--(int) noexcept {
+            constexpr list_const_iterator operator--(int) noexcept {
                 list_const_iterator it(*this);
                 --(*this);
                 return it;
             }
 
-            list_const_iterator& operator+=(const difference_type offset) noexcept {
+            constexpr list_const_iterator& operator+=(const difference_type offset) noexcept {
                 m_ptr += offset;
                 return *this;
             }
 
-            [[nodiscard]] list_const_iterator operator+(const difference_type offset) const noexcept {
+            [[nodiscard]] constexpr list_const_iterator operator+(const difference_type offset) const noexcept {
                 list_const_iterator it(*this);
                 it += offset;
                 return it;
             }
 
-            list_const_iterator& operator-=(const difference_type offset) noexcept {
+            constexpr list_const_iterator& operator-=(const difference_type offset) noexcept {
                 return *this += -offset;
             }
 
-            [[nodiscard]] list_const_iterator operator-(const difference_type offset) const noexcept {
+            [[nodiscard]] constexpr list_const_iterator operator-(const difference_type offset) const noexcept {
                 list_const_iterator it(*this);
                 it -= offset;
                 return it;
             }
 
-            [[nodiscard]] difference_type operator-(const list_const_iterator &other) const noexcept {
+            [[nodiscard]] constexpr difference_type operator-(const list_const_iterator &other) const noexcept {
                 return m_ptr - other.m_ptr;
             }
 
-            [[nodiscard]] reference operator[](const difference_type offset) const noexcept {
+            [[nodiscard]] constexpr reference operator[](const difference_type offset) const noexcept {
                 return *(*this + offset);
             }
 
-            bool operator==(const list_const_iterator &other) const noexcept {
+            constexpr bool operator==(const list_const_iterator &other) const noexcept {
                 return m_ptr == other.m_ptr;
             }
 
-            bool operator!=(const list_const_iterator &other) const noexcept {
+            constexpr bool operator!=(const list_const_iterator &other) const noexcept {
                 return !operator==(other);
             }
 
+            constexpr bool operator<(const list_const_iterator &other) const noexcept {
+                return m_ptr < other.m_ptr;
+            }
+
+            constexpr bool operator>(const list_const_iterator &other) const noexcept {
+                return other < *this;
+            }
+
+            constexpr bool operator<=(const list_const_iterator &other) const noexcept {
+                return !(other < *this);
+            }
+
+            constexpr bool operator>=(const list_const_iterator &other) const noexcept {
+                return !(*this < other);
+            }
+
         protected:
-            pointer m_ptr;
+            value_type *m_ptr;
         };
 
 
@@ -142,59 +163,59 @@ namespace dsl {
 
             //*** Member Functions ***//
 
-            list_iterator() noexcept 
+            constexpr list_iterator() noexcept 
                 : list_const_iterator<Tp>() {}
 
-            list_iterator(const pointer ptr) noexcept 
+            constexpr list_iterator(const pointer ptr) noexcept 
                 : list_const_iterator<Tp>(ptr) {}
 
-            [[nodiscard]] reference operator*() const noexcept { 
+            [[nodiscard]] constexpr reference operator*() const noexcept { 
                 return *this->m_ptr;
             }
 
-            [[nodiscard]] pointer operator->() const noexcept {
+            [[nodiscard]] constexpr pointer operator->() const noexcept {
                 return this->m_ptr;
             }
 
-            list_iterator& operator++() noexcept {
+            constexpr list_iterator& operator++() noexcept {
                 base_t::operator++();
                 return *this;
             }
 
-            list_iterator operator++(int) noexcept {
+            constexpr list_iterator operator++(int) noexcept {
                 list_iterator it(*this);
                 ++(*this);
                 return it;
             }
 
-            list_iterator& operator--() noexcept {
+            constexpr list_iterator& operator--() noexcept {
                 base_t::operator--();
                 return *this;
             }
 
-            list_iterator operator--(int) noexcept {
+            constexpr list_iterator operator--(int) noexcept {
                 list_iterator it(*this);
                 --(*this);
                 return it;
             }
 
-            list_iterator& operator+=(const difference_type offset) noexcept {
+            constexpr list_iterator& operator+=(const difference_type offset) noexcept {
                 base_t::operator+=(offset);
                 return *this;
             }
 
-            [[nodiscard]] list_iterator operator+(const difference_type offset) const noexcept {
+            [[nodiscard]] constexpr list_iterator operator+(const difference_type offset) const noexcept {
                 list_iterator it(*this);
                 it += offset;
                 return it;
             }
 
-            list_iterator& operator-=(const difference_type offset) noexcept {
+            constexpr list_iterator& operator-=(const difference_type offset) noexcept {
                 base_t::operator-=(offset);
                 return *this;
             }
 
-            [[nodiscard]] list_iterator operator-(const difference_type offset) const noexcept {
+            [[nodiscard]] constexpr list_iterator operator-(const difference_type offset) const noexcept {
                 list_iterator it(*this);
                 it -= offset;
                 return it;
@@ -202,35 +223,53 @@ namespace dsl {
 
             using base_t::operator-;
 
-            [[nodiscard]] reference operator[](const difference_type offset) const noexcept {
-                return const_cast<reference>(base_t::operator[](offset));
+            [[nodiscard]] constexpr reference operator[](const difference_type offset) const noexcept {
+                return *(*this + offset);
             }
         };
 
+
+        template <typename Tp>
+        [[nodiscard]] constexpr list_const_iterator<Tp> operator+(const typename list_const_iterator<Tp>::difference_type offset, 
+                                                                  const list_const_iterator<Tp> &it) noexcept {
+            return it + offset;
+        }
+
+        template <typename Tp>
+        [[nodiscard]] constexpr list_iterator<Tp> operator+(const typename list_iterator<Tp>::difference_type offset, 
+                                                            const list_iterator<Tp> &it) noexcept {
+            return it + offset;
+        }
+
     }   // namespace details
 
 
     /**
      * @brief Array-based list-type representing a vector-like container.
      * 
+     * Allocator may be any allocator type with raw pointers; it is rebound to Tp for the buffer
+     * and used to construct elements, so std::pmr allocators still apply uses-allocator construction.
+     * Copy, move and swap follow the allocator's propagation traits.
+     * 
      * @tparam Tp 
+     * @tparam Allocator Defaults to std::pmr::polymorphic_allocator<std::byte>
      */
-    template <typename Tp>
-    class list : public details::list_base<Tp> {
+    template <typename Tp, class Allocator>
+    class list : public details::list_base<list<Tp, Allocator>, Tp, Allocator> {
     public:
 
         //*** Member Types ***//
 
-        using value_type = typename details::list_base<Tp>::value_type;
-        using size_type = typename details::list_base<Tp>::size_type;
-        using difference_type = typename details::list_base<Tp>::difference_type;
+        using value_type = typename details::list_base<list<Tp, Allocator>, Tp, Allocator>::value_type;
+        using size_type = typename details::list_base<list<Tp, Allocator>, Tp, Allocator>::size_type;
+        using difference_type = typename details::list_base<list<Tp, Allocator>, Tp, Allocator>::difference_type;
 
-        using reference = typename details::list_base<Tp>::reference;
-        using const_reference = typename details::list_base<Tp>::const_reference;
+        using reference = typename details::list_base<list<Tp, Allocator>, Tp, Allocator>::reference;
+        using const_reference = typename details::list_base<list<Tp, Allocator>, Tp, Allocator>::const_reference;
 
-        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
-        using pointer = std::allocator_traits<allocator_type>::pointer;
-        using const_pointer = std::allocator_traits<allocator_type>::const_pointer;
+        using allocator_type = Allocator;
+        using pointer = typename std::allocator_traits<allocator_type>::pointer;
+        using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
 
         using iterator = typename details::list_iterator<Tp>;
         using const_iterator = typename details::list_const_iterator<Tp>;
@@ -243,10 +282,9 @@ namespace dsl {
         //* Constructors *//
 
         explicit list(allocator_type allocator = {})
-            : details::list_base<Tp>()
-            , m_allocator(allocator)
-            , m_data(nullptr) 
+            : details::list_base<list<Tp, Allocator>, Tp, Allocator>(allocator)
             , m_capacity(0)
+            , m_data(nullptr) 
         {}
 
         list(const size_type count, 
@@ -257,27 +295,27 @@ namespace dsl {
 
         explicit list(const size_type count, 
                       allocator_type allocator = {})
-            : list(count, Tp(), allocator)
-        {}
+            : list(allocator)
+        { resize(count); }
 
-        template <class InputIt>
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
         list(InputIt first, InputIt last,
-             allocator_type allocator)
+             allocator_type allocator = {})
             : list(allocator)
-        { insert(begin(), first, last); }
+        { insert(end(), first, last); }
 
         list(std::initializer_list<Tp> init, 
              allocator_type allocator = {})
-            : list(init.first(), init.last(), allocator)
+            : list(init.begin(), init.end(), allocator)
         {}
 
 
         //* Copy Constructors *//
 
         list(const list &other, 
-             allocator_type allocator = {})
-            : list(other.size(), allocator) 
-        { operator=(other); }
+             allocator_type allocator)
+            : list(allocator) 
+        { try_copy(other); }
 
         list(const list &other) 
             : list(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator()))
@@ -287,19 +325,19 @@ namespace dsl {
         //* Move Construtors *//
 
         list(list &&other, 
-             allocator_type allocator = {})
-            : list(other.size(), allocator) 
+             allocator_type allocator)
+            : list(allocator) 
         { operator=(std::move(other)); }
 
-        list(list &&other) 
-            : list(other, other.get_allocator())
-        {}
+        list(list &&other) noexcept
+            : list(other.get_allocator())
+        { try_move(std::move(other)); }
 
 
         //* Destructor *//
         ~list() {
-            erase(begin(), end());
-            m_data = nullptr;
+            clear();
+            deallocate();
         }
 
 
@@ -313,7 +351,7 @@ namespace dsl {
 
         void assign(const size_type, const Tp&);
         
-        template <class InputIt>
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
         void assign(InputIt, InputIt);
 
         void assign(std::initializer_list<Tp>);
@@ -343,11 +381,11 @@ namespace dsl {
         }
 
         reference back() {
-            return m_data[this->m_size];
+            return m_data[this->m_size - 1];
         }
 
         const_reference back() const {
-            return m_data[this->m_size];
+            return m_data[this->m_size - 1];
         }
 
         Tp* data() noexcept {
@@ -362,27 +400,27 @@ namespace dsl {
         //* Iterators *//
 
         iterator begin() noexcept { 
-            return iterator(&m_data[0]); 
+            return iterator(m_data); 
         }
 
         const_iterator begin() const noexcept { 
-            return const_iterator(&m_data[0]); 
+            return const_iterator(m_data); 
         }
 
         const_iterator cbegin() const noexcept { 
-            return const_iterator(&m_data[0]); 
+            return const_iterator(m_data); 
         }
 
         iterator end() noexcept { 
-            return iterator(&m_data[this->m_size]); 
+            return iterator(m_data + this->m_size); 
         }
 
         const_iterator end() const noexcept { 
-            return const_iterator(&m_data[this->m_size]); 
+            return const_iterator(m_data + this->m_size); 
         }
 
         const_iterator cend() const noexcept { 
-            return const_iterator(&m_data[this->m_size]);
+            return const_iterator(m_data + this->m_size);
         }
 
         reverse_iterator rbegin() noexcept { 
@@ -425,7 +463,7 @@ namespace dsl {
         iterator insert(const_iterator, Tp&&);
         iterator insert(const_iterator, size_type, const Tp&);
         
-        template <class InputIt>
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
         iterator insert(const_iterator, InputIt, InputIt);
 
         iterator insert(const_iterator, std::initializer_list<Tp>);
@@ -453,11 +491,23 @@ namespace dsl {
 
     private:
 
+        friend struct details::snapshot_access;
+
+        //*** Using Directives ***//
+
+        using alloc_traits = std::allocator_traits<allocator_type>;
+        using data_allocator_type = typename alloc_traits::template rebind_alloc<Tp>;
+        using data_traits = std::allocator_traits<data_allocator_type>;
+
+        static_assert(std::is_same_v<typename data_traits::pointer, Tp*>, "dsl::list requires an allocator with raw pointers.");
+
+
         //*** Members ***//
 
-        allocator_type m_allocator;
-        Tp *m_data;
+        // The allocator is held by the base, ahead of the size, so that a compact header packs
+        // the capacity next to the size
         size_type m_capacity;
+        Tp *m_data;
 
 
         //*** Functions ***//
@@ -469,8 +519,16 @@ namespace dsl {
         void resize_erase(const size_type);
         void resize_emplace(const size_type, const Tp&);    
 
-        size_type compute_growth(const size_type) const noexcept;
+        Tp* allocate(const size_type);
+        void deallocate(Tp*, const size_type) noexcept;
+        void deallocate() noexcept;
+        void relocate(Tp*, const size_type, Tp*) noexcept;
+
+        size_type compute_growth(const size_type) const;
         void reallocate_exactly(const size_type);    
+
+        template <class... Args>
+        void reallocate_emplace(const size_type, Args&&...);
     };
 
 
@@ -479,78 +537,166 @@ namespace dsl {
 
     //*** Private ***//
 
-    template <typename Tp>
-    void list<Tp>::check_bounds(const size_type pos) const {
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::check_bounds(const size_type pos) const {
         if (pos >= this->m_size) 
             throw std::out_of_range("Index out of bounds.");
     }
 
-    template <typename Tp>
-    void list<Tp>::try_copy(const list &other) {
-        erase(begin(), end());
-        m_capacity = other.m_capacity;
-        m_data = static_cast<Tp*>(m_allocator.resource()->allocate(sizeof(Tp) * m_capacity, alignof(Tp)));
-        std::copy(other.begin(), other.end(), m_data);
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::try_copy(const list &other) {
+        clear();
+        if (other.m_size > m_capacity) 
+            reallocate_exactly(other.m_size);
+
+        for (const Tp &value : other) {
+            alloc_traits::construct(this->allocator_ref(), m_data + this->m_size, value);
+            ++this->m_size;
+        }
     }
 
-    template <typename Tp>
-    void list<Tp>::try_move(list &&other) {
-        erase(begin(), end());
-        m_capacity = other.m_capacity;
-        m_data = static_cast<Tp*>(m_allocator.resource()->allocate(sizeof(Tp) * m_capacity, alignof(Tp)));
-        std::move(other.begin(), other.end(), m_data);
-        other.clear();
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::try_move(list &&other) {
+        clear();
+        deallocate();
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            this->replace_allocator(other.allocator_ref());
+
+        using std::swap;
+        swap(this->m_size, other.m_size);
+        swap(m_capacity, other.m_capacity);
+        swap(m_data, other.m_data);
     }
 
-    template <typename Tp>
-    void list<Tp>::resize_erase(const size_type count) {
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::resize_erase(const size_type count) {
         erase(begin() + count, end());
     }
 
-    template <typename Tp>
-    void list<Tp>::resize_emplace(const size_type count, const Tp &value) {
-        for (auto i = 0; i < count; ++i) 
-            push_back(value);
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::resize_emplace(const size_type count, const Tp &value) {
+        insert(end(), count - this->m_size, value);
     }
 
-    template <typename Tp>
-    typename list<Tp>::size_type list<Tp>::compute_growth(const size_type new_size) const noexcept {
-        return (this->max_size() - (m_capacity / 2) || m_capacity * details::growth_multiplier < new_size) ? new_size : m_capacity * details::growth_multiplier;
+    template <typename Tp, class Allocator>
+    Tp* list<Tp, Allocator>::allocate(const size_type count) {
+        data_allocator_type allocator(this->allocator_ref());
+        return data_traits::allocate(allocator, count);
     }
 
-    template <typename Tp>
-    void list<Tp>::reallocate_exactly(const size_type min_size) {
-        size_type new_cap = compute_growth(min_size);
-        auto data = static_cast<Tp*>(m_allocator.resource()->allocate(sizeof(Tp) * new_cap, alignof(Tp)));
-        
-        for (auto i = 0; i < this->m_size; ++i) {
-            m_allocator.construct(std::addressof(data[i]), std::move(m_data[i]));
-            std::allocator_traits<allocator_type>::destroy(m_allocator, std::addressof(m_data[i]));
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::deallocate(Tp *data, const size_type count) noexcept {
+        data_allocator_type allocator(this->allocator_ref());
+        data_traits::deallocate(allocator, data, count);
+    }
+
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::deallocate() noexcept {
+        if (m_data) 
+            deallocate(m_data, m_capacity);
+        m_data = nullptr;
+        m_capacity = 0;
+    }
+
+    /**
+     * @brief Moves count elements from src into the uninitialized storage at dest and destroys 
+     * the originals. Trivially copyable types are relocated with a single memmove.
+     */
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::relocate(Tp *src, const size_type count, Tp *dest) noexcept {
+        if constexpr (std::is_trivially_copyable_v<Tp>) {
+            if (count) 
+                std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), sizeof(Tp) * count);
+        } else {
+            for (size_type i = 0; i < count; ++i) {
+                alloc_traits::construct(this->allocator_ref(), dest + i, std::move(src[i]));
+                alloc_traits::destroy(this->allocator_ref(), src + i);
+            }
         }
+    }
+
+    /**
+     * @brief Grows the capacity geometrically by a factor of 1.5, or to new_size if that is larger.
+     */
+    template <typename Tp, class Allocator>
+    typename list<Tp, Allocator>::size_type list<Tp, Allocator>::compute_growth(const size_type new_size) const {
+        if (new_size > this->max_size()) 
+            throw std::length_error("New size cannot be larger than the maximum supported list size.");
+
+        if (m_capacity > this->max_size() - m_capacity / 2) 
+            return new_size;
 
-        m_allocator.resource()->deallocate(m_data, sizeof(Tp) * m_capacity, alignof(Tp));
+        size_type geometric = m_capacity + m_capacity / 2;
+        return geometric < new_size ? new_size : geometric;
+    }
+
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::reallocate_exactly(const size_type new_cap) {
+        auto data = allocate(new_cap);
+        relocate(m_data, this->m_size, data);
+        details::record_event(this, container_event::reallocation, sizeof(Tp) * this->m_size, new_cap);
+
+        deallocate();
         m_data = data;
         m_capacity = new_cap;
     }
 
+    /**
+     * @brief Emplaces a value at index into a freshly grown buffer. The new element is constructed 
+     * before the existing elements are relocated, since args may refer to one of them.
+     */
+    template <typename Tp, class Allocator>
+    template <class... Args>
+    void list<Tp, Allocator>::reallocate_emplace(const size_type index, Args &&...args) {
+        size_type new_cap = compute_growth(this->m_size + 1);
+        auto data = allocate(new_cap);
+
+        try {
+            alloc_traits::construct(this->allocator_ref(), data + index, std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(data, new_cap);
+            throw;
+        }
+
+        relocate(m_data, index, data);
+        relocate(m_data + index, this->m_size - index, data + index + 1);
+        details::record_event(this, container_event::reallocation, sizeof(Tp) * this->m_size, new_cap);
+
+        deallocate();
+        m_data = data;
+        m_capacity = new_cap;
+        ++this->m_size;
+    }
+
+
     //*** Public ***//
 
     //* Assignment operator overloads *//
 
-    template <typename Tp>
-    list<Tp>& list<Tp>::operator=(const list<Tp> &other) {
-        if (this != other) 
+    template <typename Tp, class Allocator>
+    list<Tp, Allocator>& list<Tp, Allocator>::operator=(const list<Tp, Allocator> &other) {
+        if (this != &other) {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (this->allocator_ref() != other.allocator_ref()) {
+                    clear();
+                    deallocate();
+                }
+                this->replace_allocator(other.allocator_ref());
+            }
             try_copy(other);
+        }
         return *this;
     }
 
-    template <typename Tp>
-    list<Tp>& list<Tp>::operator=(list<Tp> &&other) {
-        if (this != other) {
-            if (m_allocator == other.m_allocator) 
+    template <typename Tp, class Allocator>
+    list<Tp, Allocator>& list<Tp, Allocator>::operator=(list<Tp, Allocator> &&other) {
+        if (this != &other) {
+            if (alloc_traits::propagate_on_container_move_assignment::value || this->allocator_ref() == other.allocator_ref()) {
                 try_move(std::move(other));
-            else 
-                operator=(other);   // copy assignment
+            } else {
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+            }
         }
         return *this;
     }
@@ -558,50 +704,47 @@ namespace dsl {
 
     //* Assign and allocator access *//
 
-    template <typename Tp>
-    void list<Tp>::assign(const size_type count, const Tp &value) {
-        resize(count, value);
-        for (auto it = begin(); it != end(); ++it) 
-            *it = value;
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::assign(const size_type count, const Tp &value) {
+        clear();
+        insert(end(), count, value);
     }
 
-    template <typename Tp>
-    template <class InputIt>
-    void list<Tp>::assign(InputIt first, InputIt last) {
-        resize(std::distance(first, last));
-        auto it = begin();
-        for (; first != last && it != end(); ++first) 
-            *it = *first;
+    template <typename Tp, class Allocator>
+    template <class InputIt, typename>
+    void list<Tp, Allocator>::assign(InputIt first, InputIt last) {
+        clear();
+        insert(end(), first, last);
     }
 
-    template <typename Tp>
-    void list<Tp>::assign(std::initializer_list<Tp> ilist) {
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::assign(std::initializer_list<Tp> ilist) {
         assign(ilist.begin(), ilist.end());
     }
 
-    template <typename Tp>
-    typename list<Tp>::allocator_type list<Tp>::get_allocator() const noexcept {
-        return m_allocator;
+    template <typename Tp, class Allocator>
+    typename list<Tp, Allocator>::allocator_type list<Tp, Allocator>::get_allocator() const noexcept {
+        return this->allocator_ref();
     }
 
 
     //* Element Access *//
 
-    template <typename Tp>
-    typename list<Tp>::reference list<Tp>::at(const size_type pos) {
+    template <typename Tp, class Allocator>
+    typename list<Tp, Allocator>::reference list<Tp, Allocator>::at(const size_type pos) {
         check_bounds(pos);
         return m_data[pos];
     }
 
-    template <typename Tp>
-    typename list<Tp>::const_reference list<Tp>::at(const size_type pos) const {
+    template <typename Tp, class Allocator>
+    typename list<Tp, Allocator>::const_reference list<Tp, Allocator>::at(const size_type pos) const {
         check_bounds(pos);
         return m_data[pos];
     }
 
 
-    template <typename Tp>
-    void list<Tp>::reserve(const size_type new_cap) {
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::reserve(const size_type new_cap) {
         if (new_cap > this->max_size()) 
             throw std::length_error("New capacity cannot be larger than the maximum supported list size.");
         
@@ -609,160 +752,190 @@ namespace dsl {
             reallocate_exactly(new_cap);
     }
 
-    template <typename Tp>
-    typename list<Tp>::size_type list<Tp>::capacity() const noexcept {
+    template <typename Tp, class Allocator>
+    typename list<Tp, Allocator>::size_type list<Tp, Allocator>::capacity() const noexcept {
         return m_capacity;
     }
 
-    template <typename Tp>
-    void list<Tp>::shrink_to_fit() {
-        for (auto i = this->m_size; i < m_capacity; ++i) {
-            std::allocator_traits<allocator_type>::destroy(m_allocator, std::addressof(m_data + i));
-            m_allocator.resource()->deallocate(m_data + i, sizeof(Tp), alignof(Tp));
-        }
-        m_capacity = this->m_size;
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::shrink_to_fit() {
+        if (this->m_size == m_capacity) 
+            return;
+
+        if (this->m_size == 0) 
+            deallocate();
+        else 
+            reallocate_exactly(this->m_size);
     }
 
 
     //* Modifiers *//
 
-    template <typename Tp>
-    void list<Tp>::clear() noexcept {
-        for (auto it = begin(); it != end(); ++it) {
-            --this->m_size;
-            std::allocator_traits<allocator_type>::destroy(m_allocator, std::addressof(*it));
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::clear() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<Tp>) {
+            for (size_type i = 0; i < this->m_size; ++i) 
+                alloc_traits::destroy(this->allocator_ref(), m_data + i);
         }
+        this->m_size = 0;
     }
 
-    template <typename Tp>
-    typename list<Tp>::iterator list<Tp>::insert(const_iterator pos, const Tp &value) {
+    template <typename Tp, class Allocator>
+    typename list<Tp, Allocator>::iterator list<Tp, Allocator>::insert(const_iterator pos, const Tp &value) {
         return emplace(pos, value);
     }
 
-    template <typename Tp>
-    typename list<Tp>::iterator list<Tp>::insert(const_iterator pos, Tp &&value) {
+    template <typename Tp, class Allocator>
+    typename list<Tp, Allocator>::iterator list<Tp, Allocator>::insert(const_iterator pos, Tp &&value) {
         return emplace(pos, std::move(value));
     }
 
-    template <typename Tp>
-    typename list<Tp>::iterator list<Tp>::insert(const_iterator pos, const size_type count, const Tp &value) {
+    template <typename Tp, class Allocator>
+    typename list<Tp, Allocator>::iterator list<Tp, Allocator>::insert(const_iterator pos, const size_type count, const Tp &value) {
+        auto index = pos - cbegin();
+        if (count == 0) 
+            return begin() + index;
+
+        // Copy first, as value may refer to an element that is relocated below
+        Tp copy(value);
         if (this->m_size + count > m_capacity) 
-            reallocate_exactly(m_capacity + count);
+            reallocate_exactly(compute_growth(this->m_size + count));
 
-        auto it = pos - begin();
-        std::move(it, end(), it + 1);
-        *it = std::move(value);
+        auto old_size = this->m_size;
+        for (size_type i = 0; i < count; ++i) {
+            alloc_traits::construct(this->allocator_ref(), m_data + this->m_size, copy);
+            ++this->m_size;
+        }
 
-        this->m_size += count;
-        return dynamic_cast<iterator>(it);
+        std::rotate(m_data + index, m_data + old_size, m_data + this->m_size);
+        details::record_event(this, container_event::insertion, this->m_size, index);
+        return begin() + index;
     }
 
-    template <typename Tp>
-    template <class InputIt>
-    typename list<Tp>::iterator list<Tp>::insert(const_iterator pos, InputIt first, InputIt last) {
-        auto count = std::distance(first, last);
-        if (this->m_size + count > m_capacity) 
-            reallocate_exactly(m_capacity + count);
-        
-        auto it = pos - begin();
-        std::move(it, end(), it + count);
-        std::copy(first, last, it);
+    template <typename Tp, class Allocator>
+    template <class InputIt, typename>
+    typename list<Tp, Allocator>::iterator list<Tp, Allocator>::insert(const_iterator pos, InputIt first, InputIt last) {
+        auto index = pos - cbegin();
+        auto old_size = this->m_size;
+
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<category, std::forward_iterator_tag>) {
+            auto count = static_cast<size_type>(std::distance(first, last));
+            if (this->m_size + count > m_capacity) 
+                reallocate_exactly(compute_growth(this->m_size + count));
+        }
+
+        // Appended without emplace_back, which would record each element as a back insertion
+        for (; first != last; ++first) {
+            if (this->m_size == m_capacity) 
+                reallocate_exactly(compute_growth(this->m_size + 1));
+            alloc_traits::construct(this->allocator_ref(), m_data + this->m_size, *first);
+            ++this->m_size;
+        }
 
-        this->m_size += count;
-        return dynamic_cast<iterator>(it);
+        std::rotate(m_data + index, m_data + old_size, m_data + this->m_size);
+        if (this->m_size != old_size) 
+            details::record_event(this, container_event::insertion, this->m_size, index);
+        return begin() + index;
     }
 
-    template <typename Tp>
-    typename list<Tp>::iterator list<Tp>::insert(const_iterator pos, std::initializer_list<Tp> ilist) {
+    template <typename Tp, class Allocator>
+    typename list<Tp, Allocator>::iterator list<Tp, Allocator>::insert(const_iterator pos, std::initializer_list<Tp> ilist) {
         return insert(pos, ilist.begin(), ilist.end());
     }
 
-    template <typename Tp>
+    template <typename Tp, class Allocator>
     template <class... Args>
-    typename list<Tp>::iterator list<Tp>::emplace(const_iterator pos, Args &&...args) {
-        auto index = pos - begin();
-        &m_data[index] = static_cast<Tp*>(m_allocator.resource()->allocate(sizeof(Tp), alignof(Tp)));
-        
-        try {
-            m_allocator.construct(&m_data[index], std::forward<Args>(args)...);
-        } catch (...) {
-            m_allocator.resource()->deallocate(&m_data[index], sizeof(Tp), alignof(Tp));
-            throw;
+    typename list<Tp, Allocator>::iterator list<Tp, Allocator>::emplace(const_iterator pos, Args &&...args) {
+        size_type index = pos - cbegin();
+
+        if (this->m_size == m_capacity) {
+            reallocate_emplace(index, std::forward<Args>(args)...);
+        } else if (index == this->m_size) {
+            alloc_traits::construct(this->allocator_ref(), m_data + index, std::forward<Args>(args)...);
+            ++this->m_size;
+        } else {
+            Tp value(std::forward<Args>(args)...);
+            alloc_traits::construct(this->allocator_ref(), m_data + this->m_size, std::move(m_data[this->m_size - 1]));
+            std::move_backward(m_data + index, m_data + this->m_size - 1, m_data + this->m_size);
+            m_data[index] = std::move(value);
+            ++this->m_size;
         }
 
-        ++this->m_size;
-        return dynamic_cast<iterator>(pos);
+        details::record_event(this, container_event::insertion, this->m_size, index);
+        return begin() + index;
     }
 
-    template <typename Tp>
-    typename list<Tp>::iterator list<Tp>::erase(const_iterator pos) {
-        erase(pos, std::next(pos));
+    template <typename Tp, class Allocator>
+    typename list<Tp, Allocator>::iterator list<Tp, Allocator>::erase(const_iterator pos) {
+        return erase(pos, std::next(pos));
     }
 
-    template <typename Tp>
-    typename list<Tp>::iterator list<Tp>::erase(const_iterator first, const_iterator last) {
-        while (first != last) {
-            auto elem = *first;
-            --this->m_size;
-            std::allocator_traits<allocator_type>::destroy(m_allocator, std::addressof(elem));
-            m_allocator.resource()->deallocate(std::addressof(elem), sizeof(Tp), alignof(Tp));
-            ++first;
+    template <typename Tp, class Allocator>
+    typename list<Tp, Allocator>::iterator list<Tp, Allocator>::erase(const_iterator first, const_iterator last) {
+        auto index = first - cbegin();
+        auto count = static_cast<size_type>(last - first);
+
+        if (count) {
+            std::move(m_data + index + count, m_data + this->m_size, m_data + index);
+            if constexpr (!std::is_trivially_destructible_v<Tp>) {
+                for (auto i = this->m_size - count; i < this->m_size; ++i) 
+                    alloc_traits::destroy(this->allocator_ref(), m_data + i);
+            }
+            this->m_size -= count;
         }
-        return dynamic_cast<iterator>(first);
+
+        return begin() + index;
     }
 
-    template <typename Tp>
-    void list<Tp>::push_back(const Tp &value) {
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::push_back(const Tp &value) {
         emplace_back(value);
     }
 
-    template <typename Tp>
-    void list<Tp>::push_back(Tp &&value) {
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::push_back(Tp &&value) {
         emplace_back(std::move(value));
     }
 
-    template <typename Tp>
+    template <typename Tp, class Allocator>
     template <class... Args>    
-    typename list<Tp>::reference list<Tp>::emplace_back(Args &&...args) {
-        auto it = emplace(std::prev(end()), std::forward<Args>(args)...);
+    typename list<Tp, Allocator>::reference list<Tp, Allocator>::emplace_back(Args &&...args) {
+        auto it = emplace(end(), std::forward<Args>(args)...);
         return *it;
     }
 
-    template <typename Tp>
-    void list<Tp>::pop_back() {
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::pop_back() {
         erase(std::prev(end()));
     }
 
-    template <typename Tp>
-    void list<Tp>::resize(const size_type count) {
-        resize(count, Tp());
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::resize(const size_type count) {
+        if (count < this->m_size) {
+            resize_erase(count);
+        } else if (count > this->m_size) {
+            if (count > m_capacity)
+                reallocate_exactly(compute_growth(count));
+            while (this->m_size < count) 
+                emplace_back();
+        }
     }
 
-    template <typename Tp>
-    void list<Tp>::resize(const size_type count, const Tp &value) {
-        if (this->m_size == count)
-            return;
-
-        bool size_equals_capacity = this->m_size == m_capacity;
-        bool reallocated = false;
-        
-        if (size_equals_capacity && this->m_size < count) {
-            resize_emplace(count, Tp());
-            reallocated = true;
-        } else if (!size_equals_capacity && this->m_size < count && count < m_capacity) {
-                for (auto i = this->m_size; i < this->m_size + count; ++i) 
-                    m_data[i] = value;
-        } else resize_erase(count);
-
-        if (reallocated) 
-            m_capacity = count;
-        else 
-            this->m_size = count;
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::resize(const size_type count, const Tp &value) {
+        if (count < this->m_size) 
+            resize_erase(count);
+        else if (count > this->m_size) 
+            resize_emplace(count, value);
     }
 
-    template <typename Tp>
-    void list<Tp>::swap(list &other) noexcept(std::allocator_traits<allocator_type>::propagate_on_container_swap::value || std::allocator_traits<allocator_type>::is_always_equal::value) {
-        if (m_allocator == other.m_allocator) {
+    template <typename Tp, class Allocator>
+    void list<Tp, Allocator>::swap(list &other) noexcept(std::allocator_traits<allocator_type>::propagate_on_container_swap::value || std::allocator_traits<allocator_type>::is_always_equal::value) {
+        if (alloc_traits::propagate_on_container_swap::value || this->allocator_ref() == other.allocator_ref()) {
+            if constexpr (alloc_traits::propagate_on_container_swap::value)
+                this->swap_allocator(other);
+
             using std::swap;
             swap(this->m_size, other.m_size);
             swap(m_capacity, other.m_capacity);
@@ -770,19 +943,6 @@ namespace dsl {
         }
     }
 
-
-    //*** Non-Member Function Implementations ***//
-
-    template <typename Tp>
-    bool operator==(const list<Tp> &lhs, const list<Tp> &rhs) {
-        return (lhs.size() != rhs.size()) ? false : std::equal(lhs.begin(), lhs.end(), rhs.begin());
-    }
-
-    template <typename Tp>
-    bool operator!=(const list<Tp> &lhs, const list<Tp> &rhs) {
-        return !operator==(lhs, rhs);
-    }
-
 }   // namespace dsl 
 
 
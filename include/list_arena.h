@@ -0,0 +1,686 @@
+#ifndef DSL_LIST_ARENA_H
+#define DSL_LIST_ARENA_H
+
+
+#include "list.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace dsl {
+
+    template <typename Tp> class list_arena;
+
+    namespace details {
+
+        using arena_index_t = std::uint32_t;
+
+        static constexpr arena_index_t arena_npos = std::numeric_limits<arena_index_t>::max();
+
+        // Written over the links of free slots while the arena's values are being destroyed
+        static constexpr arena_index_t arena_freed = arena_npos - 1;
+
+        /**
+         * @brief Slot in a list arena. Holds the 32-bit index of the next slot in the same list
+         * (or in the free list) followed by raw storage for the value, so that the slot itself
+         * stays trivially copyable and can be stored in a dsl::list.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        struct arena_slot {
+            arena_index_t m_next = arena_npos;
+            alignas(Tp) std::byte m_storage[sizeof(Tp)];
+
+            Tp* value() noexcept {
+                return std::launder(reinterpret_cast<Tp*>(m_storage));
+            }
+
+            const Tp* value() const noexcept {
+                return std::launder(reinterpret_cast<const Tp*>(m_storage));
+            }
+        };
+
+
+        /**
+         * @brief Iterator with const pointer and reference member types.
+         * Adheres to the named requirements of LegacyForwardIterator.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        class arena_const_iterator : public iterator_base<Tp> {
+        public:
+
+            //*** Member Types ***//
+
+            using value_type = typename iterator_base<Tp>::value_type;
+            using difference_type = typename iterator_base<Tp>::difference_type;
+
+            using iterator_category = std::forward_iterator_tag;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+
+            //*** Member Functions ***//
+
+            arena_const_iterator() noexcept
+                : m_slots(nullptr)
+                , m_index(arena_npos) {}
+
+            [[nodiscard]] pointer operator->() const noexcept {
+                return m_slots[m_index].value();
+            }
+
+            [[nodiscard]] reference operator*() const noexcept {
+                return *m_slots[m_index].value();
+            }
+
+            arena_const_iterator& operator++() noexcept {
+                m_index = m_slots[m_index].m_next;
+                return *this;
+            }
+
+            arena_const_iterator operator++(int) noexcept {
+                arena_const_iterator it(*this);
+                ++(*this);
+                return it;
+            }
+
+            bool operator==(const arena_const_iterator &other) const noexcept {
+                return m_index == other.m_index;
+            }
+
+            bool operator!=(const arena_const_iterator &other) const noexcept {
+                return !operator==(other);
+            }
+
+
+        protected:
+            friend class list_arena<Tp>;
+
+            arena_slot<Tp> *m_slots;
+            arena_index_t m_index;
+
+            // Non-public explicit constructor to enable iterator construction for derived classes and friend classes
+            arena_const_iterator(const arena_slot<Tp> *slots, const arena_index_t index) noexcept
+                : m_slots(const_cast<arena_slot<Tp>*>(slots))
+                , m_index(index) {}
+        };
+
+
+        /**
+         * @brief Iterator with non-const pointer and reference member types.
+         * Adheres to the named requirements of LegacyForwardIterator.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        class arena_iterator : public arena_const_iterator<Tp> {
+        public:
+
+            //*** Member Types ***//
+
+            using base_t = arena_const_iterator<Tp>;
+            using value_type = typename base_t::value_type;
+
+            using pointer = value_type*;
+            using reference = value_type&;
+
+
+            //*** Member Functions ***//
+
+            arena_iterator() noexcept
+                : arena_const_iterator<Tp>() {}
+
+            [[nodiscard]] pointer operator->() const noexcept {
+                return this->m_slots[this->m_index].value();
+            }
+
+            [[nodiscard]] reference operator*() const noexcept {
+                return *this->m_slots[this->m_index].value();
+            }
+
+            arena_iterator& operator++() noexcept {
+                base_t::operator++();
+                return *this;
+            }
+
+            arena_iterator operator++(int) noexcept {
+                arena_iterator it(*this);
+                ++(*this);
+                return it;
+            }
+
+
+        private:
+            friend class list_arena<Tp>;
+
+            arena_iterator(const arena_slot<Tp> *slots, const arena_index_t index) noexcept
+                : arena_const_iterator<Tp>(slots, index) {}
+        };
+
+    }   // namespace details
+
+
+    /**
+     * @brief Pool of many small singly-linked lists sharing one contiguous node array. Nodes are
+     * linked by 32-bit indices and recycled through a single free list, and each list is
+     * represented by a lightweight handle (head index and size) owned by the caller.
+     *
+     * Growing the arena invalidates all iterators and references into it, but never handles.
+     * Handles must only be used with the arena that populated them.
+     *
+     * @tparam Tp
+     */
+    template <typename Tp>
+    class list_arena {
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = Tp;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using index_type = details::arena_index_t;
+
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        using iterator = typename details::arena_iterator<Tp>;
+        using const_iterator = typename details::arena_const_iterator<Tp>;
+
+        static constexpr index_type npos = details::arena_npos;
+
+        /**
+         * @brief Handle to a single list stored in the arena.
+         */
+        class handle {
+        public:
+            handle() noexcept
+                : m_head(npos)
+                , m_size(0) {}
+
+            [[nodiscard]] bool empty() const noexcept {
+                return m_size == 0;
+            }
+
+            [[nodiscard]] index_type size() const noexcept {
+                return m_size;
+            }
+
+        private:
+            friend class list_arena<Tp>;
+
+            index_type m_head;
+            index_type m_size;
+        };
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit list_arena(allocator_type allocator = {})
+            : m_slots(allocator)
+            , m_free(npos)
+            , m_free_count(0)
+        {}
+
+
+        //* Copy Constructors *//
+
+        list_arena(const list_arena &other,
+                   allocator_type allocator);
+
+        list_arena(const list_arena &other)
+            : list_arena(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator()))
+        {}
+
+
+        //* Move Constructors *//
+
+        list_arena(list_arena &&other) noexcept
+            : list_arena(other.get_allocator())
+        { swap(other); }
+
+
+        //* Destructor *//
+        ~list_arena() {
+            destroy_values();
+        }
+
+
+        //* Assignment operator overloads *//
+
+        list_arena& operator=(const list_arena&);
+        list_arena& operator=(list_arena&&);
+
+
+        //* Allocator access *//
+
+        allocator_type get_allocator() const noexcept;
+
+
+        //* Element Access *//
+
+        reference front(const handle &h) {
+            return *m_slots[h.m_head].value();
+        }
+
+        const_reference front(const handle &h) const {
+            return *m_slots[h.m_head].value();
+        }
+
+
+        //* Iterators *//
+
+        iterator begin(const handle &h) noexcept {
+            return iterator(m_slots.data(), h.m_head);
+        }
+
+        const_iterator begin(const handle &h) const noexcept {
+            return const_iterator(m_slots.data(), h.m_head);
+        }
+
+        const_iterator cbegin(const handle &h) const noexcept {
+            return const_iterator(m_slots.data(), h.m_head);
+        }
+
+        iterator end(const handle&) noexcept {
+            return iterator(m_slots.data(), npos);
+        }
+
+        const_iterator end(const handle&) const noexcept {
+            return const_iterator(m_slots.data(), npos);
+        }
+
+        const_iterator cend(const handle&) const noexcept {
+            return const_iterator(m_slots.data(), npos);
+        }
+
+
+        //* Capacity *//
+
+        [[nodiscard]] size_type node_count() const noexcept;
+        [[nodiscard]] size_type free_count() const noexcept;
+        [[nodiscard]] size_type capacity() const noexcept;
+        [[nodiscard]] size_type max_size() const noexcept;
+
+        void reserve(const size_type);
+
+
+        //* Modifiers *//
+
+        void clear() noexcept;
+        void clear(handle&) noexcept;
+
+        template <class... Args>
+        reference emplace_front(handle&, Args&&...);
+
+        void push_front(handle&, const Tp&);
+        void push_front(handle&, Tp&&);
+
+        void pop_front(handle&);
+
+        template <class... Args>
+        iterator emplace_after(handle&, const_iterator, Args&&...);
+
+        iterator insert_after(handle&, const_iterator, const Tp&);
+        iterator insert_after(handle&, const_iterator, Tp&&);
+
+        iterator erase_after(handle&, const_iterator);
+
+        void swap(list_arena&) noexcept;
+
+
+    private:
+
+        //*** Using Directives ***//
+
+        using slot_t = typename details::arena_slot<Tp>;
+
+
+        //*** Members ***//
+
+        dsl::list<slot_t> m_slots;
+        index_type m_free;
+        index_type m_free_count;
+
+
+        //*** Functions ***//
+
+        dsl::list<bool> live_slots() const;
+        void destroy_values() noexcept;
+        void grow(const size_type);
+
+        template <class... Args>
+        index_type acquire(Args&&...);
+        void release(const index_type) noexcept;
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    /**
+     * @brief Marks every slot that currently holds a value. Only needed for element types that
+     * cannot be relocated or destroyed as raw bytes.
+     */
+    template <typename Tp>
+    dsl::list<bool> list_arena<Tp>::live_slots() const {
+        dsl::list<bool> live(m_slots.size(), true, m_slots.get_allocator());
+        for (auto index = m_free; index != npos; index = m_slots[index].m_next)
+            live[index] = false;
+        return live;
+    }
+
+    /**
+     * @brief Destroys every value without allocating, by overwriting the links of the free slots
+     * with arena_freed. The free list is lost, so callers must discard the slots afterwards.
+     */
+    template <typename Tp>
+    void list_arena<Tp>::destroy_values() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<Tp>) {
+            for (auto index = m_free; index != npos; ) {
+                auto next = m_slots[index].m_next;
+                m_slots[index].m_next = details::arena_freed;
+                index = next;
+            }
+
+            for (auto &slot : m_slots)
+                if (slot.m_next != details::arena_freed)
+                    std::destroy_at(slot.value());
+        }
+    }
+
+    /**
+     * @brief Grows the slot array to new_cap. Trivially copyable values are relocated along with their
+     * slots by the underlying list; other values are move-constructed into the new array, and the
+     * originals destroyed only once all of them have been, so that a throwing copy leaves the
+     * arena unchanged.
+     */
+    template <typename Tp>
+    void list_arena<Tp>::grow(const size_type new_cap) {
+        if constexpr (std::is_trivially_copyable_v<Tp>) {
+            m_slots.reserve(new_cap);
+        } else {
+            auto live = live_slots();
+            dsl::list<slot_t> slots(m_slots.get_allocator());
+            slots.reserve(new_cap);
+
+            for (size_type i = 0; i < m_slots.size(); ++i) {
+                auto &slot = slots.emplace_back();
+                slot.m_next = m_slots[i].m_next;
+                if (live[i]) {
+                    try {
+                        ::new (static_cast<void*>(slot.m_storage)) Tp(std::move_if_noexcept(*m_slots[i].value()));
+                    } catch (...) {
+                        for (size_type j = 0; j < i; ++j)
+                            if (live[j])
+                                std::destroy_at(slots[j].value());
+                        throw;
+                    }
+                }
+            }
+
+            for (size_type i = 0; i < m_slots.size(); ++i)
+                if (live[i])
+                    std::destroy_at(m_slots[i].value());
+
+            m_slots.swap(slots);
+        }
+    }
+
+    template <typename Tp>
+    template <class... Args>
+    typename list_arena<Tp>::index_type list_arena<Tp>::acquire(Args &&...args) {
+        if (m_free != npos) {
+            auto index = m_free;
+            ::new (static_cast<void*>(m_slots[index].m_storage)) Tp(std::forward<Args>(args)...);
+            m_free = m_slots[index].m_next;
+            --m_free_count;
+            return index;
+        }
+
+        if (m_slots.size() >= max_size())
+            throw std::length_error("List arena cannot hold more nodes than its index type can address.");
+
+        if (m_slots.size() == m_slots.capacity()) {
+            // Construct first, as args may refer to a value that is relocated by the growth
+            Tp value(std::forward<Args>(args)...);
+            grow(std::min(max_size(), std::max<size_type>(16, m_slots.size() + m_slots.size() / 2)));
+            ::new (static_cast<void*>(m_slots.emplace_back().m_storage)) Tp(std::move(value));
+        } else {
+            auto &slot = m_slots.emplace_back();
+            try {
+                ::new (static_cast<void*>(slot.m_storage)) Tp(std::forward<Args>(args)...);
+            } catch (...) {
+                m_slots.pop_back();
+                throw;
+            }
+        }
+
+        return static_cast<index_type>(m_slots.size() - 1);
+    }
+
+    template <typename Tp>
+    void list_arena<Tp>::release(const index_type index) noexcept {
+        std::destroy_at(m_slots[index].value());
+        m_slots[index].m_next = m_free;
+        m_free = index;
+        ++m_free_count;
+    }
+
+
+    //*** Public ***//
+
+    //* Copy Constructors *//
+
+    template <typename Tp>
+    list_arena<Tp>::list_arena(const list_arena &other, allocator_type allocator)
+        : list_arena(allocator) {
+        operator=(other);
+    }
+
+
+    //* Assignment Operator Overloads *//
+
+    template <typename Tp>
+    list_arena<Tp>& list_arena<Tp>::operator=(const list_arena<Tp> &other) {
+        if (this == &other)
+            return *this;
+
+        clear();
+        if constexpr (std::is_trivially_copyable_v<Tp>) {
+            m_slots = other.m_slots;
+        } else {
+            auto live = other.live_slots();
+            m_slots.reserve(other.m_slots.size());
+
+            for (size_type i = 0; i < other.m_slots.size(); ++i) {
+                auto &slot = m_slots.emplace_back();
+                slot.m_next = other.m_slots[i].m_next;
+                if (live[i]) {
+                    try {
+                        ::new (static_cast<void*>(slot.m_storage)) Tp(*other.m_slots[i].value());
+                    } catch (...) {
+                        // Leave the arena empty rather than with partially copied lists
+                        for (size_type j = 0; j < i; ++j)
+                            if (live[j])
+                                std::destroy_at(m_slots[j].value());
+                        m_slots.clear();
+                        throw;
+                    }
+                }
+            }
+        }
+
+        m_free = other.m_free;
+        m_free_count = other.m_free_count;
+        return *this;
+    }
+
+    template <typename Tp>
+    list_arena<Tp>& list_arena<Tp>::operator=(list_arena<Tp> &&other) {
+        if (this != &other) {
+            if (get_allocator() == other.get_allocator()) {
+                clear();
+                swap(other);
+            } else {
+                operator=(other);   // copy assignment
+            }
+        }
+        return *this;
+    }
+
+
+    //* Allocator access *//
+
+    template <typename Tp>
+    typename list_arena<Tp>::allocator_type list_arena<Tp>::get_allocator() const noexcept {
+        return m_slots.get_allocator();
+    }
+
+
+    //* Capacity *//
+
+    template <typename Tp>
+    typename list_arena<Tp>::size_type list_arena<Tp>::node_count() const noexcept {
+        return m_slots.size() - m_free_count;
+    }
+
+    template <typename Tp>
+    typename list_arena<Tp>::size_type list_arena<Tp>::free_count() const noexcept {
+        return m_free_count;
+    }
+
+    template <typename Tp>
+    typename list_arena<Tp>::size_type list_arena<Tp>::capacity() const noexcept {
+        return m_slots.capacity();
+    }
+
+    template <typename Tp>
+    typename list_arena<Tp>::size_type list_arena<Tp>::max_size() const noexcept {
+        // npos is reserved as the end-of-list marker, and npos - 1 as details::arena_freed
+        return npos - 1;
+    }
+
+    template <typename Tp>
+    void list_arena<Tp>::reserve(const size_type new_cap) {
+        if (new_cap > max_size())
+            throw std::length_error("New capacity cannot be larger than the maximum supported arena size.");
+
+        if (new_cap > m_slots.capacity())
+            grow(new_cap);
+    }
+
+
+    //* Modifiers *//
+
+    /**
+     * @brief Destroys every value in the arena and releases all slots for reuse. Every handle
+     * populated from this arena must be discarded or reset.
+     */
+    template <typename Tp>
+    void list_arena<Tp>::clear() noexcept {
+        destroy_values();
+        m_slots.clear();
+        m_free = npos;
+        m_free_count = 0;
+    }
+
+    template <typename Tp>
+    void list_arena<Tp>::clear(handle &h) noexcept {
+        while (!h.empty())
+            pop_front(h);
+    }
+
+    template <typename Tp>
+    template <class... Args>
+    typename list_arena<Tp>::reference list_arena<Tp>::emplace_front(handle &h, Args &&...args) {
+        auto index = acquire(std::forward<Args>(args)...);
+        m_slots[index].m_next = h.m_head;
+        h.m_head = index;
+        ++h.m_size;
+        return *m_slots[index].value();
+    }
+
+    template <typename Tp>
+    void list_arena<Tp>::push_front(handle &h, const Tp &value) {
+        emplace_front(h, value);
+    }
+
+    template <typename Tp>
+    void list_arena<Tp>::push_front(handle &h, Tp &&value) {
+        emplace_front(h, std::move(value));
+    }
+
+    template <typename Tp>
+    void list_arena<Tp>::pop_front(handle &h) {
+        auto index = h.m_head;
+        h.m_head = m_slots[index].m_next;
+        --h.m_size;
+        release(index);
+    }
+
+    template <typename Tp>
+    template <class... Args>
+    typename list_arena<Tp>::iterator list_arena<Tp>::emplace_after(handle &h, const_iterator pos, Args &&...args) {
+        // Indices, unlike iterators, survive the growth that acquire may trigger
+        auto prev = pos.m_index;
+        auto index = acquire(std::forward<Args>(args)...);
+
+        m_slots[index].m_next = m_slots[prev].m_next;
+        m_slots[prev].m_next = index;
+        ++h.m_size;
+        return iterator(m_slots.data(), index);
+    }
+
+    template <typename Tp>
+    typename list_arena<Tp>::iterator list_arena<Tp>::insert_after(handle &h, const_iterator pos, const Tp &value) {
+        return emplace_after(h, pos, value);
+    }
+
+    template <typename Tp>
+    typename list_arena<Tp>::iterator list_arena<Tp>::insert_after(handle &h, const_iterator pos, Tp &&value) {
+        return emplace_after(h, pos, std::move(value));
+    }
+
+    template <typename Tp>
+    typename list_arena<Tp>::iterator list_arena<Tp>::erase_after(handle &h, const_iterator pos) {
+        auto prev = pos.m_index;
+        auto index = m_slots[prev].m_next;
+
+        m_slots[prev].m_next = m_slots[index].m_next;
+        --h.m_size;
+        release(index);
+        return iterator(m_slots.data(), m_slots[prev].m_next);
+    }
+
+    template <typename Tp>
+    void list_arena<Tp>::swap(list_arena<Tp> &other) noexcept {
+        if (get_allocator() == other.get_allocator()) {
+            using std::swap;
+            m_slots.swap(other.m_slots);
+            swap(m_free, other.m_free);
+            swap(m_free_count, other.m_free_count);
+        }
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_LIST_ARENA_H
@@ -2,12 +2,110 @@
 #define DSL_LIST_BASE_H
 
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace dsl {
+
+    /**
+     * @brief Opts a container type into a compact header, i.e. a 32-bit size_type for the size
+     * (and capacity) fields, by specializing to std::true_type:
+     *
+     *     template <>
+     *     struct dsl::compact_header<dsl::list<int>> : std::true_type {};
+     *
+     * max_size() drops to 2^32 - 1 elements accordingly. The saving is realized where the fields
+     * can share a word: a compact list is 24 bytes rather than 32. The node-based containers
+     * follow the size with pointers, so for them the option only caps the size.
+     * The specialization must be visible before the container is instantiated.
+     *
+     * @tparam Container
+     */
+    template <class Container>
+    struct compact_header : std::false_type {};
+
+    /**
+     * @brief Marks a memory resource as an arena, i.e. one whose deallocate is a no-op and which
+     * reclaims its memory all at once on release. A resource opts in by deriving from this tag
+     * alongside std::pmr::memory_resource; std::pmr::monotonic_buffer_resource is recognized
+     * without it.
+     */
+    struct arena_resource_tag {};
+
+    /**
+     * @brief Marks an allocator type as arena-style, for allocators other than
+     * std::pmr::polymorphic_allocator, by specializing to std::true_type.
+     *
+     * @tparam Allocator
+     */
+    template <class Allocator>
+    struct is_arena_allocator : std::false_type {};
+
+}   // namespace dsl
 
 
 namespace dsl::details {
 
+    /**
+     * @brief Restricts iterator-pair overloads to types satisfying LegacyInputIterator, so that 
+     * (count, value) calls with integral arguments resolve to the fill overloads.
+     * 
+     * @tparam InputIt 
+     */
+    template <typename InputIt>
+    using require_input_iterator = std::enable_if_t<std::is_convertible_v<typename std::iterator_traits<InputIt>::iterator_category, 
+                                                                          std::input_iterator_tag>>;
+
+    /**
+     * @brief Distance past the end of a node within which its successor still counts as laid out
+     * sequentially, i.e. is likely to be fetched by the same or the adjacent cache line.
+     */
+    static constexpr std::size_t locality_window = 64;
+
+    /**
+     * @brief Checks whether the node at next directly follows the node at curr in memory.
+     * 
+     * @param node_size Size of a node in bytes
+     */
+    inline bool is_sequential(const void *curr, const void *next, const std::size_t node_size) noexcept {
+        auto first = reinterpret_cast<std::uintptr_t>(curr) + node_size;
+        auto second = reinterpret_cast<std::uintptr_t>(next);
+        return first <= second && second - first <= locality_window;
+    }
+
+    template <class Allocator>
+    struct is_polymorphic_allocator : std::false_type {};
+
+    template <typename Tp>
+    struct is_polymorphic_allocator<std::pmr::polymorphic_allocator<Tp>> : std::true_type {};
+
+    /**
+     * @brief Checks whether deallocating through allocator is a no-op, so that a container of
+     * trivially destructible elements may drop its nodes without visiting them. The check is a
+     * compile-time constant except for polymorphic allocators, whose resource is inspected.
+     */
+    template <class Allocator>
+    bool is_arena(const Allocator &allocator) noexcept {
+        if constexpr (is_arena_allocator<Allocator>::value) {
+            return true;
+        } else if constexpr (is_polymorphic_allocator<Allocator>::value) {
+            auto resource = allocator.resource();
+            return dynamic_cast<std::pmr::monotonic_buffer_resource*>(resource)
+                || dynamic_cast<arena_resource_tag*>(resource);
+        } else {
+            return false;
+        }
+    }
+
     template <typename Tp>
     struct iterator_base {
         using value_type = Tp;
@@ -15,19 +113,95 @@ namespace dsl::details {
     };
 
     /**
-     * @brief Partially specialized template class serving as the base for all linear containers. 
-     * Implements capacity-related functions and defines common member types.
-     * 
-     * @tparam Tp 
+     * @brief Holds the allocator of a container. A stateless allocator is held as an empty base,
+     * so that it takes no space in the container header; any other allocator is a member.
+     * Allocators that are not assignable (such as std::pmr::polymorphic_allocator) are replaced
+     * by destruction and reconstruction in place.
+     *
+     * @tparam Allocator void for containers that do not take an allocator
      */
-    template <typename Tp>
-    class list_base {
+    template <class Allocator, bool = std::is_empty_v<Allocator> && !std::is_final_v<Allocator>>
+    class allocator_storage : private Allocator {
+    protected:
+        explicit allocator_storage(const Allocator &allocator) noexcept
+            : Allocator(allocator) {}
+
+        Allocator& allocator_ref() noexcept {
+            return *this;
+        }
+
+        const Allocator& allocator_ref() const noexcept {
+            return *this;
+        }
+
+        void replace_allocator(const Allocator &allocator) noexcept {
+            if constexpr (std::is_copy_assignable_v<Allocator>)
+                allocator_ref() = allocator;
+        }
+
+        void swap_allocator(allocator_storage &other) noexcept {
+            using std::swap;
+            swap(allocator_ref(), other.allocator_ref());
+        }
+    };
+
+    template <class Allocator>
+    class allocator_storage<Allocator, false> {
+    protected:
+        explicit allocator_storage(const Allocator &allocator) noexcept
+            : m_allocator(allocator) {}
+
+        Allocator& allocator_ref() noexcept {
+            return m_allocator;
+        }
+
+        const Allocator& allocator_ref() const noexcept {
+            return m_allocator;
+        }
+
+        void replace_allocator(const Allocator &allocator) noexcept {
+            if constexpr (std::is_copy_assignable_v<Allocator>) {
+                m_allocator = allocator;
+            } else {
+                m_allocator.~Allocator();
+                ::new (static_cast<void*>(std::addressof(m_allocator))) Allocator(allocator);
+            }
+        }
+
+        void swap_allocator(allocator_storage &other) noexcept {
+            using std::swap;
+            swap(m_allocator, other.m_allocator);
+        }
+
+    private:
+        Allocator m_allocator;
+    };
+
+    template <>
+    class allocator_storage<void, false> {};
+
+
+    /**
+     * @brief CRTP base of all linear containers. Implements capacity-related functions,
+     * element-wise comparisons and common member types without virtual dispatch, so the
+     * containers carry no vtable pointer. The destructor is protected and non-virtual: a
+     * container must not be destroyed through a pointer to its base.
+     *
+     * The allocator, if any, is stored ahead of the size, and the base's member names hide
+     * those of a stateless allocator held as a base class.
+     *
+     * @tparam Derived
+     * @tparam Tp
+     * @tparam Allocator void for containers without an allocator template parameter
+     */
+    template <class Derived, typename Tp, class Allocator = void>
+    class list_base : protected allocator_storage<Allocator> {
     public:
 
         //*** Member Types ***//
 
         using value_type = Tp;
-        using size_type = std::size_t;
+        using size_type = std::conditional_t<compact_header<Derived>::value, std::uint32_t, std::size_t>;
         using difference_type = std::ptrdiff_t;
 
         using reference = value_type&;
@@ -36,21 +210,6 @@ namespace dsl::details {
 
         //*** Member Functions ***//
 
-        list_base()
-            : m_size(0) {}
-
-        explicit list_base(const size_type count) 
-            : m_size(count) {}
-
-        list_base(const list_base&) = default;
-        list_base(list_base&&) noexcept = default;
-        
-        list_base& operator=(const list_base&) = default;
-        list_base& operator=(list_base&&) noexcept = default;
-
-        virtual ~list_base() = default;
-
-
         //* Capacity *//
 
         [[nodiscard]] bool empty() const noexcept {
@@ -62,11 +221,59 @@ namespace dsl::details {
         }
 
         [[nodiscard]] size_type max_size() const noexcept {
-            return std::numeric_limits<difference_type>::max();
+            if constexpr (compact_header<Derived>::value)
+                return std::numeric_limits<size_type>::max();
+            else
+                return std::numeric_limits<difference_type>::max();
         }
 
-        
+
+        //*** Non-Member Functions ***//
+
+        //* Comparison *//
+
+        friend bool operator==(const Derived &lhs, const Derived &rhs) {
+            return (lhs.size() != rhs.size()) ? false : std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const Derived &lhs, const Derived &rhs) {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const Derived &lhs, const Derived &rhs) {
+            return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator>(const Derived &lhs, const Derived &rhs) {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const Derived &lhs, const Derived &rhs) {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const Derived &lhs, const Derived &rhs) {
+            return !(lhs < rhs);
+        }
+
+
     protected:
+        list_base() noexcept
+            : m_size(0) {}
+
+        template <class Alloc, typename = std::enable_if_t<std::is_same_v<Alloc, Allocator>>>
+        explicit list_base(const Alloc &allocator) noexcept
+            : allocator_storage<Allocator>(allocator)
+            , m_size(0) {}
+
+        list_base(const list_base&) = default;
+        list_base(list_base&&) noexcept = default;
+
+        list_base& operator=(const list_base&) = default;
+        list_base& operator=(list_base&&) noexcept = default;
+
+        ~list_base() = default;
+
         size_type m_size;
     };
     
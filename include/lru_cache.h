@@ -0,0 +1,898 @@
+#ifndef DSL_LRU_CACHE_H
+#define DSL_LRU_CACHE_H
+
+
+#include "doubly_linked_list.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+
+namespace dsl {
+
+    namespace details {
+
+        /**
+         * @brief Maps a hash to a home slot of an open-addressing table with 2^(64 - shift) slots.
+         * Fibonacci hashing keeps identity hashes of regularly spaced keys from clustering.
+         */
+        inline std::size_t fibonacci_slot(const std::size_t hash, const unsigned shift) noexcept {
+            return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> shift);
+        }
+
+    }   // namespace details
+
+
+    /**
+     * @brief Least-recently-used cache. Entries live in the nodes of a doubly_linked_list ordered
+     * from most to least recently used, and a hit relinks its node to the front in place, so that
+     * references to entries stay valid until they are evicted or erased. Keys are indexed by a flat
+     * open-addressing table of list iterators, probed linearly and compared on the stored hash first.
+     *
+     * Entries are evicted from the back once the cache holds more than capacity() entries, or once
+     * the combined weight of its entries, as measured by an optional weigher, exceeds byte_budget().
+     * The most recently inserted entry is never evicted, even if it alone exceeds the budget.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Hash
+     * @tparam KeyEqual
+     */
+    template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class lru_cache {
+    public:
+
+        //*** Member Types ***//
+
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<const Key, Value>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        using iterator = typename doubly_linked_list<value_type>::iterator;
+        using const_iterator = typename doubly_linked_list<value_type>::const_iterator;
+
+        // Invoked with each entry evicted to honour the capacity or byte budget, before it is destroyed
+        using eviction_callback = std::function<void(const Key&, Value&)>;
+
+        // Measures the weight of an entry counted against the byte budget
+        using weigher = std::function<size_type(const Key&, const Value&)>;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit lru_cache(const size_type capacity,
+                           allocator_type allocator = {})
+            : lru_cache(capacity, std::numeric_limits<size_type>::max(), weigher(), allocator)
+        {}
+
+        lru_cache(const size_type capacity,
+                  const size_type byte_budget,
+                  weigher weigh,
+                  allocator_type allocator = {})
+            : m_entries(allocator)
+            , m_slots(nullptr)
+            , m_slot_count(0)
+            , m_shift(std::numeric_limits<std::uint64_t>::digits)
+            , m_capacity(capacity)
+            , m_byte_budget(byte_budget)
+            , m_weight(0)
+            , m_hash()
+            , m_equal()
+            , m_weigh(std::move(weigh))
+            , m_on_evict()
+        {
+            if (capacity == 0)
+                throw std::length_error("Cache capacity must be at least one.");
+            rehash(initial_slots);
+        }
+
+
+        //* Copy Constructors *//
+
+        lru_cache(const lru_cache&) = delete;
+
+
+        //* Move Constructors *//
+
+        lru_cache(lru_cache &&other) noexcept
+            : m_entries(other.m_entries.get_allocator())
+            , m_slots(nullptr)
+            , m_slot_count(0)
+            , m_shift(std::numeric_limits<std::uint64_t>::digits)
+            , m_capacity(other.m_capacity)
+            , m_byte_budget(other.m_byte_budget)
+            , m_weight(0)
+            , m_hash(other.m_hash)
+            , m_equal(other.m_equal)
+            , m_weigh()
+            , m_on_evict()
+        { swap(other); }
+
+
+        //* Destructor *//
+        ~lru_cache() {
+            deallocate_slots();
+        }
+
+
+        //* Assignment operator overloads *//
+
+        lru_cache& operator=(const lru_cache&) = delete;
+        lru_cache& operator=(lru_cache&&);
+
+
+        //* Allocator access and configuration *//
+
+        allocator_type get_allocator() const noexcept;
+
+        void set_eviction_callback(eviction_callback);
+        void set_capacity(const size_type);
+        void set_byte_budget(const size_type);
+
+
+        //* Capacity *//
+
+        [[nodiscard]] bool empty() const noexcept {
+            return m_entries.empty();
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return m_entries.size();
+        }
+
+        [[nodiscard]] size_type capacity() const noexcept {
+            return m_capacity;
+        }
+
+        [[nodiscard]] size_type byte_budget() const noexcept {
+            return m_byte_budget;
+        }
+
+        [[nodiscard]] size_type weight() const noexcept {
+            return m_weight;
+        }
+
+
+        //* Iterators *//
+
+        // Entries are visited from the most to the least recently used
+
+        iterator begin() noexcept {
+            return m_entries.begin();
+        }
+
+        const_iterator begin() const noexcept {
+            return m_entries.begin();
+        }
+
+        const_iterator cbegin() const noexcept {
+            return m_entries.cbegin();
+        }
+
+        iterator end() noexcept {
+            return m_entries.end();
+        }
+
+        const_iterator end() const noexcept {
+            return m_entries.end();
+        }
+
+        const_iterator cend() const noexcept {
+            return m_entries.cend();
+        }
+
+
+        //* Lookup *//
+
+        iterator find(const Key&);
+        Value* get(const Key&);
+
+        const_iterator peek(const Key&) const;
+        bool contains(const Key&) const;
+
+
+        //* Modifiers *//
+
+        void clear() noexcept;
+
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(const Key&, Args&&...);
+
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(Key&&, Args&&...);
+
+        template <class M>
+        std::pair<iterator, bool> insert_or_assign(const Key&, M&&);
+
+        template <class M>
+        std::pair<iterator, bool> insert_or_assign(Key&&, M&&);
+
+        size_type erase(const Key&);
+
+        void swap(lru_cache&) noexcept;
+
+
+    private:
+
+        //*** Using Directives ***//
+
+        struct slot_t {
+            iterator m_entry;
+            std::size_t m_hash;
+            size_type m_weight;
+        };
+
+        static constexpr size_type initial_slots = 16;
+        static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+
+        //*** Members ***//
+
+        doubly_linked_list<value_type> m_entries;
+        slot_t *m_slots;
+        size_type m_slot_count;
+        unsigned m_shift;
+
+        size_type m_capacity;
+        size_type m_byte_budget;
+        size_type m_weight;
+
+        hasher m_hash;
+        key_equal m_equal;
+        weigher m_weigh;
+        eviction_callback m_on_evict;
+
+
+        //*** Functions ***//
+
+        static bool vacant(const slot_t &slot) noexcept {
+            return slot.m_entry == iterator();
+        }
+
+        size_type find_slot(const Key&, const std::size_t) const;
+        void place_slot(const iterator, const std::size_t, const size_type) noexcept;
+        void erase_slot(size_type) noexcept;
+
+        void rehash(const size_type);
+        void deallocate_slots() noexcept;
+
+        template <class K, class... Args>
+        std::pair<iterator, bool> emplace_unique(K&&, Args&&...);
+
+        template <class K, class M>
+        std::pair<iterator, bool> assign_unique(K&&, M&&);
+
+        size_type weigh(const value_type&) const;
+        void touch(const iterator) noexcept;
+        void evict();
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    /**
+     * @brief Returns the slot holding key, or npos. A probe ends at the first vacant slot.
+     */
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    typename lru_cache<Key, Value, Hash, KeyEqual>::size_type lru_cache<Key, Value, Hash, KeyEqual>::find_slot(const Key &key, const std::size_t hash) const {
+        if (m_slot_count == 0)
+            return npos;
+
+        auto mask = m_slot_count - 1;
+        for (auto i = details::fibonacci_slot(hash, m_shift); ; i = (i + 1) & mask) {
+            const auto &slot = m_slots[i];
+            if (vacant(slot))
+                return npos;
+            if (slot.m_hash == hash && m_equal(slot.m_entry->first, key))
+                return i;
+        }
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::place_slot(const iterator entry, const std::size_t hash, const size_type weight) noexcept {
+        auto mask = m_slot_count - 1;
+        auto i = details::fibonacci_slot(hash, m_shift);
+        while (!vacant(m_slots[i]))
+            i = (i + 1) & mask;
+        m_slots[i] = slot_t{ entry, hash, weight };
+    }
+
+    /**
+     * @brief Vacates slot i, shifting later slots of the same probe sequence back into the gap so
+     * that lookups never need tombstones.
+     */
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::erase_slot(size_type i) noexcept {
+        auto mask = m_slot_count - 1;
+        for (auto j = (i + 1) & mask; !vacant(m_slots[j]); j = (j + 1) & mask) {
+            auto home = details::fibonacci_slot(m_slots[j].m_hash, m_shift);
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                m_slots[i] = m_slots[j];
+                i = j;
+            }
+        }
+        m_slots[i] = slot_t{ iterator(), 0, 0 };
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::rehash(const size_type slot_count) {
+        auto resource = m_entries.get_allocator().resource();
+        auto slots = static_cast<slot_t*>(resource->allocate(sizeof(slot_t) * slot_count, alignof(slot_t)));
+        for (size_type i = 0; i < slot_count; ++i)
+            ::new (static_cast<void*>(slots + i)) slot_t{ iterator(), 0, 0 };
+
+        auto old_slots = m_slots;
+        auto old_count = m_slot_count;
+
+        m_slots = slots;
+        m_slot_count = slot_count;
+        m_shift = 0;
+        for (auto count = slot_count; count > 1; count >>= 1)
+            ++m_shift;
+        m_shift = std::numeric_limits<std::uint64_t>::digits - m_shift;
+
+        for (size_type i = 0; i < old_count; ++i) {
+            if (!vacant(old_slots[i]))
+                place_slot(old_slots[i].m_entry, old_slots[i].m_hash, old_slots[i].m_weight);
+        }
+
+        if (old_slots)
+            resource->deallocate(old_slots, sizeof(slot_t) * old_count, alignof(slot_t));
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::deallocate_slots() noexcept {
+        if (m_slots)
+            m_entries.get_allocator().resource()->deallocate(m_slots, sizeof(slot_t) * m_slot_count, alignof(slot_t));
+
+        m_slots = nullptr;
+        m_slot_count = 0;
+    }
+
+    /**
+     * @brief Inserts a new entry at the front unless key is present, in which case the existing
+     * entry is touched. The index is grown before the entry is created, keeping the load factor at
+     * most one half, so that nothing has changed if construction or weighing throws.
+     */
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    template <class K, class... Args>
+    std::pair<typename lru_cache<Key, Value, Hash, KeyEqual>::iterator, bool> lru_cache<Key, Value, Hash, KeyEqual>::emplace_unique(K &&key, Args &&...args) {
+        auto hash = m_hash(key);
+        auto i = find_slot(key, hash);
+        if (i != npos) {
+            touch(m_slots[i].m_entry);
+            return { m_entries.begin(), false };
+        }
+
+        if (2 * (m_entries.size() + 1) > m_slot_count)
+            rehash(m_slot_count ? 2 * m_slot_count : initial_slots);
+
+        m_entries.emplace_front(std::piecewise_construct,
+                                std::forward_as_tuple(std::forward<K>(key)),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+
+        size_type weight;
+        try {
+            weight = weigh(m_entries.front());
+        } catch (...) {
+            m_entries.pop_front();
+            throw;
+        }
+
+        place_slot(m_entries.begin(), hash, weight);
+        m_weight += weight;
+        evict();
+        return { m_entries.begin(), true };
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    template <class K, class M>
+    std::pair<typename lru_cache<Key, Value, Hash, KeyEqual>::iterator, bool> lru_cache<Key, Value, Hash, KeyEqual>::assign_unique(K &&key, M &&obj) {
+        auto hash = m_hash(key);
+        auto i = find_slot(key, hash);
+        if (i == npos)
+            return emplace_unique(std::forward<K>(key), std::forward<M>(obj));
+
+        auto &slot = m_slots[i];
+        slot.m_entry->second = std::forward<M>(obj);
+
+        auto weight = weigh(*slot.m_entry);
+        m_weight = m_weight - slot.m_weight + weight;
+        slot.m_weight = weight;
+
+        touch(slot.m_entry);
+        evict();
+        return { m_entries.begin(), false };
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    typename lru_cache<Key, Value, Hash, KeyEqual>::size_type lru_cache<Key, Value, Hash, KeyEqual>::weigh(const value_type &entry) const {
+        return m_weigh ? m_weigh(entry.first, entry.second) : 0;
+    }
+
+    /**
+     * @brief Relinks the node of an entry to the front of the recency list.
+     */
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::touch(const iterator entry) noexcept {
+        m_entries.splice(m_entries.begin(), m_entries, entry);
+    }
+
+    /**
+     * @brief Evicts least recently used entries until the cache is within its capacity and byte
+     * budget, or only the most recent entry is left. The eviction callback runs before an entry is
+     * removed, so that if it throws the entry stays cached.
+     */
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::evict() {
+        while (m_entries.size() > 1 && (m_entries.size() > m_capacity || m_weight > m_byte_budget)) {
+            auto &victim = m_entries.back();
+            if (m_on_evict)
+                m_on_evict(victim.first, victim.second);
+
+            auto i = find_slot(victim.first, m_hash(victim.first));
+            m_weight -= m_slots[i].m_weight;
+            erase_slot(i);
+            m_entries.pop_back();
+        }
+    }
+
+
+    //*** Public ***//
+
+    //* Assignment operator overloads *//
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    lru_cache<Key, Value, Hash, KeyEqual>& lru_cache<Key, Value, Hash, KeyEqual>::operator=(lru_cache &&other) {
+        if (this == &other)
+            return *this;
+
+        clear();
+        if (get_allocator() == other.get_allocator()) {
+            swap(other);
+            return *this;
+        }
+
+        // Entries cannot change resources, so they are moved one at a time, least recent first
+        m_capacity = other.m_capacity;
+        m_byte_budget = other.m_byte_budget;
+        m_hash = other.m_hash;
+        m_equal = other.m_equal;
+        m_weigh = other.m_weigh;
+        m_on_evict = other.m_on_evict;
+
+        for (auto it = other.m_entries.end(); it != other.m_entries.begin();) {
+            --it;
+            emplace_unique(it->first, std::move(it->second));
+        }
+        other.clear();
+        return *this;
+    }
+
+
+    //* Allocator access and configuration *//
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    typename lru_cache<Key, Value, Hash, KeyEqual>::allocator_type lru_cache<Key, Value, Hash, KeyEqual>::get_allocator() const noexcept {
+        return m_entries.get_allocator();
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::set_eviction_callback(eviction_callback on_evict) {
+        m_on_evict = std::move(on_evict);
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::set_capacity(const size_type capacity) {
+        if (capacity == 0)
+            throw std::length_error("Cache capacity must be at least one.");
+
+        m_capacity = capacity;
+        evict();
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::set_byte_budget(const size_type byte_budget) {
+        m_byte_budget = byte_budget;
+        evict();
+    }
+
+
+    //* Lookup *//
+
+    /**
+     * @brief Returns the entry for key, marking it most recently used, or end() on a miss.
+     */
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    typename lru_cache<Key, Value, Hash, KeyEqual>::iterator lru_cache<Key, Value, Hash, KeyEqual>::find(const Key &key) {
+        auto i = find_slot(key, m_hash(key));
+        if (i == npos)
+            return m_entries.end();
+
+        touch(m_slots[i].m_entry);
+        return m_entries.begin();
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    Value* lru_cache<Key, Value, Hash, KeyEqual>::get(const Key &key) {
+        auto it = find(key);
+        return it == m_entries.end() ? nullptr : std::addressof(it->second);
+    }
+
+    /**
+     * @brief Returns the entry for key without changing its recency, or end() on a miss.
+     */
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    typename lru_cache<Key, Value, Hash, KeyEqual>::const_iterator lru_cache<Key, Value, Hash, KeyEqual>::peek(const Key &key) const {
+        auto i = find_slot(key, m_hash(key));
+        return i == npos ? m_entries.end() : const_iterator(m_slots[i].m_entry);
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    bool lru_cache<Key, Value, Hash, KeyEqual>::contains(const Key &key) const {
+        return find_slot(key, m_hash(key)) != npos;
+    }
+
+
+    //* Modifiers *//
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::clear() noexcept {
+        m_entries.clear();
+        for (size_type i = 0; i < m_slot_count; ++i)
+            m_slots[i] = slot_t{ iterator(), 0, 0 };
+        m_weight = 0;
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    template <class... Args>
+    std::pair<typename lru_cache<Key, Value, Hash, KeyEqual>::iterator, bool> lru_cache<Key, Value, Hash, KeyEqual>::try_emplace(const Key &key, Args &&...args) {
+        return emplace_unique(key, std::forward<Args>(args)...);
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    template <class... Args>
+    std::pair<typename lru_cache<Key, Value, Hash, KeyEqual>::iterator, bool> lru_cache<Key, Value, Hash, KeyEqual>::try_emplace(Key &&key, Args &&...args) {
+        return emplace_unique(std::move(key), std::forward<Args>(args)...);
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    template <class M>
+    std::pair<typename lru_cache<Key, Value, Hash, KeyEqual>::iterator, bool> lru_cache<Key, Value, Hash, KeyEqual>::insert_or_assign(const Key &key, M &&obj) {
+        return assign_unique(key, std::forward<M>(obj));
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    template <class M>
+    std::pair<typename lru_cache<Key, Value, Hash, KeyEqual>::iterator, bool> lru_cache<Key, Value, Hash, KeyEqual>::insert_or_assign(Key &&key, M &&obj) {
+        return assign_unique(std::move(key), std::forward<M>(obj));
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    typename lru_cache<Key, Value, Hash, KeyEqual>::size_type lru_cache<Key, Value, Hash, KeyEqual>::erase(const Key &key) {
+        auto i = find_slot(key, m_hash(key));
+        if (i == npos)
+            return 0;
+
+        auto entry = m_slots[i].m_entry;
+        m_weight -= m_slots[i].m_weight;
+        erase_slot(i);
+        m_entries.erase(entry);
+        return 1;
+    }
+
+    /**
+     * @brief Exchanges the contents and configuration of two caches. Like the containers, does
+     * nothing if the allocators compare unequal.
+     */
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::swap(lru_cache &other) noexcept {
+        if (get_allocator() != other.get_allocator())
+            return;
+
+        using std::swap;
+        m_entries.swap(other.m_entries);
+        swap(m_slots, other.m_slots);
+        swap(m_slot_count, other.m_slot_count);
+        swap(m_shift, other.m_shift);
+        swap(m_capacity, other.m_capacity);
+        swap(m_byte_budget, other.m_byte_budget);
+        swap(m_weight, other.m_weight);
+        swap(m_hash, other.m_hash);
+        swap(m_equal, other.m_equal);
+        swap(m_weigh, other.m_weigh);
+        swap(m_on_evict, other.m_on_evict);
+    }
+
+
+
+    /**
+     * @brief Thread-safe least-recently-used cache made of independently locked lru_cache shards.
+     * A key always maps to the same shard, chosen from the upper bits of its hash, so recency and
+     * eviction are tracked per shard. Lookups return copies or run a visitor under the shard lock,
+     * since references could be invalidated by other threads as soon as the lock is released.
+     *
+     * The memory resource of the allocator is shared by all shards and must be thread-safe. The
+     * eviction callback runs under the lock of the evicting shard.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Hash
+     * @tparam KeyEqual
+     */
+    template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class sharded_lru_cache {
+    public:
+
+        //*** Member Types ***//
+
+        using cache_type = lru_cache<Key, Value, Hash, KeyEqual>;
+
+        using key_type = Key;
+        using mapped_type = Value;
+        using size_type = std::size_t;
+        using hasher = Hash;
+
+        using allocator_type = typename cache_type::allocator_type;
+        using eviction_callback = typename cache_type::eviction_callback;
+        using weigher = typename cache_type::weigher;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit sharded_lru_cache(const size_type capacity,
+                                   const size_type shard_count = 16,
+                                   allocator_type allocator = {})
+            : sharded_lru_cache(capacity, std::numeric_limits<size_type>::max(), weigher(), shard_count, allocator)
+        {}
+
+        /**
+         * @brief Divides the capacity and byte budget evenly between shard_count shards, rounded
+         * up to a power of two.
+         */
+        sharded_lru_cache(const size_type capacity,
+                          const size_type byte_budget,
+                          weigher weigh,
+                          const size_type shard_count = 16,
+                          allocator_type allocator = {})
+            : m_allocator(allocator)
+            , m_shards(nullptr)
+            , m_shard_count(1)
+            , m_shift(std::numeric_limits<std::uint64_t>::digits)
+            , m_hash()
+        {
+            while (m_shard_count < shard_count) {
+                m_shard_count <<= 1;
+                --m_shift;
+            }
+
+            auto shard_capacity = (capacity + m_shard_count - 1) / m_shard_count;
+            auto shard_budget = byte_budget == std::numeric_limits<size_type>::max() ? byte_budget : (byte_budget + m_shard_count - 1) / m_shard_count;
+
+            m_shards = static_cast<shard*>(m_allocator.resource()->allocate(sizeof(shard) * m_shard_count, alignof(shard)));
+            size_type constructed = 0;
+            try {
+                for (; constructed < m_shard_count; ++constructed)
+                    ::new (static_cast<void*>(m_shards + constructed)) shard(shard_capacity, shard_budget, weigh, m_allocator);
+            } catch (...) {
+                destroy_shards(constructed);
+                throw;
+            }
+        }
+
+        sharded_lru_cache(const sharded_lru_cache&) = delete;
+        sharded_lru_cache& operator=(const sharded_lru_cache&) = delete;
+
+
+        //* Destructor *//
+        ~sharded_lru_cache() {
+            destroy_shards(m_shard_count);
+        }
+
+
+        //* Configuration *//
+
+        void set_eviction_callback(const eviction_callback&);
+
+        [[nodiscard]] size_type shard_count() const noexcept {
+            return m_shard_count;
+        }
+
+
+        //* Capacity *//
+
+        [[nodiscard]] size_type size() const;
+
+
+        //* Lookup *//
+
+        std::optional<Value> get(const Key&);
+        bool contains(const Key&) const;
+
+        template <class F>
+        bool visit(const Key&, F&&);
+
+
+        //* Modifiers *//
+
+        void clear();
+
+        template <class... Args>
+        bool try_emplace(const Key&, Args&&...);
+
+        template <class M>
+        bool insert_or_assign(const Key&, M&&);
+
+        size_type erase(const Key&);
+
+
+    private:
+
+        //*** Using Directives ***//
+
+        // Padded to separate cache lines, so that locking one shard does not contend with its neighbours
+        struct alignas(64) shard {
+            shard(const size_type capacity, const size_type byte_budget, const weigher &weigh, allocator_type allocator)
+                : m_mutex()
+                , m_cache(capacity, byte_budget, weigh, allocator) {}
+
+            mutable std::mutex m_mutex;
+            cache_type m_cache;
+        };
+
+
+        //*** Members ***//
+
+        allocator_type m_allocator;
+        shard *m_shards;
+        size_type m_shard_count;
+        unsigned m_shift;
+        hasher m_hash;
+
+
+        //*** Functions ***//
+
+        shard& shard_for(const Key &key) const {
+            // A different multiplier than the shard's own index, so that keys spread over all of its slots
+            auto hash = static_cast<std::uint64_t>(m_hash(key)) * 0xC2B2AE3D27D4EB4Full;
+            return m_shards[m_shard_count == 1 ? 0 : static_cast<size_type>(hash >> m_shift)];
+        }
+
+        void destroy_shards(const size_type count) noexcept {
+            for (size_type i = 0; i < count; ++i)
+                m_shards[i].~shard();
+            m_allocator.resource()->deallocate(m_shards, sizeof(shard) * m_shard_count, alignof(shard));
+        }
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //* Configuration *//
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void sharded_lru_cache<Key, Value, Hash, KeyEqual>::set_eviction_callback(const eviction_callback &on_evict) {
+        for (size_type i = 0; i < m_shard_count; ++i) {
+            std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+            m_shards[i].m_cache.set_eviction_callback(on_evict);
+        }
+    }
+
+
+    //* Capacity *//
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    typename sharded_lru_cache<Key, Value, Hash, KeyEqual>::size_type sharded_lru_cache<Key, Value, Hash, KeyEqual>::size() const {
+        size_type size = 0;
+        for (size_type i = 0; i < m_shard_count; ++i) {
+            std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+            size += m_shards[i].m_cache.size();
+        }
+        return size;
+    }
+
+
+    //* Lookup *//
+
+    /**
+     * @brief Returns a copy of the value for key, marking it most recently used within its shard.
+     */
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    std::optional<Value> sharded_lru_cache<Key, Value, Hash, KeyEqual>::get(const Key &key) {
+        auto &target = shard_for(key);
+        std::lock_guard<std::mutex> lock(target.m_mutex);
+        auto value = target.m_cache.get(key);
+        return value ? std::optional<Value>(*value) : std::nullopt;
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    bool sharded_lru_cache<Key, Value, Hash, KeyEqual>::contains(const Key &key) const {
+        auto &target = shard_for(key);
+        std::lock_guard<std::mutex> lock(target.m_mutex);
+        return target.m_cache.contains(key);
+    }
+
+    /**
+     * @brief Invokes f with the value for key under the shard lock, marking it most recently used.
+     * Returns whether the key was found. f must not call back into the cache.
+     */
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    template <class F>
+    bool sharded_lru_cache<Key, Value, Hash, KeyEqual>::visit(const Key &key, F &&f) {
+        auto &target = shard_for(key);
+        std::lock_guard<std::mutex> lock(target.m_mutex);
+        auto value = target.m_cache.get(key);
+        if (!value)
+            return false;
+
+        std::forward<F>(f)(*value);
+        return true;
+    }
+
+
+    //* Modifiers *//
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void sharded_lru_cache<Key, Value, Hash, KeyEqual>::clear() {
+        for (size_type i = 0; i < m_shard_count; ++i) {
+            std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+            m_shards[i].m_cache.clear();
+        }
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    template <class... Args>
+    bool sharded_lru_cache<Key, Value, Hash, KeyEqual>::try_emplace(const Key &key, Args &&...args) {
+        auto &target = shard_for(key);
+        std::lock_guard<std::mutex> lock(target.m_mutex);
+        return target.m_cache.try_emplace(key, std::forward<Args>(args)...).second;
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    template <class M>
+    bool sharded_lru_cache<Key, Value, Hash, KeyEqual>::insert_or_assign(const Key &key, M &&obj) {
+        auto &target = shard_for(key);
+        std::lock_guard<std::mutex> lock(target.m_mutex);
+        return target.m_cache.insert_or_assign(key, std::forward<M>(obj)).second;
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    typename sharded_lru_cache<Key, Value, Hash, KeyEqual>::size_type sharded_lru_cache<Key, Value, Hash, KeyEqual>::erase(const Key &key) {
+        auto &target = shard_for(key);
+        std::lock_guard<std::mutex> lock(target.m_mutex);
+        return target.m_cache.erase(key);
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_LRU_CACHE_H
@@ -0,0 +1,810 @@
+#ifndef DSL_PACKED_LIST_H
+#define DSL_PACKED_LIST_H
+
+
+#include "list.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace dsl {
+
+    namespace details {
+
+        static constexpr std::size_t word_bits = 64;
+
+        inline unsigned popcount(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_popcountll(word));
+#else
+            unsigned count = 0;
+            for (; word; word &= word - 1)
+                ++count;
+            return count;
+#endif
+        }
+
+        // Index of the lowest set bit of a non-zero word
+        inline unsigned lowest_set_bit(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+            unsigned index = 0;
+            for (; !(word & 1); word >>= 1)
+                ++index;
+            return index;
+#endif
+        }
+
+        template <unsigned Bits>
+        using packed_value_t = std::conditional_t<Bits <= 8, std::uint8_t,
+                               std::conditional_t<Bits <= 16, std::uint16_t,
+                               std::conditional_t<Bits <= 32, std::uint32_t, std::uint64_t>>>;
+
+
+        /**
+         * @brief Random-access iterator over a container whose elements are accessed by index
+         * through proxies. Dereferencing yields the container's reference proxy, or a value
+         * for const iteration. Like std::vector<bool>::iterator, it is random access in every
+         * respect except that its reference is not a true reference.
+         *
+         * @tparam Container
+         * @tparam Const
+         */
+        template <class Container, bool Const>
+        class index_iterator {
+        public:
+
+            //*** Member Types ***//
+
+            using container_type = std::conditional_t<Const, const Container, Container>;
+            using value_type = typename Container::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, value_type, typename Container::reference>;
+            using pointer = void;
+            using iterator_category = std::random_access_iterator_tag;
+
+
+            //*** Member Functions ***//
+
+            index_iterator() noexcept
+                : m_container(nullptr)
+                , m_index(0) {}
+
+            index_iterator(container_type *container, const std::size_t index) noexcept
+                : m_container(container)
+                , m_index(index) {}
+
+            template <bool WasConst, typename = std::enable_if_t<Const && !WasConst>>
+            index_iterator(const index_iterator<Container, WasConst> &other) noexcept
+                : m_container(other.m_container)
+                , m_index(other.m_index) {}
+
+            [[nodiscard]] reference operator*() const {
+                return (*m_container)[m_index];
+            }
+
+            [[nodiscard]] reference operator[](const difference_type offset) const {
+                return (*m_container)[m_index + offset];
+            }
+
+            index_iterator& operator++() noexcept { ++m_index; return *this; }
+            index_iterator operator++(int) noexcept { auto it = *this; ++m_index; return it; }
+            index_iterator& operator--() noexcept { --m_index; return *this; }
+            index_iterator operator--(int) noexcept { auto it = *this; --m_index; return it; }
+
+            index_iterator& operator+=(const difference_type offset) noexcept { m_index += offset; return *this; }
+            index_iterator& operator-=(const difference_type offset) noexcept { m_index -= offset; return *this; }
+
+            [[nodiscard]] index_iterator operator+(const difference_type offset) const noexcept { return index_iterator(m_container, m_index + offset); }
+            [[nodiscard]] index_iterator operator-(const difference_type offset) const noexcept { return index_iterator(m_container, m_index - offset); }
+
+            friend index_iterator operator+(const difference_type offset, const index_iterator &it) noexcept {
+                return it + offset;
+            }
+
+            [[nodiscard]] difference_type operator-(const index_iterator &other) const noexcept {
+                return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+            }
+
+            [[nodiscard]] bool operator==(const index_iterator &other) const noexcept { return m_index == other.m_index; }
+            [[nodiscard]] bool operator!=(const index_iterator &other) const noexcept { return m_index != other.m_index; }
+            [[nodiscard]] bool operator<(const index_iterator &other) const noexcept { return m_index < other.m_index; }
+            [[nodiscard]] bool operator>(const index_iterator &other) const noexcept { return m_index > other.m_index; }
+            [[nodiscard]] bool operator<=(const index_iterator &other) const noexcept { return m_index <= other.m_index; }
+            [[nodiscard]] bool operator>=(const index_iterator &other) const noexcept { return m_index >= other.m_index; }
+
+        private:
+            template <class, bool> friend class index_iterator;
+
+            container_type *m_container;
+            std::size_t m_index;
+        };
+
+    }   // namespace details
+
+
+    /**
+     * @brief Proxy for a single bit of a bit_list.
+     */
+    class bit_reference {
+    public:
+        operator bool() const noexcept {
+            return (*m_word & m_mask) != 0;
+        }
+
+        bit_reference& operator=(const bool value) noexcept {
+            if (value)
+                *m_word |= m_mask;
+            else
+                *m_word &= ~m_mask;
+            return *this;
+        }
+
+        bit_reference& operator=(const bit_reference &other) noexcept {
+            return *this = static_cast<bool>(other);
+        }
+
+        bool operator~() const noexcept {
+            return !static_cast<bool>(*this);
+        }
+
+        void flip() noexcept {
+            *m_word ^= m_mask;
+        }
+
+    private:
+        friend class bit_list;
+
+        bit_reference(std::uint64_t *word, const std::uint64_t mask) noexcept
+            : m_word(word)
+            , m_mask(mask) {}
+
+        std::uint64_t *m_word;
+        std::uint64_t m_mask;
+    };
+
+
+    /**
+     * @brief Sequence of bits packed 64 to a word in a dsl::list<std::uint64_t>, so that it grows
+     * through the same (pmr) allocator as the other containers. Elements are accessed through
+     * bit_reference proxies, and count, find_first and find_next work a word at a time. Bits
+     * past the size in the last word are kept clear.
+     */
+    class bit_list {
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = bool;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = bit_reference;
+        using const_reference = bool;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        using iterator = details::index_iterator<bit_list, false>;
+        using const_iterator = details::index_iterator<bit_list, true>;
+
+        static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit bit_list(allocator_type allocator = {})
+            : m_words(allocator)
+            , m_size(0)
+        {}
+
+        bit_list(const size_type count, const bool value, allocator_type allocator = {})
+            : bit_list(allocator)
+        { resize(count, value); }
+
+        bit_list(std::initializer_list<bool> init, allocator_type allocator = {})
+            : bit_list(allocator)
+        {
+            reserve(init.size());
+            for (auto value : init)
+                push_back(value);
+        }
+
+
+        //* Element Access *//
+
+        reference operator[](const size_type pos) noexcept {
+            return reference(&m_words[pos / details::word_bits], bit_mask(pos));
+        }
+
+        bool operator[](const size_type pos) const noexcept {
+            return (m_words[pos / details::word_bits] & bit_mask(pos)) != 0;
+        }
+
+        reference at(const size_type pos) {
+            check_bounds(pos);
+            return (*this)[pos];
+        }
+
+        bool at(const size_type pos) const {
+            check_bounds(pos);
+            return (*this)[pos];
+        }
+
+        reference front() noexcept { return (*this)[0]; }
+        bool front() const noexcept { return (*this)[0]; }
+        reference back() noexcept { return (*this)[m_size - 1]; }
+        bool back() const noexcept { return (*this)[m_size - 1]; }
+
+        // The packed words, least significant bit first; the last word may be partial
+        const std::uint64_t* data() const noexcept {
+            return m_words.data();
+        }
+
+        size_type word_count() const noexcept {
+            return m_words.size();
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return m_words.get_allocator();
+        }
+
+
+        //* Iterators *//
+
+        iterator begin() noexcept { return iterator(this, 0); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+        iterator end() noexcept { return iterator(this, m_size); }
+        const_iterator end() const noexcept { return const_iterator(this, m_size); }
+        const_iterator cend() const noexcept { return const_iterator(this, m_size); }
+
+
+        //* Capacity *//
+
+        [[nodiscard]] bool empty() const noexcept {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return m_size;
+        }
+
+        [[nodiscard]] size_type capacity() const noexcept {
+            return m_words.capacity() * details::word_bits;
+        }
+
+        void reserve(const size_type count) {
+            m_words.reserve(words_for(count));
+        }
+
+        void shrink_to_fit() {
+            m_words.shrink_to_fit();
+        }
+
+
+        //* Modifiers *//
+
+        void clear() noexcept {
+            m_words.clear();
+            m_size = 0;
+        }
+
+        void push_back(const bool value) {
+            if (m_size % details::word_bits == 0)
+                m_words.push_back(0);
+            if (value)
+                m_words.back() |= bit_mask(m_size);
+            ++m_size;
+        }
+
+        void pop_back() noexcept {
+            --m_size;
+            if (m_size % details::word_bits == 0)
+                m_words.pop_back();
+            else
+                m_words.back() &= ~bit_mask(m_size);
+        }
+
+        void resize(const size_type, const bool = false);
+
+        void set(const size_type pos, const bool value = true) { at(pos) = value; }
+        void reset(const size_type pos) { at(pos) = false; }
+        void flip(const size_type pos) { at(pos).flip(); }
+        void flip() noexcept;
+
+        void swap(bit_list &other) {
+            m_words.swap(other.m_words);
+            std::swap(m_size, other.m_size);
+        }
+
+
+        //* Operations *//
+
+        [[nodiscard]] size_type count() const noexcept;
+
+        [[nodiscard]] bool any() const noexcept { return find_first() != npos; }
+        [[nodiscard]] bool none() const noexcept { return !any(); }
+        [[nodiscard]] bool all() const noexcept { return count() == m_size; }
+
+        [[nodiscard]] size_type find_first() const noexcept;
+        [[nodiscard]] size_type find_next(const size_type) const noexcept;
+
+
+        //*** Non-Member Functions ***//
+
+        friend bool operator==(const bit_list &lhs, const bit_list &rhs) {
+            return lhs.m_size == rhs.m_size && lhs.m_words == rhs.m_words;
+        }
+
+        friend bool operator!=(const bit_list &lhs, const bit_list &rhs) {
+            return !(lhs == rhs);
+        }
+
+
+    private:
+
+        //*** Members ***//
+
+        list<std::uint64_t> m_words;
+        size_type m_size;
+
+
+        //*** Functions ***//
+
+        static constexpr size_type words_for(const size_type count) noexcept {
+            return (count + details::word_bits - 1) / details::word_bits;
+        }
+
+        static constexpr std::uint64_t bit_mask(const size_type pos) noexcept {
+            return std::uint64_t(1) << (pos % details::word_bits);
+        }
+
+        void check_bounds(const size_type pos) const {
+            if (pos >= m_size)
+                throw std::out_of_range("Index out of bounds.");
+        }
+
+        // Clears the bits past the size in the last word
+        void trim() noexcept {
+            if (auto used = m_size % details::word_bits)
+                m_words.back() &= (std::uint64_t(1) << used) - 1;
+        }
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Public ***//
+
+    //* Modifiers *//
+
+    /**
+     * @brief Resizes to count bits, setting new bits to value a word at a time.
+     */
+    inline void bit_list::resize(const size_type count, const bool value) {
+        if (count <= m_size) {
+            m_words.resize(words_for(count));
+            m_size = count;
+            trim();
+            return;
+        }
+
+        if (value && m_size % details::word_bits)
+            m_words.back() |= ~std::uint64_t(0) << (m_size % details::word_bits);
+
+        m_words.resize(words_for(count), value ? ~std::uint64_t(0) : 0);
+        m_size = count;
+        trim();
+    }
+
+    inline void bit_list::flip() noexcept {
+        for (auto &word : m_words)
+            word = ~word;
+        trim();
+    }
+
+
+    //* Operations *//
+
+    inline bit_list::size_type bit_list::count() const noexcept {
+        size_type total = 0;
+        for (auto word : m_words)
+            total += details::popcount(word);
+        return total;
+    }
+
+    /**
+     * @brief Returns the position of the first set bit, or npos if there is none.
+     */
+    inline bit_list::size_type bit_list::find_first() const noexcept {
+        for (size_type i = 0; i < m_words.size(); ++i) {
+            if (m_words[i])
+                return i * details::word_bits + details::lowest_set_bit(m_words[i]);
+        }
+        return npos;
+    }
+
+    /**
+     * @brief Returns the position of the first set bit after pos, or npos if there is none.
+     */
+    inline bit_list::size_type bit_list::find_next(const size_type pos) const noexcept {
+        auto next = pos + 1;
+        if (next >= m_size)
+            return npos;
+
+        auto i = next / details::word_bits;
+        auto word = m_words[i] & (~std::uint64_t(0) << (next % details::word_bits));
+        while (!word) {
+            if (++i == m_words.size())
+                return npos;
+            word = m_words[i];
+        }
+        return i * details::word_bits + details::lowest_set_bit(word);
+    }
+
+
+
+    /**
+     * @brief Sequence of unsigned integers of Bits bits each, packed back to back (straddling
+     * word boundaries where Bits does not divide 64) in a dsl::list<std::uint64_t>. Elements are
+     * accessed through proxies; append and unpack move whole runs, streaming a word at a time
+     * rather than masking each element into place.
+     *
+     * @tparam Bits Width of an element, from 1 to 64
+     */
+    template <unsigned Bits>
+    class packed_list {
+        static_assert(Bits >= 1 && Bits <= details::word_bits, "The element width must be between 1 and 64 bits.");
+
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = details::packed_value_t<Bits>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using const_reference = value_type;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        class reference;
+
+        using iterator = details::index_iterator<packed_list, false>;
+        using const_iterator = details::index_iterator<packed_list, true>;
+
+        static constexpr unsigned bits = Bits;
+        static constexpr value_type max_value = static_cast<value_type>(Bits == details::word_bits ? ~std::uint64_t(0) : (std::uint64_t(1) << Bits) - 1);
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit packed_list(allocator_type allocator = {})
+            : m_words(allocator)
+            , m_size(0)
+        {}
+
+        packed_list(const size_type count, const value_type value, allocator_type allocator = {})
+            : packed_list(allocator)
+        { resize(count, value); }
+
+        packed_list(std::initializer_list<value_type> init, allocator_type allocator = {})
+            : packed_list(allocator)
+        { append(init.begin(), init.size()); }
+
+
+        //* Element Access *//
+
+        reference operator[](const size_type pos) noexcept {
+            return reference(this, pos);
+        }
+
+        value_type operator[](const size_type pos) const noexcept {
+            return static_cast<value_type>(load(pos));
+        }
+
+        reference at(const size_type pos) {
+            check_bounds(pos);
+            return (*this)[pos];
+        }
+
+        value_type at(const size_type pos) const {
+            check_bounds(pos);
+            return (*this)[pos];
+        }
+
+        reference front() noexcept { return (*this)[0]; }
+        value_type front() const noexcept { return (*this)[0]; }
+        reference back() noexcept { return (*this)[m_size - 1]; }
+        value_type back() const noexcept { return (*this)[m_size - 1]; }
+
+        const std::uint64_t* data() const noexcept {
+            return m_words.data();
+        }
+
+        size_type word_count() const noexcept {
+            return m_words.size();
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return m_words.get_allocator();
+        }
+
+
+        //* Iterators *//
+
+        iterator begin() noexcept { return iterator(this, 0); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+        iterator end() noexcept { return iterator(this, m_size); }
+        const_iterator end() const noexcept { return const_iterator(this, m_size); }
+        const_iterator cend() const noexcept { return const_iterator(this, m_size); }
+
+
+        //* Capacity *//
+
+        [[nodiscard]] bool empty() const noexcept {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return m_size;
+        }
+
+        [[nodiscard]] size_type capacity() const noexcept {
+            return m_words.capacity() * details::word_bits / Bits;
+        }
+
+        void reserve(const size_type count) {
+            m_words.reserve(words_for(count));
+        }
+
+        void shrink_to_fit() {
+            m_words.shrink_to_fit();
+        }
+
+
+        //* Modifiers *//
+
+        void clear() noexcept {
+            m_words.clear();
+            m_size = 0;
+        }
+
+        void set(const size_type pos, const value_type value) {
+            check_bounds(pos);
+            check_value(value);
+            store(pos, value);
+        }
+
+        void push_back(const value_type value) {
+            check_value(value);
+            if (words_for(m_size + 1) > m_words.size())
+                m_words.push_back(0);
+            store(m_size++, value);
+        }
+
+        void pop_back() noexcept {
+            store(--m_size, 0);
+            m_words.resize(words_for(m_size));
+        }
+
+        void resize(const size_type, const value_type = 0);
+
+        void append(const value_type*, const size_type);
+        void unpack(const size_type, const size_type, value_type*) const;
+
+        void swap(packed_list &other) {
+            m_words.swap(other.m_words);
+            std::swap(m_size, other.m_size);
+        }
+
+
+        //*** Non-Member Functions ***//
+
+        friend bool operator==(const packed_list &lhs, const packed_list &rhs) {
+            return lhs.m_size == rhs.m_size && lhs.m_words == rhs.m_words;
+        }
+
+        friend bool operator!=(const packed_list &lhs, const packed_list &rhs) {
+            return !(lhs == rhs);
+        }
+
+
+    private:
+
+        //*** Members ***//
+
+        static constexpr std::uint64_t mask = max_value;
+
+        list<std::uint64_t> m_words;
+        size_type m_size;
+
+
+        //*** Functions ***//
+
+        static constexpr size_type words_for(const size_type count) noexcept {
+            return (count * Bits + details::word_bits - 1) / details::word_bits;
+        }
+
+        void check_bounds(const size_type pos) const {
+            if (pos >= m_size)
+                throw std::out_of_range("Index out of bounds.");
+        }
+
+        static void check_value(const value_type value) {
+            if (static_cast<std::uint64_t>(value) > mask)
+                throw std::out_of_range("Value does not fit in the packed width.");
+        }
+
+        std::uint64_t load(const size_type) const noexcept;
+        void store(const size_type, const std::uint64_t) noexcept;
+    };
+
+
+    /**
+     * @brief Proxy for an element of a packed_list.
+     */
+    template <unsigned Bits>
+    class packed_list<Bits>::reference {
+    public:
+        operator value_type() const noexcept {
+            return static_cast<value_type>(m_list->load(m_pos));
+        }
+
+        reference& operator=(const value_type value) {
+            check_value(value);
+            m_list->store(m_pos, value);
+            return *this;
+        }
+
+        reference& operator=(const reference &other) {
+            return *this = static_cast<value_type>(other);
+        }
+
+    private:
+        friend class packed_list;
+
+        reference(packed_list *list, const size_type pos) noexcept
+            : m_list(list)
+            , m_pos(pos) {}
+
+        packed_list *m_list;
+        size_type m_pos;
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    template <unsigned Bits>
+    std::uint64_t packed_list<Bits>::load(const size_type pos) const noexcept {
+        auto bit = pos * Bits;
+        auto word = bit / details::word_bits;
+        auto offset = bit % details::word_bits;
+
+        auto value = m_words[word] >> offset;
+        if (offset + Bits > details::word_bits)
+            value |= m_words[word + 1] << (details::word_bits - offset);
+        return value & mask;
+    }
+
+    template <unsigned Bits>
+    void packed_list<Bits>::store(const size_type pos, const std::uint64_t value) noexcept {
+        auto bit = pos * Bits;
+        auto word = bit / details::word_bits;
+        auto offset = bit % details::word_bits;
+
+        m_words[word] = (m_words[word] & ~(mask << offset)) | (value << offset);
+        if (offset + Bits > details::word_bits) {
+            auto spilled = details::word_bits - offset;
+            m_words[word + 1] = (m_words[word + 1] & ~(mask >> spilled)) | (value >> spilled);
+        }
+    }
+
+
+    //*** Public ***//
+
+    //* Modifiers *//
+
+    template <unsigned Bits>
+    void packed_list<Bits>::resize(const size_type count, const value_type value) {
+        check_value(value);
+
+        if (count <= m_size) {
+            m_words.resize(words_for(count));
+            if (auto used = count * Bits % details::word_bits)
+                m_words.back() &= (std::uint64_t(1) << used) - 1;
+            m_size = count;
+            return;
+        }
+
+        reserve(count);
+        while (m_size < count)
+            push_back(value);
+    }
+
+    /**
+     * @brief Appends count values, which must all fit in Bits bits, packing them into an
+     * accumulator that is written out once per completed word.
+     */
+    template <unsigned Bits>
+    void packed_list<Bits>::append(const value_type *values, const size_type count) {
+        std::uint64_t overflow = 0;
+        for (size_type i = 0; i < count; ++i)
+            overflow |= static_cast<std::uint64_t>(values[i]) & ~mask;
+        if (overflow)
+            throw std::out_of_range("Value does not fit in the packed width.");
+
+        reserve(m_size + count);
+
+        // Resume from the partial last word, if any
+        auto offset = m_size * Bits % details::word_bits;
+        std::uint64_t accumulator = 0;
+        if (offset) {
+            accumulator = m_words.back();
+            m_words.pop_back();
+        }
+
+        for (size_type i = 0; i < count; ++i) {
+            auto value = static_cast<std::uint64_t>(values[i]);
+            accumulator |= value << offset;
+            offset += Bits;
+
+            if (offset >= details::word_bits) {
+                m_words.push_back(accumulator);
+                offset -= details::word_bits;
+                accumulator = offset ? value >> (Bits - offset) : 0;
+            }
+        }
+
+        if (offset)
+            m_words.push_back(accumulator);
+        m_size += count;
+    }
+
+    /**
+     * @brief Copies the count values starting at pos to out. When Bits divides 64 no value
+     * straddles a word, and whole words are unpacked with constant shifts.
+     */
+    template <unsigned Bits>
+    void packed_list<Bits>::unpack(size_type pos, size_type count, value_type *out) const {
+        if (pos > m_size || count > m_size - pos)
+            throw std::out_of_range("Index out of bounds.");
+
+        if constexpr (details::word_bits % Bits == 0) {
+            constexpr size_type per_word = details::word_bits / Bits;
+
+            for (; count && pos % per_word; --count)
+                *out++ = static_cast<value_type>(load(pos++));
+
+            auto words = m_words.data() + pos / per_word;
+            for (; count >= per_word; count -= per_word, pos += per_word, ++words) {
+                auto word = *words;
+                for (size_type k = 0; k < per_word; ++k)
+                    out[k] = static_cast<value_type>((word >> (k * Bits)) & mask);
+                out += per_word;
+            }
+        }
+
+        for (; count; --count)
+            *out++ = static_cast<value_type>(load(pos++));
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_PACKED_LIST_H
@@ -0,0 +1,466 @@
+#ifndef DSL_PRIORITY_QUEUE_H
+#define DSL_PRIORITY_QUEUE_H
+
+
+#include "list.h"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace dsl {
+
+    template <typename Tp, typename Compare, std::size_t D> class priority_queue;
+
+    /**
+     * @brief Identifies an element of a priority_queue for decrease_key and update. A handle is
+     * invalidated when its element leaves the queue, after which its id may be reused.
+     */
+    class heap_handle {
+    public:
+        heap_handle() noexcept
+            : m_id(std::numeric_limits<std::size_t>::max()) {}
+
+        friend bool operator==(const heap_handle &lhs, const heap_handle &rhs) noexcept {
+            return lhs.m_id == rhs.m_id;
+        }
+
+        friend bool operator!=(const heap_handle &lhs, const heap_handle &rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+    private:
+        template <typename, typename, std::size_t> friend class priority_queue;
+
+        explicit heap_handle(const std::size_t id) noexcept
+            : m_id(id) {}
+
+        std::size_t m_id;
+    };
+
+
+    /**
+     * @brief Priority queue adapter keeping a D-ary heap in a dsl::list. The D children of a node
+     * are contiguous, so a sift-down compares them within one or two cache lines, and the heap is
+     * log_D(n) levels deep rather than log_2(n); 4 and 8 suit small elements. As with
+     * std::priority_queue, top() is the element for which Compare ranks every other one lower,
+     * i.e. the largest under std::less.
+     *
+     * Every element carries the id of its handle, and a second list maps ids to heap positions,
+     * so that push returns a handle for decrease_key and update.
+     *
+     * @tparam Tp
+     * @tparam Compare
+     * @tparam D Arity of the heap
+     */
+    template <typename Tp, typename Compare = std::less<Tp>, std::size_t D = 4>
+    class priority_queue {
+        static_assert(D >= 2, "A heap must have an arity of at least 2.");
+
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = Tp;
+        using size_type = std::size_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using value_compare = Compare;
+        using handle = heap_handle;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        static constexpr size_type arity = D;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit priority_queue(const Compare &compare = Compare(), allocator_type allocator = {})
+            : m_heap(allocator)
+            , m_positions(allocator)
+            , m_free(allocator)
+            , m_compare(compare)
+        {}
+
+        explicit priority_queue(allocator_type allocator)
+            : priority_queue(Compare(), allocator)
+        {}
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        priority_queue(InputIt first, InputIt last, const Compare &compare = Compare(), allocator_type allocator = {})
+            : priority_queue(compare, allocator)
+        { push_range(first, last); }
+
+
+        //* Element Access *//
+
+        [[nodiscard]] const_reference top() const {
+            if (empty())
+                throw std::out_of_range("Priority queue is empty.");
+            return m_heap[0].m_value;
+        }
+
+        const_reference value(const handle) const;
+
+
+        //* Capacity *//
+
+        [[nodiscard]] bool empty() const noexcept {
+            return m_heap.empty();
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return m_heap.size();
+        }
+
+        void reserve(const size_type capacity) {
+            m_heap.reserve(capacity);
+            m_positions.reserve(capacity);
+        }
+
+        [[nodiscard]] bool contains(const handle h) const noexcept {
+            return h.m_id < m_positions.size() && m_positions[h.m_id] != npos;
+        }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept {
+            return m_heap.get_allocator();
+        }
+
+
+        //* Modifiers *//
+
+        handle push(const Tp &value) {
+            return emplace(value);
+        }
+
+        handle push(Tp &&value) {
+            return emplace(std::move(value));
+        }
+
+        template <class... Args>
+        handle emplace(Args&&...);
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        void push_range(InputIt, InputIt);
+
+        void pop();
+
+        template <class OutputIt>
+        OutputIt pop_n(size_type, OutputIt);
+
+        void decrease_key(const handle, const Tp&);
+        void decrease_key(const handle, Tp&&);
+        void update(const handle, Tp);
+
+        void clear() noexcept;
+        void swap(priority_queue&);
+
+
+    private:
+
+        //*** Member Types ***//
+
+        struct entry {
+            Tp m_value;
+            size_type m_handle;
+        };
+
+
+        //*** Members ***//
+
+        static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+        list<entry> m_heap;
+        list<size_type> m_positions;      // Heap position of each handle id, or npos if unused
+        list<size_type> m_free;           // Handle ids available for reuse
+        Compare m_compare;
+
+
+        //*** Functions ***//
+
+        void reserve_handle();
+        size_type acquire_handle();
+        void release_handle(const size_type) noexcept;
+        size_type position_of(const handle) const;
+
+        void place(const size_type, entry&&);
+        void sift_up(size_type);
+        void sift_down(size_type);
+        void heapify();
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    /**
+     * @brief Grows the free list ahead of acquire_handle, so that it can take back every id
+     * without reallocating and release_handle cannot throw.
+     */
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::reserve_handle() {
+        if (m_free.capacity() <= m_positions.size())
+            m_free.reserve(m_positions.size() < 4 ? 8 : m_positions.size() * 2);
+    }
+
+    template <typename Tp, typename Compare, std::size_t D>
+    typename priority_queue<Tp, Compare, D>::size_type priority_queue<Tp, Compare, D>::acquire_handle() {
+        if (!m_free.empty()) {
+            auto id = m_free.back();
+            m_free.pop_back();
+            return id;
+        }
+
+        m_positions.push_back(npos);
+        return m_positions.size() - 1;
+    }
+
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::release_handle(const size_type id) noexcept {
+        m_positions[id] = npos;
+        m_free.push_back(id);
+    }
+
+    template <typename Tp, typename Compare, std::size_t D>
+    typename priority_queue<Tp, Compare, D>::size_type priority_queue<Tp, Compare, D>::position_of(const handle h) const {
+        if (!contains(h))
+            throw std::out_of_range("Handle does not refer to an element of the queue.");
+        return m_positions[h.m_id];
+    }
+
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::place(const size_type pos, entry &&e) {
+        m_positions[e.m_handle] = pos;
+        m_heap[pos] = std::move(e);
+    }
+
+    /**
+     * @brief Moves the element at pos towards the root, shifting lower-ranked parents down into
+     * the hole rather than swapping at every level.
+     */
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::sift_up(size_type pos) {
+        auto moving = std::move(m_heap[pos]);
+
+        while (pos > 0) {
+            auto parent = (pos - 1) / D;
+            if (!m_compare(m_heap[parent].m_value, moving.m_value))
+                break;
+
+            place(pos, std::move(m_heap[parent]));
+            pos = parent;
+        }
+
+        place(pos, std::move(moving));
+    }
+
+    /**
+     * @brief Moves the element at pos towards the leaves, promoting the highest-ranked of the
+     * (contiguous) children into the hole at each level.
+     */
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::sift_down(size_type pos) {
+        auto size = m_heap.size();
+        auto moving = std::move(m_heap[pos]);
+
+        for (;;) {
+            auto first = pos * D + 1;
+            if (first >= size)
+                break;
+
+            auto last = first + D < size ? first + D : size;
+            auto best = first;
+            for (auto child = first + 1; child < last; ++child) {
+                if (m_compare(m_heap[best].m_value, m_heap[child].m_value))
+                    best = child;
+            }
+
+            if (!m_compare(moving.m_value, m_heap[best].m_value))
+                break;
+
+            place(pos, std::move(m_heap[best]));
+            pos = best;
+        }
+
+        place(pos, std::move(moving));
+    }
+
+    /**
+     * @brief Floyd's bottom-up heap construction: sifts down every internal node, last first,
+     * in O(n) overall.
+     */
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::heapify() {
+        auto size = m_heap.size();
+        if (size < 2)
+            return;
+
+        for (auto pos = (size - 2) / D + 1; pos-- > 0;)
+            sift_down(pos);
+    }
+
+
+    //*** Public ***//
+
+    //* Element Access *//
+
+    template <typename Tp, typename Compare, std::size_t D>
+    typename priority_queue<Tp, Compare, D>::const_reference priority_queue<Tp, Compare, D>::value(const handle h) const {
+        return m_heap[position_of(h)].m_value;
+    }
+
+
+    //* Modifiers *//
+
+    template <typename Tp, typename Compare, std::size_t D>
+    template <class... Args>
+    typename priority_queue<Tp, Compare, D>::handle priority_queue<Tp, Compare, D>::emplace(Args &&...args) {
+        reserve_handle();
+        auto id = acquire_handle();
+
+        try {
+            m_heap.push_back(entry{ Tp(std::forward<Args>(args)...), id });
+        } catch (...) {
+            release_handle(id);
+            throw;
+        }
+
+        sift_up(m_heap.size() - 1);
+        return handle(id);
+    }
+
+    /**
+     * @brief Inserts every element of [first, last). A range at least as long as the queue is
+     * appended and the heap rebuilt with Floyd's method in O(n + k), rather than sifting each
+     * element up in O(k log n). Handles are not returned for a range.
+     */
+    template <typename Tp, typename Compare, std::size_t D>
+    template <class InputIt, typename>
+    void priority_queue<Tp, Compare, D>::push_range(InputIt first, InputIt last) {
+        auto old_size = m_heap.size();
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+            reserve(old_size + static_cast<size_type>(std::distance(first, last)));
+
+        try {
+            for (; first != last; ++first) {
+                reserve_handle();
+                auto id = acquire_handle();
+
+                try {
+                    m_heap.push_back(entry{ Tp(*first), id });
+                } catch (...) {
+                    release_handle(id);
+                    throw;
+                }
+                m_positions[id] = m_heap.size() - 1;
+            }
+        } catch (...) {
+            // Leaves the heap as it was before the range
+            while (m_heap.size() > old_size) {
+                release_handle(m_heap.back().m_handle);
+                m_heap.pop_back();
+            }
+            throw;
+        }
+
+        auto added = m_heap.size() - old_size;
+        if (added >= old_size) {
+            heapify();
+        } else {
+            for (auto pos = old_size; pos < m_heap.size(); ++pos)
+                sift_up(pos);
+        }
+    }
+
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::pop() {
+        if (empty())
+            throw std::out_of_range("Priority queue is empty.");
+
+        release_handle(m_heap[0].m_handle);
+        if (m_heap.size() > 1) {
+            m_heap[0] = std::move(m_heap.back());
+            m_heap.pop_back();
+            sift_down(0);
+        } else {
+            m_heap.pop_back();
+        }
+    }
+
+    /**
+     * @brief Moves the top min(n, size()) elements, in priority order, to out and pops them.
+     */
+    template <typename Tp, typename Compare, std::size_t D>
+    template <class OutputIt>
+    OutputIt priority_queue<Tp, Compare, D>::pop_n(size_type n, OutputIt out) {
+        for (; n && !empty(); --n) {
+            *out = std::move(m_heap[0].m_value);
+            ++out;
+            pop();
+        }
+        return out;
+    }
+
+    /**
+     * @brief Replaces the value of the element at h with one that ranks at least as high, and
+     * moves it towards the top accordingly.
+     */
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::decrease_key(const handle h, const Tp &value) {
+        decrease_key(h, Tp(value));
+    }
+
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::decrease_key(const handle h, Tp &&value) {
+        auto pos = position_of(h);
+        if (m_compare(value, m_heap[pos].m_value))
+            throw std::invalid_argument("decrease_key would lower the priority of the element.");
+
+        m_heap[pos].m_value = std::move(value);
+        sift_up(pos);
+    }
+
+    /**
+     * @brief Replaces the value of the element at h, moving it up or down as needed.
+     */
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::update(const handle h, Tp value) {
+        auto pos = position_of(h);
+        auto lowered = m_compare(value, m_heap[pos].m_value);
+
+        m_heap[pos].m_value = std::move(value);
+        if (lowered)
+            sift_down(pos);
+        else
+            sift_up(pos);
+    }
+
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::clear() noexcept {
+        m_heap.clear();
+        m_positions.clear();
+        m_free.clear();
+    }
+
+    template <typename Tp, typename Compare, std::size_t D>
+    void priority_queue<Tp, Compare, D>::swap(priority_queue &other) {
+        using std::swap;
+        m_heap.swap(other.m_heap);
+        m_positions.swap(other.m_positions);
+        m_free.swap(other.m_free);
+        swap(m_compare, other.m_compare);
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_PRIORITY_QUEUE_H
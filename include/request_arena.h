@@ -0,0 +1,129 @@
+#ifndef DSL_REQUEST_ARENA_H
+#define DSL_REQUEST_ARENA_H
+
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace dsl {
+
+    /**
+     * @brief Owns a monotonic buffer resource together with the containers built on it, and
+     * releases all of them at once, e.g. at the end of a request:
+     *
+     *     dsl::request_arena arena;
+     *     auto &ids = arena.make<dsl::singly_linked_list<std::uint64_t>>();
+     *     ...
+     *     arena.release();    // or let the arena go out of scope
+     *
+     * Containers are constructed inside the arena with an allocator drawing from it, and are
+     * destroyed in reverse order of creation before the memory is returned upstream. The
+     * containers of this library recognize the resource as an arena, so destroying one with
+     * trivially destructible elements does not visit them.
+     *
+     * A request_arena is not thread-safe, like the std::pmr::monotonic_buffer_resource it wraps.
+     */
+    class request_arena {
+    public:
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit request_arena(const std::size_t initial_size = 64 * 1024,
+                               std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+            : m_resource(initial_size, upstream)
+            , m_entries(nullptr)
+        {}
+
+        request_arena(const request_arena&) = delete;
+        request_arena& operator=(const request_arena&) = delete;
+
+
+        //* Destructor *//
+
+        ~request_arena() {
+            release();
+        }
+
+
+        //* Access *//
+
+        [[nodiscard]] std::pmr::memory_resource* resource() noexcept {
+            return &m_resource;
+        }
+
+
+        //* Modifiers *//
+
+        template <class Container, class... Args>
+        Container& make(Args&&...);
+
+        void release() noexcept;
+
+
+    private:
+
+        //*** Member Types ***//
+
+        struct entry {
+            void *m_object;
+            void (*m_destroy)(void*) noexcept;
+            entry *m_next;
+        };
+
+
+        //*** Members ***//
+
+        std::pmr::monotonic_buffer_resource m_resource;
+        entry *m_entries;
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Public ***//
+
+    //* Modifiers *//
+
+    /**
+     * @brief Constructs a Container in the arena from args followed by an allocator drawing from
+     * the arena. The container lives until the next release.
+     */
+    template <class Container, class... Args>
+    Container& request_arena::make(Args &&...args) {
+        using allocator_type = typename Container::allocator_type;
+        static_assert(std::is_constructible_v<allocator_type, std::pmr::memory_resource*>,
+                      "The container must take an allocator constructible from a memory resource.");
+
+        auto record = static_cast<entry*>(m_resource.allocate(sizeof(entry), alignof(entry)));
+        auto storage = m_resource.allocate(sizeof(Container), alignof(Container));
+        auto container = ::new (storage) Container(std::forward<Args>(args)..., allocator_type(&m_resource));
+
+        *record = entry{ container, [](void *object) noexcept { static_cast<Container*>(object)->~Container(); }, m_entries };
+        m_entries = record;
+        return *container;
+    }
+
+    /**
+     * @brief Destroys every container made since the last release, newest first, and returns
+     * all of the arena's memory upstream.
+     */
+    inline void request_arena::release() noexcept {
+        for (auto curr = m_entries; curr; curr = curr->m_next)
+            curr->m_destroy(curr->m_object);
+
+        m_entries = nullptr;
+        m_resource.release();
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_REQUEST_ARENA_H
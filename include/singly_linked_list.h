@@ -2,8 +2,11 @@
 #define DSL_SINGLY_LINKED_LIST_H
 
 
+#include "instrumentation.h"
 #include "list_base.h"
 
+#include <algorithm>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
@@ -12,10 +15,13 @@
 
 namespace dsl {
 
-    template <typename Tp> class singly_linked_list;
+    template <typename Tp, class Allocator = std::pmr::polymorphic_allocator<std::byte>> class singly_linked_list;
+    template <typename Tp, typename Compare> class skip_list;
 
     namespace details {
 
+        struct snapshot_access;
+
         template <typename Tp> struct singly_node;
 
         /**
@@ -32,7 +38,7 @@ namespace dsl {
             singly_node_base(const singly_node_base&) = delete;
             singly_node_base& operator=(const singly_node_base&) = delete;
 
-            singly_node<Tp> *m_next;
+            singly_node_base *m_next;
         };
 
         /**
@@ -71,16 +77,19 @@ namespace dsl {
 
             //*** Member Functions ***//
 
+            singly_const_iterator() noexcept 
+                : m_curr(nullptr) {}
+
             [[nodiscard]] pointer operator->() const noexcept {
-                return std::addressof(m_prev->m_next->m_value);
+                return std::addressof(static_cast<singly_node<Tp>*>(m_curr)->m_value);
             }
 
             [[nodiscard]] reference operator*() const noexcept {
-                return m_prev->m_next->m_value;
+                return static_cast<singly_node<Tp>*>(m_curr)->m_value;
             }
 
             singly_const_iterator& operator++() noexcept {
-                m_prev = m_prev->m_next;
+                m_curr = m_curr->m_next;
                 return *this;
             }
 
@@ -91,7 +100,7 @@ namespace dsl {
             }
 
             bool operator==(const singly_const_iterator &other) const noexcept {
-                return m_prev == other.m_prev;
+                return m_curr == other.m_curr;
             }
 
             bool operator!=(const singly_const_iterator &other) const noexcept {
@@ -99,13 +108,16 @@ namespace dsl {
             }
 
         protected:
-            friend class singly_linked_list<Tp>;
+            template <typename, class> friend class dsl::singly_linked_list;
+
+            // Skip lists keep their level-0 chain in singly_node layout and reuse this iterator
+            template <typename, typename> friend class dsl::skip_list;
 
-            singly_node_base<Tp> *m_prev;
+            singly_node_base<Tp> *m_curr;
 
             // Non-public explicit constructor to enable iterator construction for derived classes and friend classes
-            explicit singly_const_iterator(const singly_node_base<Tp> *prev) 
-                : m_prev(const_cast<singly_node_base<Tp>*>(prev)) {}
+            explicit singly_const_iterator(const singly_node_base<Tp> *curr) noexcept
+                : m_curr(const_cast<singly_node_base<Tp>*>(curr)) {}
         };
 
 
@@ -130,12 +142,15 @@ namespace dsl {
 
             //*** Member Functions ***//
 
+            singly_iterator() noexcept 
+                : singly_const_iterator<Tp>() {}
+
             [[nodiscard]] pointer operator->() const noexcept {
-                return std::addressof(this->m_prev->m_next->m_value);
+                return std::addressof(static_cast<singly_node<Tp>*>(this->m_curr)->m_value);
             }
 
             [[nodiscard]] reference operator*() const noexcept {
-                return this->m_prev->m_next->m_value;
+                return static_cast<singly_node<Tp>*>(this->m_curr)->m_value;
             }
 
             singly_iterator& operator++() noexcept {
@@ -151,36 +166,37 @@ namespace dsl {
 
 
         private:
-            friend class singly_linked_list<Tp>;
+            template <typename, class> friend class dsl::singly_linked_list;
 
-            explicit singly_iterator(const singly_node_base<Tp> *prev)
-                : singly_const_iterator<Tp>(prev) {}
+            explicit singly_iterator(const singly_node_base<Tp> *curr) noexcept
+                : singly_const_iterator<Tp>(curr) {}
         };
 
     }   // namespace details
 
 
     /**
-     * @brief Singly-linked list container. 
+     * @brief Singly-linked list container. Follows the std::forward_list interface, and
+     * additionally tracks its last node so that appending and splicing whole lists is O(1).
      * 
      * @tparam Tp 
      */
-    template <typename Tp>
-    class singly_linked_list : public details::list_base<Tp> {
+    template <typename Tp, class Allocator>
+    class singly_linked_list : public details::list_base<singly_linked_list<Tp, Allocator>, Tp, Allocator> {
     public:
 
         //*** Member Types ***//
 
-        using value_type = typename details::list_base<Tp>::value_type;
-        using size_type = typename details::list_base<Tp>::size_type;
-        using difference_type = typename details::list_base<Tp>::difference_type;
+        using value_type = typename details::list_base<singly_linked_list<Tp, Allocator>, Tp, Allocator>::value_type;
+        using size_type = typename details::list_base<singly_linked_list<Tp, Allocator>, Tp, Allocator>::size_type;
+        using difference_type = typename details::list_base<singly_linked_list<Tp, Allocator>, Tp, Allocator>::difference_type;
     
-        using reference = typename details::list_base<Tp>::reference;
-        using const_reference = typename details::list_base<Tp>::const_reference;
+        using reference = typename details::list_base<singly_linked_list<Tp, Allocator>, Tp, Allocator>::reference;
+        using const_reference = typename details::list_base<singly_linked_list<Tp, Allocator>, Tp, Allocator>::const_reference;
 
-        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
-        using pointer = std::allocator_traits<allocator_type>::pointer;
-        using const_pointer = std::allocator_traits<allocator_type>::const_pointer;
+        using allocator_type = Allocator;
+        using pointer = typename std::allocator_traits<allocator_type>::pointer;
+        using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
 
         using iterator = typename details::singly_iterator<Tp>;
         using const_iterator = typename details::singly_const_iterator<Tp>;
@@ -191,25 +207,24 @@ namespace dsl {
         //* Constructors *//
 
         explicit singly_linked_list(allocator_type allocator = {})
-            : details::list_base<Tp>()
-            , m_allocator(allocator)
+            : details::list_base<singly_linked_list<Tp, Allocator>, Tp, Allocator>(allocator)
             , m_head()
-            , m_tail(nullptr)
+            , m_tail(&m_head)
         {}
 
         singly_linked_list(const size_type count,
                            const Tp& value,
                            allocator_type allocator = {})
             : singly_linked_list(allocator)
-        { assign(count, value); }
+        { insert_after(before_begin(), count, value); }
 
         explicit singly_linked_list(const size_type count, 
                                     allocator_type allocator = {})
-            : singly_linked_list(count, Tp(), allocator)
-        {}
+            : singly_linked_list(allocator)
+        { resize(count); }
 
 
-        template <class InputIt>
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
         singly_linked_list(InputIt first, InputIt last,
                            allocator_type allocator = {})
             : singly_linked_list(allocator)
@@ -218,16 +233,16 @@ namespace dsl {
 
         singly_linked_list(std::initializer_list<Tp> init, 
                            allocator_type allocator = {})
-            : singly_linked_list(init.before_begin(), init.end(), allocator)
+            : singly_linked_list(init.begin(), init.end(), allocator)
         {}
 
 
         //* Copy Constructors *//
 
         singly_linked_list(const singly_linked_list &other,
-                           allocator_type allocator = {})
-            : singly_linked_list(other.size(), allocator)
-        { operator=(other); }
+                           allocator_type allocator)
+            : singly_linked_list(allocator)
+        { try_copy(other); }
             
         singly_linked_list(const singly_linked_list &other)
             : singly_linked_list(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator()))
@@ -238,12 +253,12 @@ namespace dsl {
 
         singly_linked_list(singly_linked_list &&other, 
                            allocator_type allocator)
-            : singly_linked_list(other.size(), allocator)
+            : singly_linked_list(allocator)
         { operator=(std::move(other)); }
 
-        singly_linked_list(singly_linked_list &&other) 
-            : singly_linked_list(other, other.get_allocator())
-        {}
+        singly_linked_list(singly_linked_list &&other) noexcept
+            : singly_linked_list(other.get_allocator())
+        { swap(other); }
 
 
         //* Destructor *//
@@ -262,7 +277,7 @@ namespace dsl {
         
         void assign(const size_type, const Tp&);
         
-        template <class InputIt>
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
         void assign(InputIt, InputIt);
 
         void assign(std::initializer_list<Tp>);
@@ -273,11 +288,11 @@ namespace dsl {
         //* Element Access *//
 
         reference front() {
-            return m_head.m_next->m_value;
+            return static_cast<node_t*>(m_head.m_next)->m_value;
         }
 
         const_reference front() const {
-            return m_head.m_next->m_value;
+            return static_cast<node_t*>(m_head.m_next)->m_value;
         }
 
 
@@ -308,15 +323,15 @@ namespace dsl {
         }
 
         iterator end() noexcept {
-            return iterator(m_tail);
+            return iterator(nullptr);
         }
 
         const_iterator end() const noexcept {
-            return const_iterator(m_tail);
+            return const_iterator(nullptr);
         }
 
         const_iterator cend() const noexcept {
-            return const_iterator(m_tail);
+            return const_iterator(nullptr);
         }
 
 
@@ -328,7 +343,7 @@ namespace dsl {
         iterator insert_after(const_iterator, Tp&&);
         iterator insert_after(const_iterator, const size_type, const Tp&);
         
-        template <class InputIt>
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
         iterator insert_after(const_iterator, InputIt, InputIt);
 
         iterator insert_after(const_iterator, std::initializer_list<Tp>);
@@ -342,9 +357,6 @@ namespace dsl {
         void push_front(const Tp&);
         void push_front(Tp&&);
 
-        template <class... Args>
-        void emplace_front(Args&&...);
-
         template <class... Args>
         reference emplace_front(Args&&...);
 
@@ -353,20 +365,67 @@ namespace dsl {
         void resize(const size_type);
         void resize(const size_type, const Tp&);
 
-        void swap(singly_linked_list&) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value);
+        void swap(singly_linked_list&) noexcept(std::allocator_traits<allocator_type>::propagate_on_container_swap::value || 
+                                                std::allocator_traits<allocator_type>::is_always_equal::value);
+
+
+        //* Operations *//
+
+        void splice_after(const_iterator, singly_linked_list&);
+        void splice_after(const_iterator, singly_linked_list&&);
+        void splice_after(const_iterator, singly_linked_list&, const_iterator);
+        void splice_after(const_iterator, singly_linked_list&&, const_iterator);
+        void splice_after(const_iterator, singly_linked_list&, const_iterator, const_iterator);
+        void splice_after(const_iterator, singly_linked_list&&, const_iterator, const_iterator);
+
+        void merge(singly_linked_list&);
+        void merge(singly_linked_list&&);
+
+        template <class Compare>
+        void merge(singly_linked_list&, Compare);
+
+        template <class Compare>
+        void merge(singly_linked_list&&, Compare);
+
+        void sort();
+
+        template <class Compare>
+        void sort(Compare);
+
+        void reverse() noexcept;
+
+        size_type unique();
+
+        template <class BinaryPredicate>
+        size_type unique(BinaryPredicate);
+
+
+        //* Memory Layout *//
+
+        void compact();
+        void compact(allocator_type);
+
+        [[nodiscard]] double fragmentation() const noexcept;
 
 
     private:
 
+        friend struct details::snapshot_access;
+
         //* Using Directives *//
 
         using node_base_t = typename details::singly_node_base<Tp>;
         using node_t = typename details::singly_node<Tp>;
 
+        using alloc_traits = std::allocator_traits<allocator_type>;
+        using node_allocator_type = typename alloc_traits::template rebind_alloc<node_t>;
+        using node_traits = std::allocator_traits<node_allocator_type>;
+
+        static_assert(std::is_same_v<typename node_traits::pointer, node_t*>, "dsl::singly_linked_list requires an allocator with raw pointers.");
+
 
         //* Members *//
 
-        allocator_type m_allocator;
         node_base_t  m_head;
         node_base_t *m_tail;
 
@@ -375,8 +434,24 @@ namespace dsl {
 
         void try_copy(const singly_linked_list&);
         void try_move(singly_linked_list&&);
+        void swap_nodes(singly_linked_list&) noexcept;
         void resize_erase(const size_type);
         void resize_emplace(const size_type, const Tp&);
+
+        template <class... Args>
+        node_t* create_node(Args&&...);
+        void destroy_node(node_base_t*) noexcept;
+
+        static node_t* allocate_node(allocator_type&);
+        static void deallocate_node(node_base_t*, allocator_type&) noexcept;
+
+        void link_after(node_base_t*, node_base_t*, node_base_t*) noexcept;
+
+        template <class Compare>
+        static node_base_t* merge_chains(node_base_t*, node_base_t*, Compare&);
+
+        static size_type deallocate_chain(node_base_t*, allocator_type&) noexcept;
+        void rebind_allocator(const allocator_type&) noexcept;
     };
 
 
@@ -385,33 +460,143 @@ namespace dsl {
 
     //*** Private ***//
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::try_copy(const singly_linked_list<Tp> &other) {
-        clear();
-        for (const Tp& value : other) 
-            insert_after(end(), value);
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::try_copy(const singly_linked_list<Tp, Allocator> &other) {
+        assign(other.begin(), other.end());
     }
 
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::try_move(singly_linked_list &&other) {
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::try_move(singly_linked_list &&other) {
         clear();
-        swap(other);
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            this->replace_allocator(other.allocator_ref());
+        swap_nodes(other);
     }
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::resize_erase(const size_type count) {
-        auto first = std::advance(begin(), count);
-        erase_after(first, end());
+    /**
+     * @brief Exchanges the nodes of two lists whose allocators are known to be interchangeable.
+     */
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::swap_nodes(singly_linked_list &other) noexcept {
+        auto tail = other.empty() ? &m_head : other.m_tail;
+        auto other_tail = this->empty() ? &other.m_head : m_tail;
+
+        using std::swap;
+        swap(m_head.m_next, other.m_head.m_next);
+        swap(this->m_size, other.m_size);
+        m_tail = tail;
+        other.m_tail = other_tail;
     }
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::resize_emplace(const size_type count, const Tp &value) {
-        auto it = end();
-        while (count > 0) {
-            it = emplace_after(it, value);
-            --count;
-        }    
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::resize_erase(const size_type count) {
+        auto last = std::next(before_begin(), count);
+        details::record_event(this, container_event::traversal, count);
+        erase_after(last, end());
+    }
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::resize_emplace(const size_type count, const Tp &value) {
+        insert_after(const_iterator(m_tail), count - this->m_size, value);
+    }
+
+    template <typename Tp, class Allocator>
+    template <class... Args>
+    typename singly_linked_list<Tp, Allocator>::node_t* singly_linked_list<Tp, Allocator>::create_node(Args &&...args) {
+        auto node = allocate_node(this->allocator_ref());
+        
+        try {
+            alloc_traits::construct(this->allocator_ref(), std::addressof(node->m_value), std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate_node(node, this->allocator_ref());
+            throw;
+        }
+
+        details::record_event(this, container_event::node_allocation, sizeof(node_t));
+        return node;
+    }
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::destroy_node(node_base_t *node) noexcept {
+        auto pNode = static_cast<node_t*>(node);
+        alloc_traits::destroy(this->allocator_ref(), std::addressof(pNode->m_value));
+        deallocate_node(pNode, this->allocator_ref());
+        details::record_event(this, container_event::node_deallocation, sizeof(node_t));
+    }
+
+    /**
+     * @brief Links the detached chain first..last after pos, moving the tail if pos was the last node.
+     */
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::link_after(node_base_t *pos, node_base_t *first, node_base_t *last) noexcept {
+        last->m_next = pos->m_next;
+        pos->m_next = first;
+
+        if (pos == m_tail) 
+            m_tail = last;
+    }
+
+    /**
+     * @brief Merges two null-terminated chains that are sorted with respect to comp by relinking
+     * their nodes. Elements of lhs precede equivalent elements of rhs.
+     */
+    template <typename Tp, class Allocator>
+    template <class Compare>
+    typename singly_linked_list<Tp, Allocator>::node_base_t* singly_linked_list<Tp, Allocator>::merge_chains(node_base_t *lhs, node_base_t *rhs, Compare &comp) {
+        node_base_t head;
+        auto tail = &head;
+
+        while (lhs && rhs) {
+            if (comp(static_cast<node_t*>(rhs)->m_value, static_cast<node_t*>(lhs)->m_value)) {
+                tail->m_next = rhs;
+                rhs = rhs->m_next;
+            } else {
+                tail->m_next = lhs;
+                lhs = lhs->m_next;
+            }
+            tail = tail->m_next;
+        }
+
+        tail->m_next = lhs ? lhs : rhs;
+        return head.m_next;
+    }
+
+    template <typename Tp, class Allocator>
+    typename singly_linked_list<Tp, Allocator>::node_t* singly_linked_list<Tp, Allocator>::allocate_node(allocator_type &allocator) {
+        node_allocator_type node_allocator(allocator);
+        return node_traits::allocate(node_allocator, 1);
+    }
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::deallocate_node(node_base_t *node, allocator_type &allocator) noexcept {
+        node_allocator_type node_allocator(allocator);
+        node_traits::deallocate(node_allocator, static_cast<node_t*>(node), 1);
+    }
+
+    /**
+     * @brief Releases the raw storage of a null-terminated chain of nodes whose values are not constructed,
+     * and returns the number of nodes released.
+     */
+    template <typename Tp, class Allocator>
+    typename singly_linked_list<Tp, Allocator>::size_type singly_linked_list<Tp, Allocator>::deallocate_chain(node_base_t *node, allocator_type &allocator) noexcept {
+        size_type count = 0;
+        while (node) {
+            auto next = node->m_next;
+            deallocate_node(node, allocator);
+            node = next;
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Replaces the allocator once every node has been moved to memory obtained from the new one.
+     */
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::rebind_allocator(const allocator_type &allocator) noexcept {
+        if (this->allocator_ref() != allocator) 
+            this->replace_allocator(allocator);
     }
 
 
@@ -419,20 +604,28 @@ namespace dsl {
 
     //* Assignment Operator Overloads *//
 
-    template <typename Tp>
-    singly_linked_list<Tp>& singly_linked_list<Tp>::operator=(const singly_linked_list<Tp> &other) {
-        if (this != &other) 
+    template <typename Tp, class Allocator>
+    singly_linked_list<Tp, Allocator>& singly_linked_list<Tp, Allocator>::operator=(const singly_linked_list<Tp, Allocator> &other) {
+        if (this != &other) {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (this->allocator_ref() != other.allocator_ref()) 
+                    clear();
+                this->replace_allocator(other.allocator_ref());
+            }
             try_copy(other);
+        }
         return *this;
     }
 
-    template <typename Tp>
-    singly_linked_list<Tp>& singly_linked_list<Tp>::operator=(singly_linked_list<Tp> &&other) {
-        if (this != other) {
-            if (m_allocator == other.m_allocator) 
+    template <typename Tp, class Allocator>
+    singly_linked_list<Tp, Allocator>& singly_linked_list<Tp, Allocator>::operator=(singly_linked_list<Tp, Allocator> &&other) {
+        if (this != &other) {
+            if (alloc_traits::propagate_on_container_move_assignment::value || this->allocator_ref() == other.allocator_ref()) {
                 try_move(std::move(other));
-            else 
-                operator=(other);   // copy assignment
+            } else {
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+            }
         }
         return *this;
     }
@@ -440,196 +633,487 @@ namespace dsl {
 
     //* Assign and allocator access *//
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::assign(const size_type count, const Tp& value) {
-        resize(count);
-        for (auto it = begin(); it != end(); ++it) 
-            *it = value;
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::assign(const size_type count, const Tp& value) {
+        auto prev = before_begin();
+        size_type i = 0;
+        for (; i < count && std::next(prev) != end(); ++i, ++prev) 
+            *std::next(prev) = value;
+
+        if (i < count) 
+            insert_after(prev, count - i, value);
+        else 
+            erase_after(prev, end());
     }
 
-    template <typename Tp>
-    template <class InputIt>
-    void singly_linked_list<Tp>::assign(InputIt first, InputIt last) {
-        resize(std::distance(first, last));
-        auto it = begin();
-        for (; first != last && it != end(); ++first)
-            *it = *first;
+    template <typename Tp, class Allocator>
+    template <class InputIt, typename>
+    void singly_linked_list<Tp, Allocator>::assign(InputIt first, InputIt last) {
+        auto prev = before_begin();
+        for (; first != last && std::next(prev) != end(); ++first, ++prev)
+            *std::next(prev) = *first;
+
+        if (first != last) 
+            insert_after(prev, first, last);
+        else 
+            erase_after(prev, end());
     }
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::assign(std::initializer_list<Tp> ilist) {
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::assign(std::initializer_list<Tp> ilist) {
         assign(ilist.begin(), ilist.end());
     }
 
-    template <typename Tp>
-    typename singly_linked_list<Tp>::allocator_type singly_linked_list<Tp>::get_allocator() const noexcept {
-        return m_allocator;
+    template <typename Tp, class Allocator>
+    typename singly_linked_list<Tp, Allocator>::allocator_type singly_linked_list<Tp, Allocator>::get_allocator() const noexcept {
+        return this->allocator_ref();
     }
 
 
     //* Modifiers *//
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::clear() noexcept {
+    /**
+     * @brief Destroys every element. Trivially destructible elements allocated from an arena are
+     * dropped in O(1) by detaching the chain, as deallocating their nodes would be a no-op.
+     */
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::clear() noexcept {
+        if constexpr (std::is_trivially_destructible_v<Tp>) {
+            if (!this->empty() && details::is_arena(this->allocator_ref())) {
+                m_head.m_next = nullptr;
+                m_tail = &m_head;
+                // One event per dropped node, so that instrumentation counters stay balanced; the loop
+                // compiles away when the container is not instrumented
+                for (size_type i = 0; i < this->m_size; ++i) 
+                    details::record_event(this, container_event::node_deallocation, sizeof(node_t));
+                this->m_size = 0;
+                return;
+            }
+        }
+
         erase_after(before_begin(), end());
     }
 
-    template <typename Tp>
-    typename singly_linked_list<Tp>::iterator singly_linked_list<Tp>::insert_after(const_iterator pos, const Tp &value) {
+    template <typename Tp, class Allocator>
+    typename singly_linked_list<Tp, Allocator>::iterator singly_linked_list<Tp, Allocator>::insert_after(const_iterator pos, const Tp &value) {
         return emplace_after(pos, value);
     }
 
-    template <typename Tp>
-    typename singly_linked_list<Tp>::iterator singly_linked_list<Tp>::insert_after(const_iterator pos, Tp &&value) {
+    template <typename Tp, class Allocator>
+    typename singly_linked_list<Tp, Allocator>::iterator singly_linked_list<Tp, Allocator>::insert_after(const_iterator pos, Tp &&value) {
         return emplace_after(pos, std::move(value));
     }
 
-    template <typename Tp>
-    typename singly_linked_list<Tp>::iterator singly_linked_list<Tp>::insert_after(const_iterator pos, const size_type count, const Tp &value) {
-        auto it = dynamic_cast<iterator>(pos);
-        for (auto i = 0; i < count; ++i) 
-            it = emplace_after(pos, value);
+    template <typename Tp, class Allocator>
+    typename singly_linked_list<Tp, Allocator>::iterator singly_linked_list<Tp, Allocator>::insert_after(const_iterator pos, const size_type count, const Tp &value) {
+        auto it = iterator(pos.m_curr);
+        for (size_type i = 0; i < count; ++i) 
+            it = emplace_after(it, value);
         return it;
     }
 
-    template <typename Tp>
-    template <class InputIt>
-    typename singly_linked_list<Tp>::iterator singly_linked_list<Tp>::insert_after(const_iterator pos, InputIt first, InputIt last) {
-        auto it = dynamic_cast<iterator>(pos);
+    template <typename Tp, class Allocator>
+    template <class InputIt, typename>
+    typename singly_linked_list<Tp, Allocator>::iterator singly_linked_list<Tp, Allocator>::insert_after(const_iterator pos, InputIt first, InputIt last) {
+        auto it = iterator(pos.m_curr);
         for (; first != last; ++first) 
             it = emplace_after(it, *first);
         return it;
     }
 
-    template <typename Tp>
-    typename singly_linked_list<Tp>::iterator singly_linked_list<Tp>::insert_after(const_iterator pos, std::initializer_list<Tp> ilist) {
+    template <typename Tp, class Allocator>
+    typename singly_linked_list<Tp, Allocator>::iterator singly_linked_list<Tp, Allocator>::insert_after(const_iterator pos, std::initializer_list<Tp> ilist) {
         return insert_after(pos, ilist.begin(), ilist.end());
     }
 
-    template <typename Tp>
+    template <typename Tp, class Allocator>
     template <class... Args>
-    typename singly_linked_list<Tp>::iterator singly_linked_list<Tp>::emplace_after(const_iterator pos, Args &&...args) {
-        auto node = static_cast<node_t*>(m_allocator.resource()->allocate(sizeof(node_t), alignof(node_t)));
-        
-        try {
-            m_allocator.construct(std::addressof(node->m_value), std::forward<Args>(args)...);
-        } catch (...) {
-            m_allocator.resource()->deallocate(node, sizeof(node_t), alignof(node_t));
-            throw;
+    typename singly_linked_list<Tp, Allocator>::iterator singly_linked_list<Tp, Allocator>::emplace_after(const_iterator pos, Args &&...args) {
+        node_base_t *node = create_node(std::forward<Args>(args)...);
+        if constexpr (instrumentation_policy<singly_linked_list<Tp, Allocator>>::enabled) {
+            // Only the ends have a known index without a walk
+            auto position = pos.m_curr == &m_head ? 0 : pos.m_curr == m_tail ? this->m_size : unknown_position;
+            details::record_event(this, container_event::insertion, this->m_size + 1, position);
         }
-
-        // Note: pos.m_prev->m_next gets the node at the current iterator position
-        node->m_next = pos.m_prev->m_next;
-        pos.m_prev->m_next = node;
-
-        if (pos.m_prev == m_tail) 
-            m_tail = node;
+        link_after(pos.m_curr, node, node);
 
         ++this->m_size;
-        return dynamic_cast<iterator>(pos);
+        return iterator(node);
     }
 
-    template <typename Tp>
-    typename singly_linked_list<Tp>::iterator singly_linked_list<Tp>::erase_after(const_iterator pos) {
-        return (pos, std::next(pos));
+    template <typename Tp, class Allocator>
+    typename singly_linked_list<Tp, Allocator>::iterator singly_linked_list<Tp, Allocator>::erase_after(const_iterator pos) {
+        return erase_after(pos, std::next(pos, 2));
     }
 
-    template <typename Tp>
-    typename singly_linked_list<Tp>::iterator singly_linked_list<Tp>::erase_after(const_iterator first, const_iterator last) {
-        auto next = first.m_prev->m_next;
-        auto past = last.m_prev->m_next;
+    template <typename Tp, class Allocator>
+    typename singly_linked_list<Tp, Allocator>::iterator singly_linked_list<Tp, Allocator>::erase_after(const_iterator first, const_iterator last) {
+        auto next = first.m_curr->m_next;
+        auto past = last.m_curr;
 
         if (past == nullptr) 
-            m_tail = first.m_prev;
+            m_tail = first.m_curr;
 
-        first.m_prev->m_next = past;
+        first.m_curr->m_next = past;
 
         while (next != past) {
             auto old = next;
             next = next->m_next;
             --this->m_size;
-            std::allocator_traits<allocator_type>::destroy(m_allocator, std::addressof(old->m_value));
-            m_allocator.resource()->deallocate(old, sizeof(node_t), alignof(node_t));
+            destroy_node(old);
         }
 
-        return dynamic_cast<iterator>(first);
+        return iterator(past);
     }
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::push_front(const Tp &value) {
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::push_front(const Tp &value) {
         emplace_front(value);
     }
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::push_front(Tp &&value) {
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::push_front(Tp &&value) {
         emplace_front(std::move(value));
     }
 
-    template <typename Tp>
-    template <class... Args>
-    void singly_linked_list<Tp>::emplace_front(Args &&...args) {
-        emplace_after(before_begin(), std::forward<Args>(args)...);
-    }
-
-    template <typename Tp>
+    template <typename Tp, class Allocator>
     template <class... Args>
-    typename singly_linked_list<Tp>::reference singly_linked_list<Tp>::emplace_front(Args &&...args) {
+    typename singly_linked_list<Tp, Allocator>::reference singly_linked_list<Tp, Allocator>::emplace_front(Args &&...args) {
         auto it = emplace_after(before_begin(), std::forward<Args>(args)...);
         return *it;
     }
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::pop_front() {
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::pop_front() {
         erase_after(before_begin());
     }
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::resize(const size_type count) {
-        if (count < this->m_size)         // need to erase elements
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::resize(const size_type count) {
+        if (count < this->m_size) {        // need to erase elements
             resize_erase(count);
-        else if (count > this->m_size)    // need to add elements
-            resize_emplace(count, Tp());
-        this->m_size = count;
+        } else {                           // need to add elements
+            auto it = iterator(m_tail);
+            while (this->m_size < count) 
+                it = emplace_after(it);
+        }
     }
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::resize(const size_type count, const Tp &value) {
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::resize(const size_type count, const Tp &value) {
         if (count < this->m_size) 
             resize_erase(count);
         else if (count > this->m_size) 
             resize_emplace(count, value);
-        this->m_size = count;
     }
 
-    template <typename Tp>
-    void singly_linked_list<Tp>::swap(singly_linked_list<Tp> &other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
-        if (m_allocator == other.m_allocator) {
-            auto tail = other.empty() ? &m_head : other.m_tail;
-            auto other_tail = this->empty() ? &other.m_head : m_tail;
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::swap(singly_linked_list<Tp, Allocator> &other) noexcept(std::allocator_traits<allocator_type>::propagate_on_container_swap::value || 
+                                                                                                    std::allocator_traits<allocator_type>::is_always_equal::value) {
+        if (this != &other && (alloc_traits::propagate_on_container_swap::value || this->allocator_ref() == other.allocator_ref())) {
+            if constexpr (alloc_traits::propagate_on_container_swap::value)
+                this->swap_allocator(other);
+            swap_nodes(other);
+        }
+    }
+
+
+    //* Operations *//
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::splice_after(const_iterator pos, singly_linked_list<Tp, Allocator> &other) {
+        if (this == &other || other.empty()) 
+            return;
+
+        // The tail of other is known, so the whole chain is moved in O(1)
+        auto first = other.m_head.m_next;
+        auto last = other.m_tail;
+        other.m_head.m_next = nullptr;
+        other.m_tail = &other.m_head;
+
+        link_after(pos.m_curr, first, last);
+        this->m_size += other.m_size;
+        other.m_size = 0;
+    }
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::splice_after(const_iterator pos, singly_linked_list<Tp, Allocator> &&other) {
+        splice_after(pos, other);
+    }
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::splice_after(const_iterator pos, singly_linked_list<Tp, Allocator> &other, const_iterator it) {
+        auto node = it.m_curr->m_next;
+        if (pos == it || pos.m_curr == node) 
+            return;
+
+        it.m_curr->m_next = node->m_next;
+        if (other.m_tail == node) 
+            other.m_tail = it.m_curr;
+
+        link_after(pos.m_curr, node, node);
+        --other.m_size;
+        ++this->m_size;
+    }
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::splice_after(const_iterator pos, singly_linked_list<Tp, Allocator> &&other, const_iterator it) {
+        splice_after(pos, other, it);
+    }
+
+    /**
+     * @brief Moves the nodes in the open range (first, last) of other after pos. The range is
+     * walked once to find its last node, as a singly-linked node cannot reach its predecessor.
+     */
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::splice_after(const_iterator pos, singly_linked_list<Tp, Allocator> &other, const_iterator first, const_iterator last) {
+        if (first.m_curr->m_next == last.m_curr || pos == first) 
+            return;
+
+        size_type count = 1;
+        auto range_first = first.m_curr->m_next;
+        auto range_last = range_first;
+        while (range_last->m_next != last.m_curr) {
+            range_last = range_last->m_next;
+            ++count;
+        }
+
+        details::record_event(this, container_event::traversal, count);
+        first.m_curr->m_next = last.m_curr;
+        if (other.m_tail == range_last) 
+            other.m_tail = first.m_curr;
+
+        link_after(pos.m_curr, range_first, range_last);
+        other.m_size -= count;
+        this->m_size += count;
+    }
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::splice_after(const_iterator pos, singly_linked_list<Tp, Allocator> &&other, const_iterator first, const_iterator last) {
+        splice_after(pos, other, first, last);
+    }
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::merge(singly_linked_list<Tp, Allocator> &other) {
+        merge(other, std::less<>());
+    }
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::merge(singly_linked_list<Tp, Allocator> &&other) {
+        merge(other, std::less<>());
+    }
+
+    /**
+     * @brief Merges the sorted list other into this sorted list by relinking nodes, without
+     * copying or allocating. Elements of *this precede equivalent elements of other.
+     */
+    template <typename Tp, class Allocator>
+    template <class Compare>
+    void singly_linked_list<Tp, Allocator>::merge(singly_linked_list<Tp, Allocator> &other, Compare comp) {
+        if (this == &other || other.empty()) 
+            return;
+
+        // If every element of other sorts after the last element here, append in O(1)
+        if (this->empty() || !comp(other.front(), static_cast<node_t*>(m_tail)->m_value)) {
+            splice_after(const_iterator(m_tail), other);
+            return;
+        }
+
+        m_head.m_next = merge_chains(m_head.m_next, other.m_head.m_next, comp);
+        if (!comp(static_cast<node_t*>(other.m_tail)->m_value, static_cast<node_t*>(m_tail)->m_value)) 
+            m_tail = other.m_tail;
+
+        this->m_size += other.m_size;
+        other.m_head.m_next = nullptr;
+        other.m_tail = &other.m_head;
+        other.m_size = 0;
+    }
+
+    template <typename Tp, class Allocator>
+    template <class Compare>
+    void singly_linked_list<Tp, Allocator>::merge(singly_linked_list<Tp, Allocator> &&other, Compare comp) {
+        merge(other, comp);
+    }
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::sort() {
+        sort(std::less<>());
+    }
+
+    /**
+     * @brief Stable bottom-up merge sort. Nodes are relinked in place, so no element is copied or 
+     * moved and no memory is allocated; the pending runs are held in a fixed array of chain heads
+     * where bin i holds a sorted run of 2^i nodes.
+     */
+    template <typename Tp, class Allocator>
+    template <class Compare>
+    void singly_linked_list<Tp, Allocator>::sort(Compare comp) {
+        if (this->m_size < 2) 
+            return;
+
+        node_base_t *bins[64] = {};
+        std::size_t fill = 0;
+        auto node = m_head.m_next;
+
+        while (node) {
+            auto carry = node;
+            node = node->m_next;
+            carry->m_next = nullptr;
+
+            // Older runs sit in the bins, so they are passed first to keep the sort stable
+            std::size_t i = 0;
+            for (; i < fill && bins[i]; ++i) {
+                carry = merge_chains(bins[i], carry, comp);
+                bins[i] = nullptr;
+            }
 
-            using std::swap;
-            swap(m_head.m_next, other.m_head.m_next);
-            swap(this->m_size, other.m_size);
-            m_tail = tail;
-            other.m_tail = other_tail;
+            bins[i] = carry;
+            if (i == fill) 
+                ++fill;
         }
+
+        node_base_t *result = nullptr;
+        for (std::size_t i = 0; i < fill; ++i) 
+            if (bins[i]) 
+                result = merge_chains(bins[i], result, comp);
+
+        m_head.m_next = result;
+        
+        m_tail = &m_head;
+        while (m_tail->m_next) 
+            m_tail = m_tail->m_next;
     }
 
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::reverse() noexcept {
+        node_base_t *prev = nullptr;
+        auto node = m_head.m_next;
+        
+        if (node) 
+            m_tail = node;
 
-    //*** Non-Member Function Implementations ***//
+        while (node) {
+            auto next = node->m_next;
+            node->m_next = prev;
+            prev = node;
+            node = next;
+        }
 
-    template <typename Tp>
-    bool operator==(const singly_linked_list<Tp> &lhs, const singly_linked_list<Tp> &rhs) noexcept {
-        return (lhs.size() != rhs.size()) ? false : std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        m_head.m_next = prev;
     }
 
-    template <typename Tp>
-    bool operator!=(const singly_linked_list<Tp> &lhs, const singly_linked_list<Tp> &rhs) noexcept {
-        return !operator==(lhs, rhs);
+    template <typename Tp, class Allocator>
+    typename singly_linked_list<Tp, Allocator>::size_type singly_linked_list<Tp, Allocator>::unique() {
+        return unique(std::equal_to<>());
     }
 
+    template <typename Tp, class Allocator>
+    template <class BinaryPredicate>
+    typename singly_linked_list<Tp, Allocator>::size_type singly_linked_list<Tp, Allocator>::unique(BinaryPredicate pred) {
+        auto old_size = this->m_size;
+        if (this->m_size < 2) 
+            return 0;
+
+        auto first = begin();
+        auto next = std::next(first);
+
+        while (next != end()) {
+            if (pred(*first, *next)) {
+                next = erase_after(first);
+            } else {
+                first = next;
+                ++next;
+            }
+        }
+
+        return old_size - this->m_size;
+    }
+
+
+    //* Memory Layout *//
+
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::compact() {
+        compact(this->allocator_ref());
+    }
+
+    /**
+     * @brief Reallocates every node from allocator in iteration order and relinks them, so that a
+     * traversal walks memory sequentially again. All new nodes are obtained before any old node is
+     * released, which keeps the allocator from recycling the scattered holes; with a fresh
+     * std::pmr::monotonic_buffer_resource or unsynchronized_pool_resource the nodes end up
+     * contiguous. The list adopts allocator afterwards. Invalidates all iterators and references.
+     *
+     * Provides the strong exception guarantee unless moving Tp may throw and Tp is not copyable.
+     */
+    template <typename Tp, class Allocator>
+    void singly_linked_list<Tp, Allocator>::compact(allocator_type allocator) {
+        node_base_t chain;
+        node_base_t *tail = &chain;
+        chain.m_next = nullptr;
+
+        // Obtain every node up front, so that once values start moving only a throwing copy can fail
+        try {
+            for (size_type i = 0; i < this->m_size; ++i) {
+                auto node = allocate_node(allocator);
+                details::record_event(this, container_event::node_allocation, sizeof(node_t));
+                node->m_next = nullptr;
+                tail->m_next = node;
+                tail = node;
+            }
+        } catch (...) {
+            for (auto count = deallocate_chain(chain.m_next, allocator); count; --count) 
+                details::record_event(this, container_event::node_deallocation, sizeof(node_t));
+            throw;
+        }
+
+        auto dest = chain.m_next;
+        size_type built = 0;
+        try {
+            for (auto src = m_head.m_next; built < this->m_size; src = src->m_next, dest = dest->m_next, ++built) 
+                alloc_traits::construct(allocator, std::addressof(static_cast<node_t*>(dest)->m_value), 
+                                        std::move_if_noexcept(static_cast<node_t*>(src)->m_value));
+        } catch (...) {
+            dest = chain.m_next;
+            for (size_type i = 0; i < built; ++i, dest = dest->m_next) 
+                alloc_traits::destroy(allocator, std::addressof(static_cast<node_t*>(dest)->m_value));
+            for (auto count = deallocate_chain(chain.m_next, allocator); count; --count) 
+                details::record_event(this, container_event::node_deallocation, sizeof(node_t));
+            throw;
+        }
+
+        auto src = m_head.m_next;
+        for (size_type i = 0; i < this->m_size; ++i) {
+            auto old = src;
+            src = src->m_next;
+            destroy_node(old);
+        }
+
+        m_head.m_next = chain.m_next;
+        m_tail = this->m_size ? tail : &m_head;
+        rebind_allocator(allocator);
+    }
+
+    /**
+     * @brief Estimates how far the node order diverges from address order, as the fraction of links
+     * whose target does not directly follow the current node in memory. Returns 0 for a perfectly
+     * sequential layout and approaches 1 when every hop lands somewhere unrelated.
+     */
+    template <typename Tp, class Allocator>
+    double singly_linked_list<Tp, Allocator>::fragmentation() const noexcept {
+        if (this->m_size < 2) 
+            return 0.0;
+
+        size_type jumps = 0;
+        auto node = m_head.m_next;
+        for (size_type i = 1; i < this->m_size; ++i, node = node->m_next) 
+            if (!details::is_sequential(node, node->m_next, sizeof(node_t))) 
+                ++jumps;
+
+        return static_cast<double>(jumps) / static_cast<double>(this->m_size - 1);
+    }
 
 }   // namespace dsl
 
 
-#endif // DSL_SINGLY_LINKED_LIST_H
\ No newline at end of file
+#endif // DSL_SINGLY_LINKED_LIST_H
@@ -0,0 +1,589 @@
+#ifndef DSL_SKIP_LIST_H
+#define DSL_SKIP_LIST_H
+
+
+#include "list_base.h"
+#include "singly_linked_list.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+
+namespace dsl {
+
+    namespace details {
+
+        /**
+         * @brief Node in a skip list. Derives the singly-linked node so that the level-0 chain can be
+         * traversed with singly-linked iterators. The links for levels 1 to m_height - 1 are stored
+         * inline, directly after the node, in the same allocation.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        struct skip_node : singly_node<Tp> {
+            std::uint8_t m_height;
+
+            singly_node_base<Tp>** tower() noexcept {
+                return reinterpret_cast<singly_node_base<Tp>**>(reinterpret_cast<std::byte*>(this) + sizeof(skip_node));
+            }
+
+            static std::size_t allocation_size(const std::size_t height) noexcept {
+                return sizeof(skip_node) + (height - 1) * sizeof(singly_node_base<Tp>*);
+            }
+        };
+
+        /**
+         * @brief Draws skip list node heights with a xorshift64* generator, so that each additional
+         * level is taken with probability 1/4.
+         */
+        class skip_height_generator {
+        public:
+            explicit skip_height_generator(std::uint64_t seed) noexcept {
+                // splitmix64 finalizer, so that nearby seeds still give unrelated sequences
+                seed += 0x9E3779B97F4A7C15ull;
+                seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ull;
+                seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBull;
+                m_state = (seed ^ (seed >> 31)) | 1;
+            }
+
+            std::size_t operator()(const std::size_t max_height) noexcept {
+                m_state ^= m_state >> 12;
+                m_state ^= m_state << 25;
+                m_state ^= m_state >> 27;
+                auto bits = m_state * 0x2545F4914F6CDD1Dull;
+
+                std::size_t height = 1;
+                while (height < max_height && (bits & 3) == 0) {
+                    ++height;
+                    bits >>= 2;
+                }
+                return height;
+            }
+
+        private:
+            std::uint64_t m_state;
+        };
+
+    }   // namespace details
+
+
+    /**
+     * @brief Ordered container with expected O(log n) search, insertion and removal. Elements are
+     * kept sorted by Compare (equivalent elements in insertion order) on a level-0 chain of
+     * singly-linked nodes, which is traversed with the same forward iterators as singly_linked_list.
+     * Elements cannot be modified through iterators, as that could break the ordering.
+     *
+     * @tparam Tp
+     * @tparam Compare
+     */
+    template <typename Tp, typename Compare = std::less<Tp>>
+    class skip_list : public details::list_base<skip_list<Tp, Compare>, Tp> {
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = typename details::list_base<skip_list<Tp, Compare>, Tp>::value_type;
+        using size_type = typename details::list_base<skip_list<Tp, Compare>, Tp>::size_type;
+        using difference_type = typename details::list_base<skip_list<Tp, Compare>, Tp>::difference_type;
+
+        using reference = typename details::list_base<skip_list<Tp, Compare>, Tp>::reference;
+        using const_reference = typename details::list_base<skip_list<Tp, Compare>, Tp>::const_reference;
+
+        using key_compare = Compare;
+        using value_compare = Compare;
+
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+        using pointer = std::allocator_traits<allocator_type>::pointer;
+        using const_pointer = std::allocator_traits<allocator_type>::const_pointer;
+
+        using iterator = typename details::singly_const_iterator<Tp>;
+        using const_iterator = typename details::singly_const_iterator<Tp>;
+
+        // Enough levels for 4^32 elements at the 1/4 promotion probability
+        static constexpr std::size_t max_height = 32;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit skip_list(allocator_type allocator = {})
+            : skip_list(Compare(), allocator)
+        {}
+
+        explicit skip_list(const Compare &comp,
+                           allocator_type allocator = {})
+            : details::list_base<skip_list<Tp, Compare>, Tp>()
+            , m_allocator(allocator)
+            , m_comp(comp)
+            , m_head()
+            , m_head_tower()
+            , m_height(1)
+            , m_generator(reinterpret_cast<std::uintptr_t>(this))
+        {}
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        skip_list(InputIt first, InputIt last,
+                  const Compare &comp = Compare(),
+                  allocator_type allocator = {})
+            : skip_list(comp, allocator)
+        { insert(first, last); }
+
+        skip_list(std::initializer_list<Tp> init,
+                  const Compare &comp = Compare(),
+                  allocator_type allocator = {})
+            : skip_list(init.begin(), init.end(), comp, allocator)
+        {}
+
+
+        //* Copy Constructors *//
+
+        skip_list(const skip_list &other,
+                  allocator_type allocator)
+            : skip_list(other.m_comp, allocator)
+        { try_copy(other); }
+
+        skip_list(const skip_list &other)
+            : skip_list(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator()))
+        {}
+
+
+        //* Move Constructors *//
+
+        skip_list(skip_list &&other,
+                  allocator_type allocator)
+            : skip_list(other.m_comp, allocator)
+        { operator=(std::move(other)); }
+
+        skip_list(skip_list &&other) noexcept
+            : skip_list(other.m_comp, other.get_allocator())
+        { swap(other); }
+
+
+        //* Destructor *//
+        ~skip_list() {
+            clear();
+        }
+
+
+        //* Assignment operator overloads *//
+
+        skip_list& operator=(const skip_list&);
+        skip_list& operator=(skip_list&&);
+
+
+        //* Allocator and comparator access *//
+
+        allocator_type get_allocator() const noexcept;
+        key_compare key_comp() const;
+        value_compare value_comp() const;
+
+
+        //* Element Access *//
+
+        const_reference front() const {
+            return static_cast<node_t*>(m_head.m_next)->m_value;
+        }
+
+
+        //* Iterators *//
+
+        const_iterator begin() const noexcept {
+            return const_iterator(m_head.m_next);
+        }
+
+        const_iterator cbegin() const noexcept {
+            return const_iterator(m_head.m_next);
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(nullptr);
+        }
+
+        const_iterator cend() const noexcept {
+            return const_iterator(nullptr);
+        }
+
+
+        //* Modifiers *//
+
+        void clear() noexcept;
+
+        iterator insert(const Tp&);
+        iterator insert(Tp&&);
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        void insert(InputIt, InputIt);
+
+        void insert(std::initializer_list<Tp>);
+
+        template <class... Args>
+        iterator emplace(Args&&...);
+
+        iterator erase(const_iterator);
+        iterator erase(const_iterator, const_iterator);
+        size_type erase(const Tp&);
+
+        void swap(skip_list&) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value);
+
+
+        //* Lookup *//
+
+        size_type count(const Tp&) const;
+        const_iterator find(const Tp&) const;
+        bool contains(const Tp&) const;
+
+        const_iterator lower_bound(const Tp&) const;
+        const_iterator upper_bound(const Tp&) const;
+        std::pair<const_iterator, const_iterator> equal_range(const Tp&) const;
+        std::pair<const_iterator, const_iterator> range(const Tp&, const Tp&) const;
+
+
+    private:
+
+        //*** Using Directives ***//
+
+        using node_base_t = typename details::singly_node_base<Tp>;
+        using node_t = typename details::skip_node<Tp>;
+
+
+        //*** Members ***//
+
+        allocator_type m_allocator;
+        Compare m_comp;
+        node_base_t m_head;
+        node_base_t *m_head_tower[max_height - 1];
+        std::size_t m_height;
+        details::skip_height_generator m_generator;
+
+
+        //*** Functions ***//
+
+        node_base_t*& link(node_base_t*, const std::size_t) const noexcept;
+        const Tp& value_of(const node_base_t*) const noexcept;
+
+        template <class Less>
+        node_base_t* find_predecessors(Less, node_base_t**) const;
+
+        template <class... Args>
+        node_t* create_node(Args&&...);
+        void destroy_node(node_base_t*) noexcept;
+
+        iterator link_node(node_t*, node_base_t**) noexcept;
+        void try_copy(const skip_list&);
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    /**
+     * @brief Returns the outgoing link of node at level. The head keeps its upper levels in a
+     * member array, while every other node keeps them in the tower allocated behind it.
+     */
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::node_base_t*& skip_list<Tp, Compare>::link(node_base_t *node, const std::size_t level) const noexcept {
+        if (level == 0)
+            return node->m_next;
+        if (node == &m_head)
+            return const_cast<node_base_t*&>(m_head_tower[level - 1]);
+        return static_cast<node_t*>(node)->tower()[level - 1];
+    }
+
+    template <typename Tp, typename Compare>
+    const Tp& skip_list<Tp, Compare>::value_of(const node_base_t *node) const noexcept {
+        return static_cast<const node_t*>(node)->m_value;
+    }
+
+    /**
+     * @brief Descends from the top level, advancing past every node for which before(value) holds, and
+     * records the last such node on each level into update (when given). Returns the level-0 predecessor.
+     */
+    template <typename Tp, typename Compare>
+    template <class Less>
+    typename skip_list<Tp, Compare>::node_base_t* skip_list<Tp, Compare>::find_predecessors(Less before, node_base_t **update) const {
+        auto node = const_cast<node_base_t*>(&m_head);
+
+        for (auto level = m_height; level-- > 0;) {
+            for (auto next = link(node, level); next && before(value_of(next)); next = link(node, level))
+                node = next;
+            if (update)
+                update[level] = node;
+        }
+
+        return node;
+    }
+
+    template <typename Tp, typename Compare>
+    template <class... Args>
+    typename skip_list<Tp, Compare>::node_t* skip_list<Tp, Compare>::create_node(Args &&...args) {
+        auto height = m_generator(max_height);
+        auto node = static_cast<node_t*>(m_allocator.resource()->allocate(node_t::allocation_size(height), alignof(node_t)));
+
+        try {
+            m_allocator.construct(std::addressof(node->m_value), std::forward<Args>(args)...);
+        } catch (...) {
+            m_allocator.resource()->deallocate(node, node_t::allocation_size(height), alignof(node_t));
+            throw;
+        }
+
+        node->m_height = static_cast<std::uint8_t>(height);
+        return node;
+    }
+
+    template <typename Tp, typename Compare>
+    void skip_list<Tp, Compare>::destroy_node(node_base_t *node) noexcept {
+        auto pNode = static_cast<node_t*>(node);
+        std::allocator_traits<allocator_type>::destroy(m_allocator, std::addressof(pNode->m_value));
+        m_allocator.resource()->deallocate(pNode, node_t::allocation_size(pNode->m_height), alignof(node_t));
+    }
+
+    /**
+     * @brief Links node after the predecessors in update, raising the list height if needed.
+     */
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::iterator skip_list<Tp, Compare>::link_node(node_t *node, node_base_t **update) noexcept {
+        std::size_t height = node->m_height;
+        for (; m_height < height; ++m_height)
+            update[m_height] = &m_head;
+
+        for (std::size_t level = 0; level < height; ++level) {
+            link(node, level) = link(update[level], level);
+            link(update[level], level) = node;
+        }
+
+        ++this->m_size;
+        return iterator(node);
+    }
+
+    /**
+     * @brief Copies the already sorted other by appending behind the last node of each level, in O(n).
+     */
+    template <typename Tp, typename Compare>
+    void skip_list<Tp, Compare>::try_copy(const skip_list &other) {
+        clear();
+
+        node_base_t *update[max_height];
+        std::fill(std::begin(update), std::end(update), &m_head);
+
+        for (auto node = other.m_head.m_next; node; node = node->m_next) {
+            auto copy = create_node(value_of(node));
+            link_node(copy, update);
+            for (std::size_t level = 0; level < copy->m_height; ++level)
+                update[level] = copy;
+        }
+    }
+
+
+    //*** Public ***//
+
+    //* Assignment Operator Overloads *//
+
+    template <typename Tp, typename Compare>
+    skip_list<Tp, Compare>& skip_list<Tp, Compare>::operator=(const skip_list &other) {
+        if (this != &other) {
+            m_comp = other.m_comp;
+            try_copy(other);
+        }
+        return *this;
+    }
+
+    template <typename Tp, typename Compare>
+    skip_list<Tp, Compare>& skip_list<Tp, Compare>::operator=(skip_list &&other) {
+        if (this != &other) {
+            if (m_allocator == other.m_allocator) {
+                clear();
+                swap(other);
+            } else {
+                operator=(other);   // copy assignment
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+
+    //* Allocator and comparator access *//
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::allocator_type skip_list<Tp, Compare>::get_allocator() const noexcept {
+        return m_allocator;
+    }
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::key_compare skip_list<Tp, Compare>::key_comp() const {
+        return m_comp;
+    }
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::value_compare skip_list<Tp, Compare>::value_comp() const {
+        return m_comp;
+    }
+
+
+    //* Modifiers *//
+
+    template <typename Tp, typename Compare>
+    void skip_list<Tp, Compare>::clear() noexcept {
+        auto node = m_head.m_next;
+        while (node) {
+            auto old = node;
+            node = node->m_next;
+            destroy_node(old);
+        }
+
+        m_head.m_next = nullptr;
+        std::fill(std::begin(m_head_tower), std::end(m_head_tower), nullptr);
+        m_height = 1;
+        this->m_size = 0;
+    }
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::iterator skip_list<Tp, Compare>::insert(const Tp &value) {
+        return emplace(value);
+    }
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::iterator skip_list<Tp, Compare>::insert(Tp &&value) {
+        return emplace(std::move(value));
+    }
+
+    template <typename Tp, typename Compare>
+    template <class InputIt, typename>
+    void skip_list<Tp, Compare>::insert(InputIt first, InputIt last) {
+        for (; first != last; ++first)
+            emplace(*first);
+    }
+
+    template <typename Tp, typename Compare>
+    void skip_list<Tp, Compare>::insert(std::initializer_list<Tp> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    template <typename Tp, typename Compare>
+    template <class... Args>
+    typename skip_list<Tp, Compare>::iterator skip_list<Tp, Compare>::emplace(Args &&...args) {
+        auto node = create_node(std::forward<Args>(args)...);
+        const Tp &value = node->m_value;
+
+        // Skip past equivalent elements, so that they stay in insertion order
+        node_base_t *update[max_height];
+        find_predecessors([&](const Tp &other) { return !m_comp(value, other); }, update);
+        return link_node(node, update);
+    }
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::iterator skip_list<Tp, Compare>::erase(const_iterator pos) {
+        auto node = static_cast<node_t*>(pos.m_curr);
+        const Tp &value = node->m_value;
+
+        node_base_t *update[max_height];
+        find_predecessors([&](const Tp &other) { return m_comp(other, value); }, update);
+
+        // The predecessors may still be equivalent elements that precede node
+        for (std::size_t level = 0; level < node->m_height; ++level) {
+            while (link(update[level], level) != node)
+                update[level] = link(update[level], level);
+            link(update[level], level) = link(node, level);
+        }
+
+        auto next = node->m_next;
+        destroy_node(node);
+        --this->m_size;
+
+        while (m_height > 1 && !m_head_tower[m_height - 2])
+            --m_height;
+
+        return iterator(next);
+    }
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::iterator skip_list<Tp, Compare>::erase(const_iterator first, const_iterator last) {
+        while (first != last)
+            first = erase(first);
+        return iterator(last.m_curr);
+    }
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::size_type skip_list<Tp, Compare>::erase(const Tp &value) {
+        auto old_size = this->m_size;
+        auto [first, last] = equal_range(value);
+        erase(first, last);
+        return old_size - this->m_size;
+    }
+
+    template <typename Tp, typename Compare>
+    void skip_list<Tp, Compare>::swap(skip_list &other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
+        if (m_allocator == other.m_allocator) {
+            // No node refers back to the head, so the head links can be exchanged directly
+            using std::swap;
+            swap(m_comp, other.m_comp);
+            swap(m_head.m_next, other.m_head.m_next);
+            swap(m_head_tower, other.m_head_tower);
+            swap(m_height, other.m_height);
+            swap(this->m_size, other.m_size);
+        }
+    }
+
+
+    //* Lookup *//
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::size_type skip_list<Tp, Compare>::count(const Tp &value) const {
+        auto [first, last] = equal_range(value);
+        return static_cast<size_type>(std::distance(first, last));
+    }
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::const_iterator skip_list<Tp, Compare>::find(const Tp &value) const {
+        auto it = lower_bound(value);
+        return (it != end() && !m_comp(value, *it)) ? it : end();
+    }
+
+    template <typename Tp, typename Compare>
+    bool skip_list<Tp, Compare>::contains(const Tp &value) const {
+        return find(value) != end();
+    }
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::const_iterator skip_list<Tp, Compare>::lower_bound(const Tp &value) const {
+        auto node = find_predecessors([&](const Tp &other) { return m_comp(other, value); }, nullptr);
+        return const_iterator(node->m_next);
+    }
+
+    template <typename Tp, typename Compare>
+    typename skip_list<Tp, Compare>::const_iterator skip_list<Tp, Compare>::upper_bound(const Tp &value) const {
+        auto node = find_predecessors([&](const Tp &other) { return !m_comp(value, other); }, nullptr);
+        return const_iterator(node->m_next);
+    }
+
+    template <typename Tp, typename Compare>
+    std::pair<typename skip_list<Tp, Compare>::const_iterator, typename skip_list<Tp, Compare>::const_iterator>
+    skip_list<Tp, Compare>::equal_range(const Tp &value) const {
+        return { lower_bound(value), upper_bound(value) };
+    }
+
+    /**
+     * @brief Returns the elements in the half-open interval [low, high).
+     */
+    template <typename Tp, typename Compare>
+    std::pair<typename skip_list<Tp, Compare>::const_iterator, typename skip_list<Tp, Compare>::const_iterator>
+    skip_list<Tp, Compare>::range(const Tp &low, const Tp &high) const {
+        auto first = lower_bound(low);
+        return { first, m_comp(low, high) ? lower_bound(high) : first };
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_SKIP_LIST_H
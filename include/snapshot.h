@@ -0,0 +1,579 @@
+#ifndef DSL_SNAPSHOT_H
+#define DSL_SNAPSHOT_H
+
+
+#include "doubly_linked_list.h"
+#include "list.h"
+#include "singly_linked_list.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+
+namespace dsl {
+
+    class snapshot_writer;
+    class snapshot_reader;
+
+    /**
+     * @brief Customization point for the element encoding of a snapshot. Trivially copyable types
+     * (other than pointers) are stored as their object representation and need nothing; any other
+     * type must specialize this template with
+     *
+     *     static void save(snapshot_writer&, const Tp&);
+     *     static Tp load(snapshot_reader&);
+     *
+     * @tparam Tp
+     */
+    template <typename Tp, typename = void>
+    struct snapshot_traits;
+
+    template <typename Tp>
+    struct snapshot_traits<Tp, std::enable_if_t<std::is_trivially_copyable_v<Tp> && !std::is_pointer_v<Tp>>> {
+        static constexpr bool raw = true;
+
+        static void save(snapshot_writer&, const Tp&);
+        static Tp load(snapshot_reader&);
+    };
+
+    /**
+     * @brief Strings are stored as their length followed by their characters.
+     */
+    template <typename Char, typename Traits, typename Allocator>
+    struct snapshot_traits<std::basic_string<Char, Traits, Allocator>, std::enable_if_t<std::is_trivially_copyable_v<Char>>> {
+        static void save(snapshot_writer&, const std::basic_string<Char, Traits, Allocator>&);
+        static std::basic_string<Char, Traits, Allocator> load(snapshot_reader&);
+    };
+
+
+    namespace details {
+
+        inline constexpr char snapshot_magic[8] = { 'D', 'S', 'L', 'S', 'N', 'A', 'P', '\0' };
+        inline constexpr std::uint32_t snapshot_version = 1;
+        inline constexpr std::uint32_t snapshot_byte_order = 0x01020304;
+
+        enum class snapshot_encoding : std::uint32_t { raw, custom };
+
+        /**
+         * @brief Fixed-size header at the start of every snapshot. The element count and size
+         * let the loader size its storage before reading any element.
+         */
+        struct snapshot_header {
+            char m_magic[8];
+            std::uint32_t m_version;
+            std::uint32_t m_byte_order;
+            snapshot_encoding m_encoding;
+            std::uint32_t m_element_size;
+            std::uint64_t m_count;
+        };
+
+        template <typename Tp, typename = void>
+        inline constexpr bool is_raw_snapshot_v = false;
+
+        template <typename Tp>
+        inline constexpr bool is_raw_snapshot_v<Tp, std::void_t<decltype(snapshot_traits<Tp>::raw)>> = snapshot_traits<Tp>::raw;
+
+        [[noreturn]] inline void throw_errno(const char *what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        /**
+         * @brief Writes every byte described by iov, resuming after partial writes and interrupts.
+         * Modifies iov in place.
+         */
+        inline void write_fully(const int fd, struct iovec *iov, int count) {
+            while (count > 0) {
+                auto written = ::writev(fd, iov, count);
+                if (written < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    throw_errno("dsl::save: writev failed");
+                }
+
+                auto remaining = static_cast<std::size_t>(written);
+                while (count > 0 && remaining >= iov->iov_len) {
+                    remaining -= iov->iov_len;
+                    ++iov;
+                    --count;
+                }
+                if (count > 0) {
+                    iov->iov_base = static_cast<std::byte*>(iov->iov_base) + remaining;
+                    iov->iov_len -= remaining;
+                }
+            }
+        }
+
+        /**
+         * @brief Reads up to size bytes, stopping early only at end of file. Returns the bytes read.
+         */
+        inline std::size_t read_fully(const int fd, void *data, const std::size_t size) {
+            auto dest = static_cast<std::byte*>(data);
+            std::size_t total = 0;
+            while (total < size) {
+                auto got = ::read(fd, dest + total, size - total);
+                if (got < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    throw_errno("dsl::load: read failed");
+                }
+                if (got == 0)
+                    break;
+                total += static_cast<std::size_t>(got);
+            }
+            return total;
+        }
+
+        template <typename Tp>
+        snapshot_header make_snapshot_header(const std::size_t count) noexcept {
+            snapshot_header header;
+            std::memcpy(header.m_magic, snapshot_magic, sizeof(snapshot_magic));
+            header.m_version = snapshot_version;
+            header.m_byte_order = snapshot_byte_order;
+            header.m_encoding = is_raw_snapshot_v<Tp> ? snapshot_encoding::raw : snapshot_encoding::custom;
+            header.m_element_size = static_cast<std::uint32_t>(sizeof(Tp));
+            header.m_count = count;
+            return header;
+        }
+
+    }   // namespace details
+
+
+    /**
+     * @brief Buffers small writes to a file descriptor and passes large ones straight through,
+     * so that elements stream out in chunk_size writes. flush must be called once done; the
+     * destructor discards anything still buffered, as it cannot report a failed write.
+     */
+    class snapshot_writer {
+    public:
+        static constexpr std::size_t chunk_size = 64 * 1024;
+
+        explicit snapshot_writer(const int fd)
+            : m_fd(fd)
+            , m_buffer(new std::byte[chunk_size])
+            , m_used(0)
+        {}
+
+        snapshot_writer(const snapshot_writer&) = delete;
+        snapshot_writer& operator=(const snapshot_writer&) = delete;
+
+        void write(const void *data, const std::size_t size) {
+            if (m_used + size <= chunk_size) {
+                std::memcpy(m_buffer.get() + m_used, data, size);
+                m_used += size;
+                return;
+            }
+
+            struct iovec iov[2] = { { m_buffer.get(), m_used }, { const_cast<void*>(data), size } };
+            if (size < chunk_size) {
+                // Top the chunk up and carry the rest over, so that writes stay chunk_size
+                auto head = chunk_size - m_used;
+                std::memcpy(m_buffer.get() + m_used, data, head);
+                iov[0].iov_len = chunk_size;
+                details::write_fully(m_fd, iov, 1);
+
+                std::memcpy(m_buffer.get(), static_cast<const std::byte*>(data) + head, size - head);
+                m_used = size - head;
+            } else {
+                details::write_fully(m_fd, iov, 2);
+                m_used = 0;
+            }
+        }
+
+        template <typename Tp>
+        void write_value(const Tp &value) {
+            snapshot_traits<Tp>::save(*this, value);
+        }
+
+        void flush() {
+            struct iovec iov = { m_buffer.get(), m_used };
+            details::write_fully(m_fd, &iov, 1);
+            m_used = 0;
+        }
+
+    private:
+        int m_fd;
+        std::unique_ptr<std::byte[]> m_buffer;
+        std::size_t m_used;
+    };
+
+
+    /**
+     * @brief Reads a file descriptor in chunk_size reads, except that requests at least as large
+     * as a chunk are read straight into the destination. Throws std::runtime_error if the file
+     * ends before a request is satisfied.
+     */
+    class snapshot_reader {
+    public:
+        static constexpr std::size_t chunk_size = 64 * 1024;
+
+        explicit snapshot_reader(const int fd)
+            : m_fd(fd)
+            , m_buffer(new std::byte[chunk_size])
+            , m_begin(0)
+            , m_end(0)
+            , m_offset(0)
+            , m_file_size(0)
+            , m_seekable(false)
+        {
+            struct stat status;
+            if (::fstat(fd, &status) == 0 && S_ISREG(status.st_mode)) {
+                auto offset = ::lseek(fd, 0, SEEK_CUR);
+                if (offset >= 0) {
+                    m_offset = static_cast<std::uint64_t>(offset);
+                    m_file_size = static_cast<std::uint64_t>(status.st_size);
+                    m_seekable = true;
+                }
+            }
+        }
+
+        snapshot_reader(const snapshot_reader&) = delete;
+        snapshot_reader& operator=(const snapshot_reader&) = delete;
+
+        void read(void *data, std::size_t size) {
+            auto dest = static_cast<std::byte*>(data);
+            while (size) {
+                if (m_begin == m_end) {
+                    if (size >= chunk_size) {
+                        auto got = details::read_fully(m_fd, dest, size);
+                        m_offset += got;
+                        if (got != size)
+                            throw std::runtime_error("dsl::load: snapshot is truncated.");
+                        return;
+                    }
+
+                    m_begin = 0;
+                    m_end = details::read_fully(m_fd, m_buffer.get(), chunk_size);
+                    m_offset += m_end;
+                    if (m_end == 0)
+                        throw std::runtime_error("dsl::load: snapshot is truncated.");
+                }
+
+                auto count = std::min(size, m_end - m_begin);
+                std::memcpy(dest, m_buffer.get() + m_begin, count);
+                m_begin += count;
+                dest += count;
+                size -= count;
+            }
+        }
+
+        template <typename Tp>
+        Tp read_value() {
+            return snapshot_traits<Tp>::load(*this);
+        }
+
+        // Bytes known to remain: those buffered, plus the rest of the file if fd is a regular file
+        [[nodiscard]] std::size_t available() const noexcept {
+            auto rest = m_file_size > m_offset ? m_file_size - m_offset : 0;
+            rest = std::min<std::uint64_t>(rest, std::numeric_limits<std::size_t>::max() - (m_end - m_begin));
+            return static_cast<std::size_t>(rest) + (m_end - m_begin);
+        }
+
+        /**
+         * @brief Hands the bytes read ahead but not consumed back to a regular file, leaving its
+         * offset just past the last byte consumed. Does nothing for other file descriptors.
+         */
+        void finish() {
+            if (!m_seekable || m_begin == m_end)
+                return;
+
+            auto unconsumed = m_end - m_begin;
+            if (::lseek(m_fd, -static_cast<off_t>(unconsumed), SEEK_CUR) < 0)
+                details::throw_errno("dsl::load: lseek failed");
+            m_offset -= unconsumed;
+            m_begin = m_end = 0;
+        }
+
+    private:
+        int m_fd;
+        std::unique_ptr<std::byte[]> m_buffer;
+        std::size_t m_begin;
+        std::size_t m_end;
+        std::uint64_t m_offset;         // Of fd, if it is a regular file
+        std::uint64_t m_file_size;      // 0 unless fd is a regular file
+        bool m_seekable;                // Whether fd is a regular file whose offset is known
+    };
+
+
+    namespace details {
+
+        /**
+         * @brief Reads the container internals that save and load need to bypass per-element
+         * insertion. Every container accepts a snapshot of any of the three.
+         */
+        struct snapshot_access {
+
+            static snapshot_header read_header(snapshot_reader &reader) {
+                snapshot_header header;
+                reader.read(&header, sizeof(header));
+
+                if (std::memcmp(header.m_magic, snapshot_magic, sizeof(snapshot_magic)) != 0)
+                    throw std::runtime_error("dsl::load: not a dsl snapshot.");
+                if (header.m_version != snapshot_version)
+                    throw std::runtime_error("dsl::load: unsupported snapshot version " + std::to_string(header.m_version) + ".");
+                if (header.m_byte_order != snapshot_byte_order)
+                    throw std::runtime_error("dsl::load: snapshot was written with a different byte order.");
+                return header;
+            }
+
+            template <typename Tp>
+            static void check_header(const snapshot_header &header) {
+                auto expected = make_snapshot_header<Tp>(0);
+                if (header.m_encoding != expected.m_encoding || header.m_element_size != expected.m_element_size)
+                    throw std::runtime_error("dsl::load: snapshot element type does not match.");
+                if (header.m_count > std::numeric_limits<std::size_t>::max() / sizeof(Tp))
+                    throw std::length_error("dsl::load: snapshot element count is too large.");
+            }
+
+            /**
+             * @brief The number of elements to allocate storage for next, having loaded loaded of
+             * count. The header's count is not trusted: storage is allocated for no more elements
+             * than the bytes known to remain could hold, or a chunk's worth, and from there grows
+             * at most geometrically with the elements actually read.
+             */
+            template <typename Tp>
+            static std::size_t next_batch(const snapshot_reader &reader, const std::size_t loaded, const std::size_t count) noexcept {
+                auto batch = std::max({ loaded, reader.available() / sizeof(Tp), 
+                                        std::max<std::size_t>(snapshot_reader::chunk_size / sizeof(Tp), 1) });
+                return std::min(count - loaded, batch);
+            }
+
+            template <class Range>
+            static void save_elements(snapshot_writer &writer, const Range &range) {
+                for (const auto &value : range)
+                    writer.write_value(value);
+                writer.flush();
+            }
+
+            //* list *//
+
+            template <typename Tp, class Allocator>
+            static void save(const list<Tp, Allocator> &source, const int fd) {
+                auto header = make_snapshot_header<Tp>(source.size());
+
+                if constexpr (is_raw_snapshot_v<Tp>) {
+                    struct iovec iov[2] = { { &header, sizeof(header) },
+                                            { const_cast<Tp*>(source.m_data), sizeof(Tp) * source.size() } };
+                    write_fully(fd, iov, 2);
+                } else {
+                    snapshot_writer writer(fd);
+                    writer.write(&header, sizeof(header));
+                    save_elements(writer, source);
+                }
+            }
+
+            template <typename Tp, class Allocator>
+            static void load(list<Tp, Allocator> &dest, snapshot_reader &reader, const snapshot_header &header) {
+                auto count = static_cast<std::size_t>(header.m_count);
+                if (count > dest.max_size())
+                    throw std::length_error("dsl::load: snapshot element count is too large.");
+
+                for (std::size_t loaded = 0; loaded < count; loaded = dest.size()) {
+                    auto batch = next_batch<Tp>(reader, loaded, count);
+                    dest.reserve(loaded + batch);
+
+                    if constexpr (is_raw_snapshot_v<Tp>) {
+                        reader.read(dest.m_data + loaded, sizeof(Tp) * batch);
+                        dest.m_size = loaded + batch;
+                    } else {
+                        for (std::size_t i = 0; i < batch; ++i)
+                            dest.emplace_back(reader.read_value<Tp>());
+                    }
+                }
+            }
+
+            //* singly_linked_list and doubly_linked_list *//
+
+            template <class LinkedList>
+            static void save(const LinkedList &source, const int fd) {
+                using value_type = typename LinkedList::value_type;
+                auto header = make_snapshot_header<value_type>(source.size());
+
+                snapshot_writer writer(fd);
+                writer.write(&header, sizeof(header));
+                save_elements(writer, source);
+            }
+
+            /**
+             * @brief Obtains the nodes for a batch of elements before reading their values, so that
+             * the nodes are allocated back to back rather than interleaved with whatever reading a
+             * custom type allocates, then fills them in order. Returns the null-terminated chain
+             * and its last node.
+             */
+            template <class LinkedList>
+            static std::pair<typename LinkedList::node_base_t*, typename LinkedList::node_base_t*>
+            load_chain(LinkedList &dest, snapshot_reader &reader, const std::size_t count) {
+                using value_type = typename LinkedList::value_type;
+                using node_base_t = typename LinkedList::node_base_t;
+                using node_t = typename LinkedList::node_t;
+
+                node_base_t chain;
+                node_base_t *tail = &chain;
+                chain.m_next = nullptr;
+
+                std::size_t built = 0;
+                try {
+                    while (built < count) {
+                        auto batch = next_batch<value_type>(reader, built, count);
+                        auto filled = tail;
+                        for (std::size_t i = 0; i < batch; ++i) {
+                            auto node = LinkedList::allocate_node(dest.allocator_ref());
+                            node->m_next = nullptr;
+                            tail->m_next = node;
+                            tail = node;
+                        }
+
+                        for (auto node = filled->m_next; node; node = node->m_next, ++built) {
+                            auto value = std::addressof(static_cast<node_t*>(node)->m_value);
+                            if constexpr (is_raw_snapshot_v<value_type>)
+                                reader.read(value, sizeof(value_type));
+                            else
+                                LinkedList::alloc_traits::construct(dest.allocator_ref(), value, reader.read_value<value_type>());
+                        }
+                    }
+                } catch (...) {
+                    auto node = chain.m_next;
+                    for (std::size_t i = 0; i < built; ++i, node = node->m_next)
+                        LinkedList::alloc_traits::destroy(dest.allocator_ref(), std::addressof(static_cast<node_t*>(node)->m_value));
+                    LinkedList::deallocate_chain(chain.m_next, dest.allocator_ref());
+                    throw;
+                }
+
+                for (std::size_t i = 0; i < count; ++i)
+                    record_event(&dest, container_event::node_allocation, sizeof(node_t));
+                return { chain.m_next, tail };
+            }
+
+            template <typename Tp, class Allocator>
+            static void load(singly_linked_list<Tp, Allocator> &dest, snapshot_reader &reader, const snapshot_header &header) {
+                auto count = static_cast<std::size_t>(header.m_count);
+                if (count > dest.max_size())
+                    throw std::length_error("dsl::load: snapshot element count is too large.");
+
+                auto [first, last] = load_chain(dest, reader, count);
+                if (count) {
+                    dest.m_head.m_next = first;
+                    dest.m_tail = last;
+                    dest.m_size = count;
+                }
+            }
+
+            template <typename Tp, class Allocator>
+            static void load(doubly_linked_list<Tp, Allocator> &dest, snapshot_reader &reader, const snapshot_header &header) {
+                auto count = static_cast<std::size_t>(header.m_count);
+                if (count > dest.max_size())
+                    throw std::length_error("dsl::load: snapshot element count is too large.");
+
+                auto first = load_chain(dest, reader, count).first;
+                if (count) {
+                    dest.m_sentinel.m_next = first;
+                    dest.relink_prev();
+                    dest.m_size = count;
+                }
+            }
+        };
+
+    }   // namespace details
+
+
+    //****** Function Implementations ******//
+
+    //* snapshot_traits *//
+
+    template <typename Tp>
+    void snapshot_traits<Tp, std::enable_if_t<std::is_trivially_copyable_v<Tp> && !std::is_pointer_v<Tp>>>::save(snapshot_writer &writer, const Tp &value) {
+        writer.write(std::addressof(value), sizeof(Tp));
+    }
+
+    template <typename Tp>
+    Tp snapshot_traits<Tp, std::enable_if_t<std::is_trivially_copyable_v<Tp> && !std::is_pointer_v<Tp>>>::load(snapshot_reader &reader) {
+        alignas(Tp) std::byte storage[sizeof(Tp)];
+        reader.read(storage, sizeof(Tp));
+        return *std::launder(reinterpret_cast<Tp*>(storage));
+    }
+
+    template <typename Char, typename Traits, typename Allocator>
+    void snapshot_traits<std::basic_string<Char, Traits, Allocator>, std::enable_if_t<std::is_trivially_copyable_v<Char>>>::save(
+            snapshot_writer &writer, const std::basic_string<Char, Traits, Allocator> &value) {
+        auto length = static_cast<std::uint64_t>(value.size());
+        writer.write(&length, sizeof(length));
+        writer.write(value.data(), sizeof(Char) * value.size());
+    }
+
+    template <typename Char, typename Traits, typename Allocator>
+    std::basic_string<Char, Traits, Allocator>
+    snapshot_traits<std::basic_string<Char, Traits, Allocator>, std::enable_if_t<std::is_trivially_copyable_v<Char>>>::load(snapshot_reader &reader) {
+        std::uint64_t length;
+        reader.read(&length, sizeof(length));
+
+        std::basic_string<Char, Traits, Allocator> value;
+        if (length > value.max_size())
+            throw std::length_error("dsl::load: snapshot string is too long.");
+
+        value.resize(static_cast<std::size_t>(length));
+        reader.read(value.data(), sizeof(Char) * value.size());
+        return value;
+    }
+
+
+    //* Saving and loading *//
+
+    /**
+     * @brief Writes a versioned binary snapshot of source to fd, starting at the current offset.
+     * The buffer of a list of trivially copyable elements goes out in a single writev together
+     * with the header; every other combination streams through a snapshot_writer.
+     */
+    template <typename Tp, class Allocator>
+    void save(const list<Tp, Allocator> &source, const int fd) {
+        details::snapshot_access::save(source, fd);
+    }
+
+    template <typename Tp, class Allocator>
+    void save(const singly_linked_list<Tp, Allocator> &source, const int fd) {
+        details::snapshot_access::save(source, fd);
+    }
+
+    template <typename Tp, class Allocator>
+    void save(const doubly_linked_list<Tp, Allocator> &source, const int fd) {
+        details::snapshot_access::save(source, fd);
+    }
+
+    /**
+     * @brief Reads a snapshot written by save from fd into a new Container, which may be any of
+     * list, singly_linked_list or doubly_linked_list regardless of the container that was saved.
+     * Throws std::runtime_error if the snapshot is malformed, truncated or holds another element type,
+     * and std::system_error if reading fails. Reading goes ahead in chunks; for a regular file the
+     * bytes read past the snapshot are given back, so that the offset afterwards is exactly the end
+     * of the snapshot and back-to-back snapshots can be loaded in turn. For a pipe or socket the
+     * offset afterwards is unspecified, as is the offset of any file after an exception.
+     */
+    template <class Container>
+    Container load(const int fd, const typename Container::allocator_type &allocator = {}) {
+        snapshot_reader reader(fd);
+        auto header = details::snapshot_access::read_header(reader);
+        details::snapshot_access::check_header<typename Container::value_type>(header);
+
+        Container result(allocator);
+        details::snapshot_access::load(result, reader, header);
+        reader.finish();
+        return result;
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_SNAPSHOT_H
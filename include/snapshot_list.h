@@ -0,0 +1,417 @@
+#ifndef DSL_SNAPSHOT_LIST_H
+#define DSL_SNAPSHOT_LIST_H
+
+
+#include "list.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+
+namespace dsl {
+
+    namespace details {
+
+        /**
+         * @brief A thread's entry in the epoch domain: the global epoch it observed when it began
+         * reading, or 0 while it is not reading.
+         */
+        struct epoch_record {
+            std::atomic<std::uint64_t> m_epoch{ 0 };
+            std::atomic<bool> m_in_use{ true };
+            epoch_record *m_next = nullptr;
+            unsigned m_nesting = 0;     // Accessed only by the owning thread
+        };
+
+        /**
+         * @brief Process-wide epoch-based reclamation shared by every snapshot_list. Each thread
+         * that reads claims a record, reused after the thread exits, from a lock-free registry.
+         * A reader publishes the epoch it enters in and fences before loading any shared pointer;
+         * a writer unlinks an object, advances the epoch, and may free the object once every
+         * reading thread has entered a later epoch.
+         */
+        class epoch_domain {
+        public:
+            static epoch_domain& instance() noexcept {
+                static epoch_domain domain;
+                return domain;
+            }
+
+            epoch_record& local_record() {
+                thread_local record_holder holder(*this);
+                return *holder.m_record;
+            }
+
+            void enter(epoch_record &record) noexcept {
+                if (record.m_nesting++ == 0) {
+                    record.m_epoch.store(m_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                }
+            }
+
+            void exit(epoch_record &record) noexcept {
+                if (--record.m_nesting == 0)
+                    record.m_epoch.store(0, std::memory_order_release);
+            }
+
+            // Called after unlinking an object; returns the epoch it was retired in
+            std::uint64_t retire() noexcept {
+                return m_epoch.fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            // An object retired in epoch e may be freed once this returns more than e
+            std::uint64_t oldest_active() const noexcept {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                auto oldest = std::numeric_limits<std::uint64_t>::max();
+                for (auto record = m_records.load(std::memory_order_acquire); record; record = record->m_next) {
+                    auto epoch = record->m_epoch.load(std::memory_order_acquire);
+                    if (epoch && epoch < oldest)
+                        oldest = epoch;
+                }
+                return oldest;
+            }
+
+        private:
+            struct record_holder {
+                explicit record_holder(epoch_domain &domain)
+                    : m_record(domain.acquire_record()) {}
+
+                ~record_holder() {
+                    m_record->m_in_use.store(false, std::memory_order_release);
+                }
+
+                epoch_record *m_record;
+            };
+
+            epoch_domain() noexcept
+                : m_epoch(1)
+                , m_records(nullptr) {}
+
+            epoch_record* acquire_record() {
+                for (auto record = m_records.load(std::memory_order_acquire); record; record = record->m_next) {
+                    auto in_use = false;
+                    if (!record->m_in_use.load(std::memory_order_relaxed)
+                        && record->m_in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+                        return record;
+                }
+
+                // Records are never freed, as writers may be scanning them
+                auto record = new epoch_record;
+                record->m_next = m_records.load(std::memory_order_relaxed);
+                while (!m_records.compare_exchange_weak(record->m_next, record, std::memory_order_release, std::memory_order_relaxed));
+                return record;
+            }
+
+            std::atomic<std::uint64_t> m_epoch;
+            std::atomic<epoch_record*> m_records;
+        };
+
+    }   // namespace details
+
+
+    /**
+     * @brief Read-mostly list shared between threads in the manner of RCU. Readers take an
+     * immutable snapshot of the current version without locks or shared writes: entering a
+     * snapshot stores to the reading thread's own epoch record and loads the version pointer.
+     * Writers copy the current version into a batch, modify it freely, and commit it, which
+     * swaps the version pointer atomically; readers see either the old or the new version in full.
+     *
+     * Replaced versions are retired, and freed by a later commit or reclaim() once no reader
+     * that could still hold them remains. Writers are serialized by a mutex, which readers never
+     * take. Versions are allocated from the allocator's resource by writers only.
+     *
+     * @tparam Tp
+     */
+    template <typename Tp>
+    class snapshot_list {
+    public:
+
+        //*** Member Types ***//
+
+        using list_type = list<Tp>;
+        using value_type = Tp;
+        using size_type = std::size_t;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        class snapshot;
+        class batch;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit snapshot_list(allocator_type allocator = {})
+            : snapshot_list(list_type(allocator), allocator)
+        {}
+
+        explicit snapshot_list(const list_type &init, allocator_type allocator = {})
+            : m_allocator(allocator)
+            , m_current(nullptr)
+            , m_retired(allocator)
+        { m_current.store(create(list_type(init, allocator)), std::memory_order_release); }
+
+        snapshot_list(const snapshot_list&) = delete;
+        snapshot_list& operator=(const snapshot_list&) = delete;
+
+        ~snapshot_list();
+
+
+        //* Reading *//
+
+        [[nodiscard]] snapshot read() const;
+
+
+        //* Writing *//
+
+        [[nodiscard]] batch modify() {
+            return batch(*this);
+        }
+
+        template <class F>
+        void update(F f) {
+            auto draft = modify();
+            f(*draft);
+            draft.commit();
+        }
+
+        void reclaim() {
+            std::lock_guard<std::mutex> lock(m_writer);
+            reclaim_retired();
+        }
+
+        // Versions replaced but not yet freed
+        [[nodiscard]] size_type retired_count() const {
+            std::lock_guard<std::mutex> lock(m_writer);
+            return m_retired.size();
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return m_allocator;
+        }
+
+
+    private:
+
+        //*** Members ***//
+
+        struct retired_t {
+            list_type *m_version;
+            std::uint64_t m_epoch;
+        };
+
+        allocator_type m_allocator;
+        std::atomic<list_type*> m_current;
+        mutable std::mutex m_writer;
+        list<retired_t> m_retired;
+
+
+        //*** Functions ***//
+
+        list_type* create(list_type&&);
+        void destroy(list_type*) noexcept;
+        void publish(list_type&&);
+        void reclaim_retired() noexcept;
+    };
+
+
+    /**
+     * @brief Read-only view of one version of a snapshot_list, kept alive while any snapshot
+     * of the same thread is. Copies are counted in the thread's epoch record, so a snapshot and
+     * its copies must be destroyed on the thread that took it.
+     */
+    template <typename Tp>
+    class snapshot_list<Tp>::snapshot {
+    public:
+        using const_iterator = typename list_type::const_iterator;
+
+        snapshot(const snapshot &other) noexcept
+            : m_list(other.m_list)
+            , m_record(other.m_record)
+        {
+            if (m_record)
+                ++m_record->m_nesting;
+        }
+
+        snapshot(snapshot &&other) noexcept
+            : m_list(other.m_list)
+            , m_record(std::exchange(other.m_record, nullptr))
+        {}
+
+        snapshot& operator=(snapshot other) noexcept {
+            std::swap(m_list, other.m_list);
+            std::swap(m_record, other.m_record);
+            return *this;
+        }
+
+        ~snapshot() {
+            if (m_record)
+                details::epoch_domain::instance().exit(*m_record);
+        }
+
+        const list_type& operator*() const noexcept { return *m_list; }
+        const list_type* operator->() const noexcept { return m_list; }
+        const list_type& list() const noexcept { return *m_list; }
+
+        const_iterator begin() const noexcept { return m_list->cbegin(); }
+        const_iterator end() const noexcept { return m_list->cend(); }
+
+        [[nodiscard]] bool empty() const noexcept { return m_list->empty(); }
+        [[nodiscard]] size_type size() const noexcept { return m_list->size(); }
+
+        const Tp& operator[](const size_type pos) const noexcept { return (*m_list)[pos]; }
+
+    private:
+        friend class snapshot_list;
+
+        snapshot(const list_type *list, details::epoch_record *record) noexcept
+            : m_list(list)
+            , m_record(record) {}
+
+        const list_type *m_list;
+        details::epoch_record *m_record;
+    };
+
+
+    /**
+     * @brief A writer's private copy of the current version, holding the writer lock until it is
+     * committed or destroyed. Destroying it without committing discards the changes.
+     */
+    template <typename Tp>
+    class snapshot_list<Tp>::batch {
+    public:
+        batch(batch &&other) noexcept
+            : m_owner(other.m_owner)
+            , m_lock(std::move(other.m_lock))
+            , m_draft(std::move(other.m_draft))
+        { other.m_draft.reset(); }
+
+        batch& operator=(batch&&) = delete;
+
+        list_type& operator*() { return draft(); }
+        list_type* operator->() { return &draft(); }
+        list_type& list() { return draft(); }
+
+        void commit() {
+            m_owner->publish(std::move(draft()));
+            m_draft.reset();
+            m_lock.unlock();
+        }
+
+    private:
+        friend class snapshot_list;
+
+        explicit batch(snapshot_list &owner)
+            : m_owner(&owner)
+            , m_lock(owner.m_writer)
+            , m_draft(std::in_place, *owner.m_current.load(std::memory_order_relaxed), owner.m_allocator)
+        {}
+
+        list_type& draft() {
+            if (!m_draft)
+                throw std::logic_error("Batch has already been committed.");
+            return *m_draft;
+        }
+
+        snapshot_list *m_owner;
+        std::unique_lock<std::mutex> m_lock;
+        std::optional<list_type> m_draft;
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    template <typename Tp>
+    typename snapshot_list<Tp>::list_type* snapshot_list<Tp>::create(list_type &&version) {
+        auto storage = m_allocator.resource()->allocate(sizeof(list_type), alignof(list_type));
+        try {
+            return ::new (storage) list_type(std::move(version), m_allocator);
+        } catch (...) {
+            m_allocator.resource()->deallocate(storage, sizeof(list_type), alignof(list_type));
+            throw;
+        }
+    }
+
+    template <typename Tp>
+    void snapshot_list<Tp>::destroy(list_type *version) noexcept {
+        version->~list_type();
+        m_allocator.resource()->deallocate(version, sizeof(list_type), alignof(list_type));
+    }
+
+    /**
+     * @brief Swaps in version as the current one and retires its predecessor. Called with the
+     * writer lock held.
+     */
+    template <typename Tp>
+    void snapshot_list<Tp>::publish(list_type &&version) {
+        if (m_retired.size() == m_retired.capacity())
+            m_retired.reserve(std::max<size_type>(m_retired.capacity() * 2, 4));
+
+        auto created = create(std::move(version));
+        auto previous = m_current.exchange(created, std::memory_order_acq_rel);
+        m_retired.push_back(retired_t{ previous, details::epoch_domain::instance().retire() });
+        reclaim_retired();
+    }
+
+    /**
+     * @brief Frees the retired versions that no reader can still hold. Called with the writer
+     * lock held.
+     */
+    template <typename Tp>
+    void snapshot_list<Tp>::reclaim_retired() noexcept {
+        auto oldest = details::epoch_domain::instance().oldest_active();
+
+        size_type kept = 0;
+        for (size_type i = 0; i < m_retired.size(); ++i) {
+            if (m_retired[i].m_epoch < oldest)
+                destroy(m_retired[i].m_version);
+            else
+                m_retired[kept++] = m_retired[i];
+        }
+        m_retired.resize(kept);
+    }
+
+
+    //*** Public ***//
+
+    //* Constructors *//
+
+    /**
+     * @brief Frees every version. No snapshot or batch of the list may outlive it.
+     */
+    template <typename Tp>
+    snapshot_list<Tp>::~snapshot_list() {
+        for (const auto &retired : m_retired)
+            destroy(retired.m_version);
+        destroy(m_current.load(std::memory_order_acquire));
+    }
+
+
+    //* Reading *//
+
+    template <typename Tp>
+    typename snapshot_list<Tp>::snapshot snapshot_list<Tp>::read() const {
+        auto &domain = details::epoch_domain::instance();
+        auto &record = domain.local_record();
+
+        domain.enter(record);
+        return snapshot(m_current.load(std::memory_order_acquire), &record);
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_SNAPSHOT_LIST_H
@@ -0,0 +1,478 @@
+#ifndef DSL_STATIC_LIST_H
+#define DSL_STATIC_LIST_H
+
+
+#include "list.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace dsl {
+
+    /**
+     * @brief Fixed-capacity, array-based list holding up to N elements inline, usable in constant
+     * evaluation. Lookup tables and precomputed sequences can be built by a constexpr function
+     * with the same list interface used at runtime, stored as a constexpr static_list, and copied
+     * into a dsl::list with to_list where a growable container is needed.
+     *
+     * Every slot holds a live Tp, so Tp must be default constructible (and a literal type for
+     * constant evaluation). Slots past size() hold value-initialized elements: erased elements
+     * are reset to Tp(), releasing whatever they own.
+     *
+     * @tparam Tp
+     * @tparam N Capacity
+     */
+    template <typename Tp, std::size_t N>
+    class static_list {
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = Tp;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+
+        using iterator = typename details::list_iterator<Tp>;
+        using const_iterator = typename details::list_const_iterator<Tp>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        constexpr static_list() noexcept(std::is_nothrow_default_constructible_v<Tp>)
+            : m_data()
+            , m_size(0)
+        {}
+
+        constexpr static_list(const size_type count, const Tp &value)
+            : static_list()
+        { resize(count, value); }
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        constexpr static_list(InputIt first, InputIt last)
+            : static_list()
+        { insert(cend(), first, last); }
+
+        constexpr static_list(std::initializer_list<Tp> init)
+            : static_list(init.begin(), init.end())
+        {}
+
+
+        //* Element Access *//
+
+        constexpr reference at(const size_type);
+        constexpr const_reference at(const size_type) const;
+
+        constexpr reference operator[](const size_type pos) {
+            return m_data[pos];
+        }
+
+        constexpr const_reference operator[](const size_type pos) const {
+            return m_data[pos];
+        }
+
+        constexpr reference front() {
+            return m_data[0];
+        }
+
+        constexpr const_reference front() const {
+            return m_data[0];
+        }
+
+        constexpr reference back() {
+            return m_data[m_size - 1];
+        }
+
+        constexpr const_reference back() const {
+            return m_data[m_size - 1];
+        }
+
+        constexpr Tp* data() noexcept {
+            return m_data;
+        }
+
+        constexpr const Tp* data() const noexcept {
+            return m_data;
+        }
+
+
+        //* Iterators *//
+
+        constexpr iterator begin() noexcept {
+            return iterator(m_data);
+        }
+
+        constexpr const_iterator begin() const noexcept {
+            return const_iterator(m_data);
+        }
+
+        constexpr const_iterator cbegin() const noexcept {
+            return const_iterator(m_data);
+        }
+
+        constexpr iterator end() noexcept {
+            return iterator(m_data + m_size);
+        }
+
+        constexpr const_iterator end() const noexcept {
+            return const_iterator(m_data + m_size);
+        }
+
+        constexpr const_iterator cend() const noexcept {
+            return const_iterator(m_data + m_size);
+        }
+
+        constexpr reverse_iterator rbegin() noexcept {
+            return reverse_iterator(end());
+        }
+
+        constexpr const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+
+        constexpr const_reverse_iterator crbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+
+        constexpr reverse_iterator rend() noexcept {
+            return reverse_iterator(begin());
+        }
+
+        constexpr const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+
+        constexpr const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+
+
+        //* Capacity *//
+
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] constexpr bool full() const noexcept {
+            return m_size == N;
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept {
+            return m_size;
+        }
+
+        [[nodiscard]] static constexpr size_type max_size() noexcept {
+            return N;
+        }
+
+        [[nodiscard]] static constexpr size_type capacity() noexcept {
+            return N;
+        }
+
+
+        //* Modifiers *//
+
+        constexpr void clear();
+
+        constexpr iterator insert(const_iterator, const Tp&);
+        constexpr iterator insert(const_iterator, Tp&&);
+        constexpr iterator insert(const_iterator, size_type, const Tp&);
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        constexpr iterator insert(const_iterator, InputIt, InputIt);
+
+        constexpr iterator insert(const_iterator, std::initializer_list<Tp>);
+
+        template <class... Args>
+        constexpr iterator emplace(const_iterator, Args&&...);
+
+        constexpr iterator erase(const_iterator);
+        constexpr iterator erase(const_iterator, const_iterator);
+
+        constexpr void push_back(const Tp&);
+        constexpr void push_back(Tp&&);
+
+        template <class... Args>
+        constexpr reference emplace_back(Args&&...);
+
+        constexpr void pop_back();
+
+        constexpr void resize(const size_type);
+        constexpr void resize(const size_type, const Tp&);
+
+        constexpr void swap(static_list&) noexcept(std::is_nothrow_move_constructible_v<Tp> && 
+                                                   std::is_nothrow_move_assignable_v<Tp>);
+
+
+        //* Conversion *//
+
+        list<Tp> to_list(typename list<Tp>::allocator_type = {}) const;
+
+
+    private:
+
+        //*** Members ***//
+
+        Tp m_data[N ? N : 1];
+        size_type m_size;
+
+
+        //*** Functions ***//
+
+        constexpr void check_room(const size_type) const;
+        constexpr size_type shift_back(const size_type, const size_type);
+        constexpr void reverse(size_type, size_type);
+
+        static constexpr void swap_elements(Tp&, Tp&);
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    template <typename Tp, std::size_t N>
+    constexpr void static_list<Tp, N>::check_room(const size_type count) const {
+        if (count > N - m_size)
+            throw std::length_error("New size cannot be larger than the static list capacity.");
+    }
+
+    /**
+     * @brief Opens a gap of count slots at index by moving the elements from index onwards back.
+     * Returns index.
+     */
+    template <typename Tp, std::size_t N>
+    constexpr typename static_list<Tp, N>::size_type static_list<Tp, N>::shift_back(const size_type index, const size_type count) {
+        check_room(count);
+        for (auto i = m_size; i-- > index;)
+            m_data[i + count] = std::move(m_data[i]);
+        m_size += count;
+        return index;
+    }
+
+
+    /**
+     * @brief Reverses the elements in [first, last). std::swap and std::reverse only become
+     * constexpr in C++20, hence the hand-written moves.
+     */
+    template <typename Tp, std::size_t N>
+    constexpr void static_list<Tp, N>::reverse(size_type first, size_type last) {
+        for (; first + 1 < last; ++first, --last)
+            swap_elements(m_data[first], m_data[last - 1]);
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr void static_list<Tp, N>::swap_elements(Tp &lhs, Tp &rhs) {
+        Tp tmp(std::move(lhs));
+        lhs = std::move(rhs);
+        rhs = std::move(tmp);
+    }
+
+
+    //*** Public ***//
+
+    //* Element Access *//
+
+    template <typename Tp, std::size_t N>
+    constexpr typename static_list<Tp, N>::reference static_list<Tp, N>::at(const size_type pos) {
+        if (pos >= m_size)
+            throw std::out_of_range("Index out of bounds.");
+        return m_data[pos];
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr typename static_list<Tp, N>::const_reference static_list<Tp, N>::at(const size_type pos) const {
+        if (pos >= m_size)
+            throw std::out_of_range("Index out of bounds.");
+        return m_data[pos];
+    }
+
+
+    //* Modifiers *//
+
+    template <typename Tp, std::size_t N>
+    constexpr void static_list<Tp, N>::clear() {
+        erase(cbegin(), cend());
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr typename static_list<Tp, N>::iterator static_list<Tp, N>::insert(const_iterator pos, const Tp &value) {
+        return emplace(pos, value);
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr typename static_list<Tp, N>::iterator static_list<Tp, N>::insert(const_iterator pos, Tp &&value) {
+        return emplace(pos, std::move(value));
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr typename static_list<Tp, N>::iterator static_list<Tp, N>::insert(const_iterator pos, const size_type count, const Tp &value) {
+        // Copy first, as value may refer to an element that is shifted below
+        Tp copy(value);
+        auto index = shift_back(static_cast<size_type>(pos - cbegin()), count);
+        for (size_type i = 0; i < count; ++i)
+            m_data[index + i] = copy;
+        return begin() + index;
+    }
+
+    /**
+     * @brief Inserts the elements of [first, last) before pos. Throws std::length_error, leaving the
+     * list unchanged, if they do not fit: forward ranges are measured before anything is inserted,
+     * and a single-pass range is truncated back to the old elements once it overflows.
+     */
+    template <typename Tp, std::size_t N>
+    template <class InputIt, typename>
+    constexpr typename static_list<Tp, N>::iterator static_list<Tp, N>::insert(const_iterator pos, InputIt first, InputIt last) {
+        auto index = static_cast<size_type>(pos - cbegin());
+        auto old_size = m_size;
+        if constexpr (std::is_convertible_v<typename std::iterator_traits<InputIt>::iterator_category, std::forward_iterator_tag>)
+            check_room(static_cast<size_type>(std::distance(first, last)));
+
+        for (; first != last; ++first) {
+            if (m_size == N) {
+                erase(cbegin() + old_size, cend());
+                throw std::length_error("New size cannot be larger than the static list capacity.");
+            }
+            emplace_back(*first);
+        }
+
+        // Rotate the appended elements into place
+        reverse(index, old_size);
+        reverse(old_size, m_size);
+        reverse(index, m_size);
+        return begin() + index;
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr typename static_list<Tp, N>::iterator static_list<Tp, N>::insert(const_iterator pos, std::initializer_list<Tp> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    template <typename Tp, std::size_t N>
+    template <class... Args>
+    constexpr typename static_list<Tp, N>::iterator static_list<Tp, N>::emplace(const_iterator pos, Args &&...args) {
+        // Construct first, as args may refer to an element that is shifted below
+        Tp value(std::forward<Args>(args)...);
+        auto index = shift_back(static_cast<size_type>(pos - cbegin()), 1);
+        m_data[index] = std::move(value);
+        return begin() + index;
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr typename static_list<Tp, N>::iterator static_list<Tp, N>::erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr typename static_list<Tp, N>::iterator static_list<Tp, N>::erase(const_iterator first, const_iterator last) {
+        auto index = static_cast<size_type>(first - cbegin());
+        auto count = static_cast<size_type>(last - first);
+
+        if (count) {
+            for (auto i = index; i + count < m_size; ++i)
+                m_data[i] = std::move(m_data[i + count]);
+            for (auto i = m_size - count; i < m_size; ++i)
+                m_data[i] = Tp();
+            m_size -= count;
+        }
+
+        return begin() + index;
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr void static_list<Tp, N>::push_back(const Tp &value) {
+        emplace_back(value);
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr void static_list<Tp, N>::push_back(Tp &&value) {
+        emplace_back(std::move(value));
+    }
+
+    template <typename Tp, std::size_t N>
+    template <class... Args>
+    constexpr typename static_list<Tp, N>::reference static_list<Tp, N>::emplace_back(Args &&...args) {
+        check_room(1);
+        m_data[m_size] = Tp(std::forward<Args>(args)...);
+        return m_data[m_size++];
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr void static_list<Tp, N>::pop_back() {
+        erase(cend() - 1);
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr void static_list<Tp, N>::resize(const size_type count) {
+        if (count < m_size)
+            erase(cbegin() + count, cend());
+        else
+            shift_back(m_size, count - m_size);
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr void static_list<Tp, N>::resize(const size_type count, const Tp &value) {
+        if (count < m_size)
+            erase(cbegin() + count, cend());
+        else
+            insert(cend(), count - m_size, value);
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr void static_list<Tp, N>::swap(static_list &other) noexcept(std::is_nothrow_move_constructible_v<Tp> && 
+                                                                         std::is_nothrow_move_assignable_v<Tp>) {
+        auto common = m_size < other.m_size ? other.m_size : m_size;
+        for (size_type i = 0; i < common; ++i)
+            swap_elements(m_data[i], other.m_data[i]);
+
+        auto size = m_size;
+        m_size = other.m_size;
+        other.m_size = size;
+    }
+
+
+    //* Conversion *//
+
+    template <typename Tp, std::size_t N>
+    list<Tp> static_list<Tp, N>::to_list(typename list<Tp>::allocator_type allocator) const {
+        return list<Tp>(cbegin(), cend(), allocator);
+    }
+
+
+    //*** Non-Member Function Implementations ***//
+
+    template <typename Tp, std::size_t N>
+    constexpr bool operator==(const static_list<Tp, N> &lhs, const static_list<Tp, N> &rhs) {
+        if (lhs.size() != rhs.size())
+            return false;
+
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            if (!(lhs[i] == rhs[i]))
+                return false;
+        }
+        return true;
+    }
+
+    template <typename Tp, std::size_t N>
+    constexpr bool operator!=(const static_list<Tp, N> &lhs, const static_list<Tp, N> &rhs) {
+        return !operator==(lhs, rhs);
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_STATIC_LIST_H
@@ -0,0 +1,285 @@
+#ifndef DSL_STATS_RESOURCE_H
+#define DSL_STATS_RESOURCE_H
+
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory_resource>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+namespace dsl {
+
+    /**
+     * @brief Snapshot of the allocation counters of a stats_resource. Allocation sizes are binned
+     * into power-of-two size classes: class k counts requests of at most 2^k bytes (and more than
+     * 2^(k-1) bytes), with the last class also collecting every larger request.
+     */
+    struct allocation_stats {
+        static constexpr std::size_t size_class_count = 32;
+
+        std::uint64_t allocations = 0;
+        std::uint64_t deallocations = 0;
+        std::uint64_t bytes_allocated = 0;
+        std::uint64_t bytes_deallocated = 0;
+        std::uint64_t bytes_live = 0;
+        std::uint64_t peak_bytes_live = 0;
+        std::array<std::uint64_t, size_class_count> size_classes{};
+        double elapsed_seconds = 0.0;
+
+        // Allocations per second since the counters were last reset
+        [[nodiscard]] double allocation_rate() const noexcept {
+            return elapsed_seconds > 0.0 ? static_cast<double>(allocations) / elapsed_seconds : 0.0;
+        }
+
+        [[nodiscard]] static std::size_t size_class(std::size_t bytes) noexcept {
+            if (bytes <= 1)
+                return 0;
+
+            std::size_t k = 0;
+            for (--bytes; bytes; bytes >>= 1)
+                ++k;
+            return k < size_class_count ? k : size_class_count - 1;
+        }
+
+        // Upper bound of class k in bytes, or the open lower bound of the last class, e.g. ">1073741824"
+        [[nodiscard]] static std::string size_class_label(const std::size_t k) {
+            if (k + 1 < size_class_count)
+                return std::to_string(std::uint64_t(1) << k);
+            return ">" + std::to_string(std::uint64_t(1) << (size_class_count - 2));
+        }
+    };
+
+
+    /**
+     * @brief Memory resource that forwards to an upstream resource while counting what passes
+     * through it. Every container takes a std::pmr::polymorphic_allocator<std::byte>, so a
+     * stats_resource can be attached to a single container (or a group of them) by constructing
+     * it with the address of the resource, e.g. dsl::list<int> values(&stats).
+     *
+     * The counters are atomic, so a stats_resource is as thread-safe as its upstream resource,
+     * except that reset() must not run concurrently with statistics() or a dump.
+     */
+    class stats_resource : public std::pmr::memory_resource {
+    public:
+
+        //*** Member Types ***//
+
+        enum class dump_format { json, text };
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit stats_resource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource(),
+                                std::string name = {})
+            : m_upstream(upstream)
+            , m_name(std::move(name))
+            , m_allocations(0)
+            , m_deallocations(0)
+            , m_bytes_allocated(0)
+            , m_bytes_deallocated(0)
+            , m_bytes_live(0)
+            , m_peak_bytes_live(0)
+            , m_size_classes()
+            , m_start(std::chrono::steady_clock::now())
+        {}
+
+        stats_resource(const stats_resource&) = delete;
+        stats_resource& operator=(const stats_resource&) = delete;
+
+
+        //* Access *//
+
+        [[nodiscard]] std::pmr::memory_resource* upstream_resource() const noexcept {
+            return m_upstream;
+        }
+
+        [[nodiscard]] const std::string& name() const noexcept {
+            return m_name;
+        }
+
+
+        //* Statistics *//
+
+        allocation_stats statistics() const noexcept;
+        void reset() noexcept;
+
+        void write_json(std::ostream&) const;
+        void write_text(std::ostream&) const;
+        void dump(const std::string&, const dump_format = dump_format::json) const;
+
+
+    protected:
+        void* do_allocate(std::size_t, std::size_t) override;
+        void do_deallocate(void*, std::size_t, std::size_t) override;
+        bool do_is_equal(const std::pmr::memory_resource&) const noexcept override;
+
+
+    private:
+
+        //*** Members ***//
+
+        std::pmr::memory_resource *m_upstream;
+        std::string m_name;
+
+        std::atomic<std::uint64_t> m_allocations;
+        std::atomic<std::uint64_t> m_deallocations;
+        std::atomic<std::uint64_t> m_bytes_allocated;
+        std::atomic<std::uint64_t> m_bytes_deallocated;
+        std::atomic<std::uint64_t> m_bytes_live;
+        std::atomic<std::uint64_t> m_peak_bytes_live;
+        std::array<std::atomic<std::uint64_t>, allocation_stats::size_class_count> m_size_classes;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Protected ***//
+
+    inline void* stats_resource::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+        auto p = m_upstream->allocate(bytes, alignment);
+
+        m_allocations.fetch_add(1, std::memory_order_relaxed);
+        m_bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+        m_size_classes[allocation_stats::size_class(bytes)].fetch_add(1, std::memory_order_relaxed);
+
+        auto live = m_bytes_live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        auto peak = m_peak_bytes_live.load(std::memory_order_relaxed);
+        while (live > peak && !m_peak_bytes_live.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            ;
+
+        return p;
+    }
+
+    inline void stats_resource::do_deallocate(void *p, const std::size_t bytes, const std::size_t alignment) {
+        m_upstream->deallocate(p, bytes, alignment);
+
+        m_deallocations.fetch_add(1, std::memory_order_relaxed);
+        m_bytes_deallocated.fetch_add(bytes, std::memory_order_relaxed);
+        m_bytes_live.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    inline bool stats_resource::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+        return this == &other;
+    }
+
+
+    //*** Public ***//
+
+    //* Statistics *//
+
+    /**
+     * @brief Reads the counters. Each counter is read atomically, but under concurrent allocation
+     * the snapshot as a whole is not taken at a single instant.
+     */
+    inline allocation_stats stats_resource::statistics() const noexcept {
+        allocation_stats stats;
+        stats.allocations = m_allocations.load(std::memory_order_relaxed);
+        stats.deallocations = m_deallocations.load(std::memory_order_relaxed);
+        stats.bytes_allocated = m_bytes_allocated.load(std::memory_order_relaxed);
+        stats.bytes_deallocated = m_bytes_deallocated.load(std::memory_order_relaxed);
+        stats.bytes_live = m_bytes_live.load(std::memory_order_relaxed);
+        stats.peak_bytes_live = m_peak_bytes_live.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < allocation_stats::size_class_count; ++i)
+            stats.size_classes[i] = m_size_classes[i].load(std::memory_order_relaxed);
+
+        stats.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+        return stats;
+    }
+
+    /**
+     * @brief Zeroes the cumulative counters and restarts the rate clock. Live bytes are still
+     * outstanding, so they are kept and become the new peak.
+     */
+    inline void stats_resource::reset() noexcept {
+        m_allocations.store(0, std::memory_order_relaxed);
+        m_deallocations.store(0, std::memory_order_relaxed);
+        m_bytes_allocated.store(0, std::memory_order_relaxed);
+        m_bytes_deallocated.store(0, std::memory_order_relaxed);
+        m_peak_bytes_live.store(m_bytes_live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        for (auto &count : m_size_classes)
+            count.store(0, std::memory_order_relaxed);
+
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    inline void stats_resource::write_json(std::ostream &os) const {
+        auto stats = statistics();
+
+        os << "{\"name\":\"";
+        for (auto c : m_name) {
+            if (c == '"' || c == '\\')
+                os << '\\' << c;
+            else if (static_cast<unsigned char>(c) >= 0x20)
+                os << c;
+        }
+
+        os << "\",\"allocations\":" << stats.allocations
+           << ",\"deallocations\":" << stats.deallocations
+           << ",\"bytes_allocated\":" << stats.bytes_allocated
+           << ",\"bytes_deallocated\":" << stats.bytes_deallocated
+           << ",\"bytes_live\":" << stats.bytes_live
+           << ",\"peak_bytes_live\":" << stats.peak_bytes_live
+           << ",\"elapsed_seconds\":" << stats.elapsed_seconds
+           << ",\"allocation_rate\":" << stats.allocation_rate()
+           << ",\"size_classes\":{";
+
+        bool first = true;
+        for (std::size_t i = 0; i < allocation_stats::size_class_count; ++i) {
+            if (!stats.size_classes[i])
+                continue;
+
+            os << (first ? "" : ",") << '"' << allocation_stats::size_class_label(i) << "\":" << stats.size_classes[i];
+            first = false;
+        }
+        os << "}}\n";
+    }
+
+    inline void stats_resource::write_text(std::ostream &os) const {
+        auto stats = statistics();
+
+        os << "stats_resource " << (m_name.empty() ? "(unnamed)" : m_name) << '\n'
+           << "  allocations:       " << stats.allocations << '\n'
+           << "  deallocations:     " << stats.deallocations << '\n'
+           << "  bytes allocated:   " << stats.bytes_allocated << '\n'
+           << "  bytes deallocated: " << stats.bytes_deallocated << '\n'
+           << "  bytes live:        " << stats.bytes_live << '\n'
+           << "  peak bytes live:   " << stats.peak_bytes_live << '\n'
+           << "  allocations/s:     " << stats.allocation_rate() << '\n'
+           << "  size classes (<= bytes: count):\n";
+
+        for (std::size_t i = 0; i < allocation_stats::size_class_count; ++i) {
+            if (stats.size_classes[i])
+                os << "    " << allocation_stats::size_class_label(i) << ": " << stats.size_classes[i] << '\n';
+        }
+    }
+
+    /**
+     * @brief Appends the current statistics to the file at path, so that repeated dumps build a log.
+     */
+    inline void stats_resource::dump(const std::string &path, const dump_format format) const {
+        std::ofstream file(path, std::ios::app);
+        if (!file)
+            throw std::runtime_error("Unable to open " + path + " for writing.");
+
+        if (format == dump_format::json)
+            write_json(file);
+        else
+            write_text(file);
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_STATS_RESOURCE_H
@@ -0,0 +1,414 @@
+#ifndef DSL_STRING_LIST_H
+#define DSL_STRING_LIST_H
+
+
+#include "list.h"
+#include "packed_list.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+
+
+namespace dsl {
+
+    /**
+     * @brief Sequence of strings whose characters all live in one growing list<char>, with each
+     * element recorded as an (offset, length) span and accessed as a std::string_view. Appending
+     * a string costs no allocation of its own, and scanning the list reads the characters in the
+     * order they were appended.
+     *
+     * Because elements are spans, sort() permutes the spans without moving characters, and with
+     * interning enabled, equal strings share the bytes of the first copy through a flat
+     * open-addressing table of spans. compact() rewrites the characters in element order,
+     * restoring locality after a sort and dropping bytes no longer referenced.
+     *
+     * Views stay valid until the character buffer grows, or until compact() or clear().
+     */
+    class string_list {
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = std::string_view;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::string_view;
+        using const_reference = std::string_view;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        using iterator = details::index_iterator<string_list, true>;
+        using const_iterator = iterator;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit string_list(allocator_type allocator = {})
+            : m_chars(allocator)
+            , m_spans(allocator)
+            , m_table(allocator)
+            , m_interned(0)
+            , m_interning(false)
+            , m_shared(false)
+        {}
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        string_list(InputIt first, InputIt last, allocator_type allocator = {})
+            : string_list(allocator)
+        {
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+
+        string_list(std::initializer_list<std::string_view> init, allocator_type allocator = {})
+            : string_list(init.begin(), init.end(), allocator)
+        {}
+
+
+        //* Element Access *//
+
+        std::string_view operator[](const size_type pos) const noexcept {
+            return view(m_spans[pos]);
+        }
+
+        std::string_view at(const size_type pos) const {
+            if (pos >= size())
+                throw std::out_of_range("Index out of bounds.");
+            return (*this)[pos];
+        }
+
+        std::string_view front() const noexcept { return (*this)[0]; }
+        std::string_view back() const noexcept { return (*this)[size() - 1]; }
+
+        allocator_type get_allocator() const noexcept {
+            return m_spans.get_allocator();
+        }
+
+
+        //* Iterators *//
+
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator end() const noexcept { return const_iterator(this, size()); }
+        const_iterator cend() const noexcept { return end(); }
+
+
+        //* Capacity *//
+
+        [[nodiscard]] bool empty() const noexcept {
+            return m_spans.empty();
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return m_spans.size();
+        }
+
+        // Bytes in the character buffer, including those of strings since popped or compacted away
+        [[nodiscard]] size_type char_count() const noexcept {
+            return m_chars.size();
+        }
+
+        void reserve(const size_type count, const size_type chars = 0) {
+            m_spans.reserve(count);
+            m_chars.reserve(chars);
+        }
+
+        void shrink_to_fit() {
+            m_spans.shrink_to_fit();
+            m_chars.shrink_to_fit();
+        }
+
+
+        //* Modifiers *//
+
+        void clear() noexcept {
+            m_chars.clear();
+            m_spans.clear();
+            m_table.clear();
+            m_interned = 0;
+            m_shared = m_interning;
+        }
+
+        void push_back(const std::string_view);
+
+        void pop_back() noexcept {
+            auto span = m_spans.back();
+            m_spans.pop_back();
+            if (!m_shared && span.m_offset + span.m_length == m_chars.size())
+                m_chars.resize(span.m_offset);
+        }
+
+        size_type append_lines(std::string_view, const char = '\n');
+
+        void swap(string_list &other) {
+            m_chars.swap(other.m_chars);
+            m_spans.swap(other.m_spans);
+            m_table.swap(other.m_table);
+            std::swap(m_interned, other.m_interned);
+            std::swap(m_interning, other.m_interning);
+            std::swap(m_shared, other.m_shared);
+        }
+
+
+        //* Interning *//
+
+        [[nodiscard]] bool interning() const noexcept {
+            return m_interning;
+        }
+
+        void set_interning(const bool);
+
+
+        //* Operations *//
+
+        template <class Compare = std::less<>>
+        void sort(Compare comp = {}) {
+            std::sort(m_spans.begin(), m_spans.end(),
+                      [this, &comp](const span_t &lhs, const span_t &rhs) { return comp(view(lhs), view(rhs)); });
+        }
+
+        template <class Compare = std::less<>>
+        list<size_type> sorted_permutation(Compare comp = {}) const {
+            list<size_type> permutation(size(), 0, get_allocator());
+            std::iota(permutation.begin(), permutation.end(), size_type(0));
+            std::stable_sort(permutation.begin(), permutation.end(),
+                             [this, &comp](const size_type lhs, const size_type rhs) { return comp((*this)[lhs], (*this)[rhs]); });
+            return permutation;
+        }
+
+        void compact();
+
+
+        //*** Non-Member Functions ***//
+
+        friend bool operator==(const string_list &lhs, const string_list &rhs) {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator!=(const string_list &lhs, const string_list &rhs) {
+            return !(lhs == rhs);
+        }
+
+
+    private:
+
+        //*** Members ***//
+
+        struct span_t {
+            size_type m_offset;
+            size_type m_length;
+        };
+
+        struct slot_t {
+            span_t m_span;
+            std::size_t m_hash;
+        };
+
+        static constexpr size_type vacant_offset = std::numeric_limits<size_type>::max();
+        static constexpr size_type initial_slots = 16;
+
+        list<char> m_chars;
+        list<span_t> m_spans;
+        list<slot_t> m_table;
+        size_type m_interned;
+        bool m_interning;
+        bool m_shared;      // Spans may share bytes, as interning has been on since the last clear or compact
+
+
+        //*** Functions ***//
+
+        std::string_view view(const span_t &span) const noexcept {
+            return std::string_view(m_chars.data() + span.m_offset, span.m_length);
+        }
+
+        // Whether str views this list's own characters, e.g. in push_back(list[0])
+        bool aliases(const std::string_view str) const noexcept {
+            auto first = m_chars.data();
+            return first && !std::less<const char*>()(str.data(), first)
+                         && std::less<const char*>()(str.data(), first + m_chars.size());
+        }
+
+        span_t copy_chars(std::string_view str) {
+            span_t span{ m_chars.size(), str.size() };
+            if (str.size() > m_chars.capacity() - m_chars.size()) {
+                auto aliased = aliases(str);
+                auto offset = aliased ? static_cast<size_type>(str.data() - m_chars.data()) : 0;
+
+                grow(m_chars, m_chars.size() + str.size());
+                if (aliased)
+                    str = std::string_view(m_chars.data() + offset, str.size());
+            }
+            m_chars.insert(m_chars.end(), str.begin(), str.end());
+            return span;
+        }
+
+        // Reserves at least count elements, growing geometrically across repeated bulk appends
+        template <class List>
+        static void grow(List &list, const size_type count) {
+            if (count > list.capacity())
+                list.reserve(std::max(count, list.capacity() + list.capacity() / 2));
+        }
+
+        const span_t* find_interned(const std::string_view, const std::size_t) noexcept;
+        span_t intern(const std::string_view);
+        void place_slot(const span_t&, const std::size_t) noexcept;
+        void rehash(const size_type);
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    /**
+     * @brief Returns the interned span equal to str, or nullptr.
+     */
+    inline const string_list::span_t* string_list::find_interned(const std::string_view str, const std::size_t hash) noexcept {
+        auto mask = m_table.size() - 1;
+        for (auto i = hash & mask; m_table[i].m_span.m_offset != vacant_offset; i = (i + 1) & mask) {
+            if (m_table[i].m_hash == hash && view(m_table[i].m_span) == str)
+                return &m_table[i].m_span;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Returns the span of an equal string already interned, or copies str and interns it.
+     */
+    inline string_list::span_t string_list::intern(const std::string_view str) {
+        if ((m_interned + 1) * 2 > m_table.size())
+            rehash(std::max(m_table.size() * 2, initial_slots));
+
+        auto hash = std::hash<std::string_view>()(str);
+        if (auto found = find_interned(str, hash))
+            return *found;
+
+        auto span = copy_chars(str);
+        place_slot(span, hash);
+        ++m_interned;
+        return span;
+    }
+
+    inline void string_list::place_slot(const span_t &span, const std::size_t hash) noexcept {
+        auto mask = m_table.size() - 1;
+        auto i = hash & mask;
+        while (m_table[i].m_span.m_offset != vacant_offset)
+            i = (i + 1) & mask;
+        m_table[i] = slot_t{ span, hash };
+    }
+
+    inline void string_list::rehash(const size_type slot_count) {
+        list<slot_t> table(slot_count, slot_t{ { vacant_offset, 0 }, 0 }, get_allocator());
+        table.swap(m_table);
+
+        for (const auto &slot : table) {
+            if (slot.m_span.m_offset != vacant_offset)
+                place_slot(slot.m_span, slot.m_hash);
+        }
+    }
+
+
+    //*** Public ***//
+
+    //* Modifiers *//
+
+    inline void string_list::push_back(const std::string_view str) {
+        m_spans.push_back(m_interning ? intern(str) : copy_chars(str));
+    }
+
+    /**
+     * @brief Appends every delimiter-terminated string of buffer, and the unterminated remainder
+     * if it is not empty. Returns the number of strings appended.
+     */
+    inline string_list::size_type string_list::append_lines(std::string_view buffer, const char delimiter) {
+        auto delimiters = static_cast<size_type>(std::count(buffer.begin(), buffer.end(), delimiter));
+        auto count = delimiters + (!buffer.empty() && buffer.back() != delimiter ? 1 : 0);
+
+        grow(m_spans, size() + count);
+        // An aliased buffer is rebased once, after which the characters cannot move again
+        if (aliases(buffer)) {
+            auto offset = static_cast<size_type>(buffer.data() - m_chars.data());
+            grow(m_chars, m_chars.size() + buffer.size() - delimiters);
+            buffer = std::string_view(m_chars.data() + offset, buffer.size());
+        } else if (!m_interning) {
+            grow(m_chars, m_chars.size() + buffer.size() - delimiters);
+        }
+
+        for (size_type start = 0, appended = 0; appended < count; ++appended) {
+            auto end = std::min(buffer.find(delimiter, start), buffer.size());
+            push_back(buffer.substr(start, end - start));
+            start = end + 1;
+        }
+        return count;
+    }
+
+
+    //* Interning *//
+
+    /**
+     * @brief Enables or disables interning of strings appended from now on. Enabling it indexes
+     * the current elements, so later duplicates of them are shared as well.
+     */
+    inline void string_list::set_interning(const bool enabled) {
+        if (enabled == m_interning)
+            return;
+
+        m_table.clear();
+        m_interned = 0;
+        m_interning = enabled;
+        if (!enabled)
+            return;
+
+        // Existing strings are registered in place rather than copied
+        m_shared = true;
+        for (auto &span : m_spans) {
+            if ((m_interned + 1) * 2 > m_table.size())
+                rehash(std::max(m_table.size() * 2, initial_slots));
+
+            auto str = view(span);
+            auto hash = std::hash<std::string_view>()(str);
+            if (auto found = find_interned(str, hash)) {
+                span = *found;
+            } else {
+                place_slot(span, hash);
+                ++m_interned;
+            }
+        }
+    }
+
+
+    //* Operations *//
+
+    /**
+     * @brief Rewrites the characters in element order into a new buffer, keeping strings shared
+     * through interning shared, and rebuilding the intern table. The buffer, spans and table are
+     * built aside and swapped in at the end, so the list is left unchanged if an allocation fails.
+     */
+    inline void string_list::compact() {
+        size_type total = 0;
+        for (const auto &span : m_spans)
+            total += span.m_length;
+
+        string_list compacted(get_allocator());
+        compacted.m_interning = compacted.m_shared = m_interning;
+        compacted.m_chars.reserve(m_interning ? std::min(total, m_chars.size()) : total);
+        compacted.m_spans.reserve(m_spans.size());
+
+        for (const auto &span : m_spans)
+            compacted.push_back(view(span));
+        swap(compacted);
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_STRING_LIST_H
@@ -0,0 +1,1608 @@
+#ifndef DSL_TREE_SEQUENCE_H
+#define DSL_TREE_SEQUENCE_H
+
+
+#include "list.h"
+#include "list_base.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace dsl {
+
+    template <typename Tp> class tree_sequence;
+
+    namespace details {
+
+        /**
+         * @brief Number of elements stored contiguously in a single leaf of a tree_sequence, chosen
+         * so that a leaf spans roughly eight cache lines.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        inline constexpr std::size_t tree_leaf_capacity = std::max<std::size_t>(8, 512 / sizeof(Tp));
+
+        /**
+         * @brief Number of children of an internal node of a tree_sequence.
+         */
+        inline constexpr std::size_t tree_branch_factor = 32;
+
+        /**
+         * @brief Header shared by the leaves and internal nodes of a tree_sequence. Leaves have
+         * height 0, and m_count holds the number of elements of a leaf or children of an internal node.
+         */
+        struct tree_node_base {
+            std::uint16_t m_height;
+            std::uint16_t m_count;
+        };
+
+        /**
+         * @brief Internal node of a tree_sequence. Caches the number of elements below each child,
+         * so that positions are resolved without visiting the leaves.
+         */
+        struct tree_internal : tree_node_base {
+            std::size_t m_sizes[tree_branch_factor];
+            tree_node_base *m_children[tree_branch_factor];
+        };
+
+        /**
+         * @brief Leaf of a tree_sequence, holding its elements contiguously in raw storage. Leaves
+         * are chained in both directions so that iteration never has to climb the tree.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        struct tree_leaf : tree_node_base {
+            tree_leaf *m_prev;
+            tree_leaf *m_next;
+            alignas(Tp) std::byte m_storage[tree_leaf_capacity<Tp> * sizeof(Tp)];
+
+            Tp* data() noexcept {
+                return std::launder(reinterpret_cast<Tp*>(m_storage));
+            }
+        };
+
+
+        /**
+         * @brief Iterator with const pointer and reference member types.
+         * Adheres to the named requirements of LegacyBidirectionalIterator.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        class tree_const_iterator : public iterator_base<Tp> {
+        public:
+
+            //*** Member Types ***//
+
+            using value_type = typename iterator_base<Tp>::value_type;
+            using difference_type = typename iterator_base<Tp>::difference_type;
+
+            using iterator_category = std::bidirectional_iterator_tag;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+
+            //*** Member Functions ***//
+
+            tree_const_iterator() noexcept
+                : m_leaf(nullptr)
+                , m_index(0) {}
+
+            [[nodiscard]] pointer operator->() const noexcept {
+                return m_leaf->data() + m_index;
+            }
+
+            [[nodiscard]] reference operator*() const noexcept {
+                return m_leaf->data()[m_index];
+            }
+
+            tree_const_iterator& operator++() noexcept {
+                if (++m_index == m_leaf->m_count && m_leaf->m_next) {
+                    m_leaf = m_leaf->m_next;
+                    m_index = 0;
+                }
+                return *this;
+            }
+
+            tree_const_iterator operator++(int) noexcept {
+                tree_const_iterator it(*this);
+                ++(*this);
+                return it;
+            }
+
+            tree_const_iterator& operator--() noexcept {
+                if (m_index == 0) {
+                    m_leaf = m_leaf->m_prev;
+                    m_index = m_leaf->m_count;
+                }
+                --m_index;
+                return *this;
+            }
+
+            tree_const_iterator operator--(int) noexcept {
+                tree_const_iterator it(*this);
+                --(*this);
+                return it;
+            }
+
+            bool operator==(const tree_const_iterator &other) const noexcept {
+                return m_leaf == other.m_leaf && m_index == other.m_index;
+            }
+
+            bool operator!=(const tree_const_iterator &other) const noexcept {
+                return !operator==(other);
+            }
+
+
+        protected:
+            friend class tree_sequence<Tp>;
+
+            tree_leaf<Tp> *m_leaf;
+            std::size_t m_index;
+
+            // Non-public explicit constructor to enable iterator construction for derived classes and friend classes
+            tree_const_iterator(const tree_leaf<Tp> *leaf, const std::size_t index) noexcept
+                : m_leaf(const_cast<tree_leaf<Tp>*>(leaf))
+                , m_index(index) {}
+        };
+
+
+        /**
+         * @brief Iterator with non-const pointer and reference member types.
+         * Adheres to the named requirements of LegacyBidirectionalIterator.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        class tree_iterator : public tree_const_iterator<Tp> {
+        public:
+
+            //*** Member Types ***//
+
+            using base_t = tree_const_iterator<Tp>;
+            using value_type = typename base_t::value_type;
+
+            using pointer = value_type*;
+            using reference = value_type&;
+
+
+            //*** Member Functions ***//
+
+            tree_iterator() noexcept
+                : tree_const_iterator<Tp>() {}
+
+            [[nodiscard]] pointer operator->() const noexcept {
+                return this->m_leaf->data() + this->m_index;
+            }
+
+            [[nodiscard]] reference operator*() const noexcept {
+                return this->m_leaf->data()[this->m_index];
+            }
+
+            tree_iterator& operator++() noexcept {
+                base_t::operator++();
+                return *this;
+            }
+
+            tree_iterator operator++(int) noexcept {
+                tree_iterator it(*this);
+                ++(*this);
+                return it;
+            }
+
+            tree_iterator& operator--() noexcept {
+                base_t::operator--();
+                return *this;
+            }
+
+            tree_iterator operator--(int) noexcept {
+                tree_iterator it(*this);
+                --(*this);
+                return it;
+            }
+
+
+        private:
+            friend class tree_sequence<Tp>;
+
+            tree_iterator(const tree_leaf<Tp> *leaf, const std::size_t index) noexcept
+                : tree_const_iterator<Tp>(leaf, index) {}
+        };
+
+    }   // namespace details
+
+
+    /**
+     * @brief Sequence container backed by a B+tree whose internal nodes count the elements below
+     * each child. Indexing, insertion and removal at any position take O(log n), as do split and
+     * concatenation, while the elements themselves are stored contiguously in chained leaves so
+     * that sequential iteration runs at close to array speed.
+     *
+     * Insertion and removal invalidate all iterators and references.
+     *
+     * @tparam Tp
+     */
+    template <typename Tp>
+    class tree_sequence : public details::list_base<tree_sequence<Tp>, Tp> {
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = typename details::list_base<tree_sequence<Tp>, Tp>::value_type;
+        using size_type = typename details::list_base<tree_sequence<Tp>, Tp>::size_type;
+        using difference_type = typename details::list_base<tree_sequence<Tp>, Tp>::difference_type;
+
+        using reference = typename details::list_base<tree_sequence<Tp>, Tp>::reference;
+        using const_reference = typename details::list_base<tree_sequence<Tp>, Tp>::const_reference;
+
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+        using pointer = std::allocator_traits<allocator_type>::pointer;
+        using const_pointer = std::allocator_traits<allocator_type>::const_pointer;
+
+        using iterator = typename details::tree_iterator<Tp>;
+        using const_iterator = typename details::tree_const_iterator<Tp>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        static constexpr size_type leaf_capacity = details::tree_leaf_capacity<Tp>;
+        static constexpr size_type branch_factor = details::tree_branch_factor;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit tree_sequence(allocator_type allocator = {})
+            : details::list_base<tree_sequence<Tp>, Tp>()
+            , m_allocator(allocator)
+            , m_root(nullptr)
+            , m_first(nullptr)
+            , m_last(nullptr)
+        {}
+
+        tree_sequence(const size_type count,
+                      const Tp &value,
+                      allocator_type allocator = {})
+            : tree_sequence(allocator)
+        { insert(0, count, value); }
+
+        explicit tree_sequence(const size_type count,
+                               allocator_type allocator = {})
+            : tree_sequence(count, Tp(), allocator)
+        {}
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        tree_sequence(InputIt first, InputIt last,
+                      allocator_type allocator = {})
+            : tree_sequence(allocator)
+        { insert(0, first, last); }
+
+        tree_sequence(std::initializer_list<Tp> init,
+                      allocator_type allocator = {})
+            : tree_sequence(init.begin(), init.end(), allocator)
+        {}
+
+
+        //* Copy Constructors *//
+
+        tree_sequence(const tree_sequence &other,
+                      allocator_type allocator)
+            : tree_sequence(other.begin(), other.end(), allocator)
+        {}
+
+        tree_sequence(const tree_sequence &other)
+            : tree_sequence(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator()))
+        {}
+
+
+        //* Move Constructors *//
+
+        tree_sequence(tree_sequence &&other,
+                      allocator_type allocator)
+            : tree_sequence(allocator)
+        { operator=(std::move(other)); }
+
+        tree_sequence(tree_sequence &&other) noexcept
+            : tree_sequence(other.get_allocator())
+        { swap(other); }
+
+
+        //* Destructor *//
+        ~tree_sequence() {
+            clear();
+        }
+
+
+        //* Assignment operator overloads *//
+
+        tree_sequence& operator=(const tree_sequence&);
+        tree_sequence& operator=(tree_sequence&&);
+
+
+        //* Allocator access *//
+
+        allocator_type get_allocator() const noexcept;
+
+
+        //* Element Access *//
+
+        reference at(const size_type);
+        const_reference at(const size_type) const;
+
+        reference operator[](const size_type) noexcept;
+        const_reference operator[](const size_type) const noexcept;
+
+        reference front() {
+            return m_first->data()[0];
+        }
+
+        const_reference front() const {
+            return m_first->data()[0];
+        }
+
+        reference back() {
+            return m_last->data()[m_last->m_count - 1];
+        }
+
+        const_reference back() const {
+            return m_last->data()[m_last->m_count - 1];
+        }
+
+
+        //* Iterators *//
+
+        iterator begin() noexcept {
+            return iterator(m_first, 0);
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator(m_first, 0);
+        }
+
+        const_iterator cbegin() const noexcept {
+            return const_iterator(m_first, 0);
+        }
+
+        iterator end() noexcept {
+            return iterator(m_last, m_last ? m_last->m_count : 0);
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(m_last, m_last ? m_last->m_count : 0);
+        }
+
+        const_iterator cend() const noexcept {
+            return const_iterator(m_last, m_last ? m_last->m_count : 0);
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept {
+            return const_reverse_iterator(cend());
+        }
+
+        reverse_iterator rend() noexcept {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator(cbegin());
+        }
+
+
+        //* Modifiers *//
+
+        void clear() noexcept;
+
+        iterator insert(const size_type, const Tp&);
+        iterator insert(const size_type, Tp&&);
+        void insert(const size_type, size_type, const Tp&);
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        void insert(const size_type, InputIt, InputIt);
+
+        void insert(const size_type, std::initializer_list<Tp>);
+
+        template <class... Args>
+        iterator emplace(const size_type, Args&&...);
+
+        iterator erase(const size_type);
+        iterator erase(const size_type, const size_type);
+
+        void push_back(const Tp&);
+        void push_back(Tp&&);
+
+        template <class... Args>
+        reference emplace_back(Args&&...);
+
+        void pop_back();
+
+        void push_front(const Tp&);
+        void push_front(Tp&&);
+
+        template <class... Args>
+        reference emplace_front(Args&&...);
+
+        void pop_front();
+
+        void swap(tree_sequence&) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value);
+
+
+        //* Operations *//
+
+        tree_sequence split(const size_type);
+        void concat(tree_sequence&);
+        void concat(tree_sequence&&);
+
+
+    private:
+
+        //*** Using Directives ***//
+
+        using node_base_t = details::tree_node_base;
+        using internal_t = details::tree_internal;
+        using leaf_t = typename details::tree_leaf<Tp>;
+
+        // Bounds the height of the tree: internal nodes other than the root keep at least two children
+        static constexpr size_type max_depth = std::numeric_limits<size_type>::digits;
+
+
+        /**
+         * @brief Nodes allocated up front for a structural change, so that the change itself cannot
+         * fail part-way through. Nodes that end up unused are returned on destruction.
+         */
+        class node_reserve {
+        public:
+            node_reserve(tree_sequence &sequence, const size_type count, const size_type leaf_count = 0)
+                : m_sequence(sequence)
+                , m_count(0)
+                , m_leaf_count(0)
+            {
+                try {
+                    for (; m_count < count; ++m_count)
+                        m_nodes[m_count] = sequence.create_internal();
+                    for (; m_leaf_count < leaf_count; ++m_leaf_count)
+                        m_leaves[m_leaf_count] = sequence.create_leaf();
+                } catch (...) {
+                    release();
+                    throw;
+                }
+            }
+
+            node_reserve(const node_reserve&) = delete;
+            node_reserve& operator=(const node_reserve&) = delete;
+
+            ~node_reserve() {
+                release();
+            }
+
+            internal_t* take() noexcept {
+                return m_nodes[--m_count];
+            }
+
+            leaf_t* take_leaf() noexcept {
+                return m_leaves[--m_leaf_count];
+            }
+
+        private:
+            tree_sequence &m_sequence;
+            internal_t *m_nodes[max_depth + 1];
+            leaf_t *m_leaves[2];
+            size_type m_count;
+            size_type m_leaf_count;
+
+            void release() noexcept {
+                while (m_count)
+                    m_sequence.deallocate_node(m_nodes[--m_count]);
+                while (m_leaf_count)
+                    m_sequence.deallocate_node(m_leaves[--m_leaf_count]);
+            }
+        };
+
+
+        //*** Members ***//
+
+        allocator_type m_allocator;
+        node_base_t *m_root;
+        leaf_t *m_first;
+        leaf_t *m_last;
+
+
+        //*** Functions ***//
+
+        void check_bounds(const size_type) const;
+        void relocate(Tp*, const size_type, Tp*) noexcept;
+
+        leaf_t* create_leaf();
+        internal_t* create_internal();
+        void deallocate_node(node_base_t*) noexcept;
+        void destroy_subtree(node_base_t*) noexcept;
+
+        static size_type subtree_size(const node_base_t*) noexcept;
+        static bool underfull(const node_base_t*) noexcept;
+        static size_type full_suffix(internal_t**, const size_type) noexcept;
+
+        std::pair<leaf_t*, size_type> locate(size_type) const noexcept;
+        iterator iterator_at(const size_type) noexcept;
+        void refresh_ends() noexcept;
+
+        void insert_child(internal_t**, size_type*, size_type, node_base_t*, size_type, const size_type, node_reserve&) noexcept;
+        void rebalance(internal_t*, const size_type) noexcept;
+        void collapse_root() noexcept;
+        void fix_right_spine() noexcept;
+        void fix_left_spine() noexcept;
+
+        template <class Emit>
+        void build(Emit);
+        void insert_built(const size_type, tree_sequence&);
+        void split_off(const size_type, tree_sequence&, node_reserve&) noexcept;
+        size_type attach_path(const tree_sequence&, internal_t**, size_type*) const noexcept;
+        void attach(tree_sequence&, node_reserve&) noexcept;
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    template <typename Tp>
+    void tree_sequence<Tp>::check_bounds(const size_type pos) const {
+        if (pos >= this->m_size)
+            throw std::out_of_range("Index out of bounds.");
+    }
+
+    /**
+     * @brief Moves count elements from src into the uninitialized storage at dest, destroying the
+     * originals. The ranges may overlap. Trivially copyable types are relocated with a single memmove.
+     */
+    template <typename Tp>
+    void tree_sequence<Tp>::relocate(Tp *src, const size_type count, Tp *dest) noexcept {
+        if constexpr (std::is_trivially_copyable_v<Tp>) {
+            if (count)
+                std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), sizeof(Tp) * count);
+        } else if (dest < src) {
+            for (size_type i = 0; i < count; ++i) {
+                m_allocator.construct(dest + i, std::move(src[i]));
+                std::allocator_traits<allocator_type>::destroy(m_allocator, src + i);
+            }
+        } else {
+            for (size_type i = count; i-- > 0;) {
+                m_allocator.construct(dest + i, std::move(src[i]));
+                std::allocator_traits<allocator_type>::destroy(m_allocator, src + i);
+            }
+        }
+    }
+
+    template <typename Tp>
+    typename tree_sequence<Tp>::leaf_t* tree_sequence<Tp>::create_leaf() {
+        auto leaf = static_cast<leaf_t*>(m_allocator.resource()->allocate(sizeof(leaf_t), alignof(leaf_t)));
+        leaf->m_height = 0;
+        leaf->m_count = 0;
+        leaf->m_prev = leaf->m_next = nullptr;
+        return leaf;
+    }
+
+    template <typename Tp>
+    typename tree_sequence<Tp>::internal_t* tree_sequence<Tp>::create_internal() {
+        auto node = static_cast<internal_t*>(m_allocator.resource()->allocate(sizeof(internal_t), alignof(internal_t)));
+        node->m_height = 1;
+        node->m_count = 0;
+        return node;
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::deallocate_node(node_base_t *node) noexcept {
+        if (node->m_height)
+            m_allocator.resource()->deallocate(node, sizeof(internal_t), alignof(internal_t));
+        else
+            m_allocator.resource()->deallocate(node, sizeof(leaf_t), alignof(leaf_t));
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::destroy_subtree(node_base_t *node) noexcept {
+        if (node->m_height) {
+            auto parent = static_cast<internal_t*>(node);
+            for (size_type i = 0; i < parent->m_count; ++i)
+                destroy_subtree(parent->m_children[i]);
+        } else if constexpr (!std::is_trivially_destructible_v<Tp>) {
+            auto leaf = static_cast<leaf_t*>(node);
+            for (size_type i = 0; i < leaf->m_count; ++i)
+                std::allocator_traits<allocator_type>::destroy(m_allocator, leaf->data() + i);
+        }
+        deallocate_node(node);
+    }
+
+    template <typename Tp>
+    typename tree_sequence<Tp>::size_type tree_sequence<Tp>::subtree_size(const node_base_t *node) noexcept {
+        if (!node->m_height)
+            return node->m_count;
+
+        auto parent = static_cast<const internal_t*>(node);
+        size_type size = 0;
+        for (size_type i = 0; i < parent->m_count; ++i)
+            size += parent->m_sizes[i];
+        return size;
+    }
+
+    template <typename Tp>
+    bool tree_sequence<Tp>::underfull(const node_base_t *node) noexcept {
+        return node->m_count < (node->m_height ? branch_factor : leaf_capacity) / 2;
+    }
+
+    /**
+     * @brief Counts the internal nodes that a split starting below path[depth - 1] propagates through,
+     * i.e. the full nodes at the bottom of the path, plus a new root if the whole path is full.
+     */
+    template <typename Tp>
+    typename tree_sequence<Tp>::size_type tree_sequence<Tp>::full_suffix(internal_t **path, const size_type depth) noexcept {
+        size_type count = 0;
+        while (count < depth && path[depth - 1 - count]->m_count == branch_factor)
+            ++count;
+        return count == depth ? count + 1 : count;
+    }
+
+    /**
+     * @brief Resolves a position to the leaf holding it and the offset within that leaf. The
+     * position one past the last element resolves to the end of the last leaf.
+     */
+    template <typename Tp>
+    std::pair<typename tree_sequence<Tp>::leaf_t*, typename tree_sequence<Tp>::size_type> tree_sequence<Tp>::locate(size_type pos) const noexcept {
+        auto node = m_root;
+        while (node->m_height) {
+            auto parent = static_cast<internal_t*>(node);
+            size_type i = 0;
+            while (i + 1 < parent->m_count && pos >= parent->m_sizes[i])
+                pos -= parent->m_sizes[i++];
+            node = parent->m_children[i];
+        }
+        return { static_cast<leaf_t*>(node), pos };
+    }
+
+    template <typename Tp>
+    typename tree_sequence<Tp>::iterator tree_sequence<Tp>::iterator_at(const size_type pos) noexcept {
+        if (pos == this->m_size)
+            return end();
+
+        auto [leaf, offset] = locate(pos);
+        return iterator(leaf, offset);
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::refresh_ends() noexcept {
+        if (!m_root) {
+            m_first = m_last = nullptr;
+            return;
+        }
+
+        auto first = m_root;
+        auto last = m_root;
+        while (first->m_height) {
+            first = static_cast<internal_t*>(first)->m_children[0];
+            last = static_cast<internal_t*>(last)->m_children[static_cast<internal_t*>(last)->m_count - 1];
+        }
+        m_first = static_cast<leaf_t*>(first);
+        m_last = static_cast<leaf_t*>(last);
+    }
+
+    /**
+     * @brief Inserts child at position pos of path[depth - 1], after refreshing the cached size of
+     * the child at slots[depth - 1]. Full nodes are split in halves with nodes taken from reserve,
+     * moving up the path and growing a new root when the old root splits. Ancestors above the last
+     * split have their cached sizes raised by delta, the number of elements added below them.
+     */
+    template <typename Tp>
+    void tree_sequence<Tp>::insert_child(internal_t **path, size_type *slots, size_type depth,
+                                         node_base_t *child, size_type pos, const size_type delta, node_reserve &reserve) noexcept {
+        while (depth > 0) {
+            auto parent = path[--depth];
+            auto slot = slots[depth];
+            parent->m_sizes[slot] = subtree_size(parent->m_children[slot]);
+
+            internal_t *target = parent;
+            if (parent->m_count == branch_factor) {
+                auto sibling = reserve.take();
+                auto half = branch_factor / 2;
+                sibling->m_height = parent->m_height;
+                sibling->m_count = static_cast<std::uint16_t>(branch_factor - half);
+                std::copy(parent->m_sizes + half, parent->m_sizes + branch_factor, sibling->m_sizes);
+                std::copy(parent->m_children + half, parent->m_children + branch_factor, sibling->m_children);
+                parent->m_count = static_cast<std::uint16_t>(half);
+
+                if (pos > half) {
+                    target = sibling;
+                    pos -= half;
+                }
+
+                std::copy_backward(target->m_sizes + pos, target->m_sizes + target->m_count, target->m_sizes + target->m_count + 1);
+                std::copy_backward(target->m_children + pos, target->m_children + target->m_count, target->m_children + target->m_count + 1);
+                target->m_sizes[pos] = subtree_size(child);
+                target->m_children[pos] = child;
+                ++target->m_count;
+
+                child = sibling;
+                pos = depth > 0 ? slots[depth - 1] + 1 : 0;
+                continue;
+            }
+
+            std::copy_backward(target->m_sizes + pos, target->m_sizes + target->m_count, target->m_sizes + target->m_count + 1);
+            std::copy_backward(target->m_children + pos, target->m_children + target->m_count, target->m_children + target->m_count + 1);
+            target->m_sizes[pos] = subtree_size(child);
+            target->m_children[pos] = child;
+            ++target->m_count;
+
+            while (depth > 0) {
+                --depth;
+                path[depth]->m_sizes[slots[depth]] += delta;
+            }
+            return;
+        }
+
+        auto root = reserve.take();
+        root->m_height = static_cast<std::uint16_t>(m_root->m_height + 1);
+        root->m_count = 2;
+        root->m_sizes[0] = subtree_size(m_root);
+        root->m_sizes[1] = subtree_size(child);
+        root->m_children[0] = m_root;
+        root->m_children[1] = child;
+        m_root = root;
+    }
+
+    /**
+     * @brief Restores the fill of the underfull child at index i of parent, which must have at least
+     * two children, by merging it with a neighbour when both fit in one node and by sharing the
+     * neighbours' contents evenly otherwise.
+     */
+    template <typename Tp>
+    void tree_sequence<Tp>::rebalance(internal_t *parent, const size_type i) noexcept {
+        auto l = i > 0 ? i - 1 : i;
+        auto r = l + 1;
+
+        if (parent->m_height == 1) {
+            auto left = static_cast<leaf_t*>(parent->m_children[l]);
+            auto right = static_cast<leaf_t*>(parent->m_children[r]);
+            size_type total = left->m_count + right->m_count;
+
+            if (total <= leaf_capacity) {
+                relocate(right->data(), right->m_count, left->data() + left->m_count);
+                left->m_count = static_cast<std::uint16_t>(total);
+                left->m_next = right->m_next;
+                if (right->m_next)
+                    right->m_next->m_prev = left;
+                deallocate_node(right);
+            } else {
+                size_type target = total / 2;
+                if (left->m_count < target) {
+                    size_type moved = target - left->m_count;
+                    relocate(right->data(), moved, left->data() + left->m_count);
+                    relocate(right->data() + moved, right->m_count - moved, right->data());
+                } else {
+                    size_type moved = left->m_count - target;
+                    relocate(right->data(), right->m_count, right->data() + moved);
+                    relocate(left->data() + target, moved, right->data());
+                }
+                left->m_count = static_cast<std::uint16_t>(target);
+                right->m_count = static_cast<std::uint16_t>(total - target);
+                parent->m_sizes[l] = left->m_count;
+                parent->m_sizes[r] = right->m_count;
+                return;
+            }
+        } else {
+            auto left = static_cast<internal_t*>(parent->m_children[l]);
+            auto right = static_cast<internal_t*>(parent->m_children[r]);
+            size_type total = left->m_count + right->m_count;
+
+            if (total <= branch_factor) {
+                std::copy(right->m_sizes, right->m_sizes + right->m_count, left->m_sizes + left->m_count);
+                std::copy(right->m_children, right->m_children + right->m_count, left->m_children + left->m_count);
+                left->m_count = static_cast<std::uint16_t>(total);
+                deallocate_node(right);
+            } else {
+                size_type target = total / 2;
+                if (left->m_count < target) {
+                    size_type moved = target - left->m_count;
+                    std::copy(right->m_sizes, right->m_sizes + moved, left->m_sizes + left->m_count);
+                    std::copy(right->m_children, right->m_children + moved, left->m_children + left->m_count);
+                    std::copy(right->m_sizes + moved, right->m_sizes + right->m_count, right->m_sizes);
+                    std::copy(right->m_children + moved, right->m_children + right->m_count, right->m_children);
+                } else {
+                    size_type moved = left->m_count - target;
+                    std::copy_backward(right->m_sizes, right->m_sizes + right->m_count, right->m_sizes + right->m_count + moved);
+                    std::copy_backward(right->m_children, right->m_children + right->m_count, right->m_children + right->m_count + moved);
+                    std::copy(left->m_sizes + target, left->m_sizes + left->m_count, right->m_sizes);
+                    std::copy(left->m_children + target, left->m_children + left->m_count, right->m_children);
+                }
+                left->m_count = static_cast<std::uint16_t>(target);
+                right->m_count = static_cast<std::uint16_t>(total - target);
+                parent->m_sizes[l] = subtree_size(left);
+                parent->m_sizes[r] = subtree_size(right);
+                return;
+            }
+        }
+
+        // Merged: drop the right child from the parent
+        parent->m_sizes[l] += parent->m_sizes[r];
+        std::copy(parent->m_sizes + r + 1, parent->m_sizes + parent->m_count, parent->m_sizes + r);
+        std::copy(parent->m_children + r + 1, parent->m_children + parent->m_count, parent->m_children + r);
+        --parent->m_count;
+    }
+
+    /**
+     * @brief Replaces an internal root that has a single child with that child.
+     */
+    template <typename Tp>
+    void tree_sequence<Tp>::collapse_root() noexcept {
+        auto root = static_cast<internal_t*>(m_root);
+        m_root = root->m_children[0];
+        deallocate_node(root);
+    }
+
+    /**
+     * @brief Restores the fill of the nodes along the right edge of the tree, top-down, after a split
+     * or concatenation left them with arbitrary counts (possibly an empty leaf). Every node off the
+     * edge is assumed to be filled normally, so that each edge node has a left neighbour to merge
+     * with or borrow from.
+     */
+    template <typename Tp>
+    void tree_sequence<Tp>::fix_right_spine() noexcept {
+        while (m_root->m_height && m_root->m_count == 1)
+            collapse_root();
+
+        auto node = m_root;
+        while (node->m_height) {
+            auto parent = static_cast<internal_t*>(node);
+            if (underfull(parent->m_children[parent->m_count - 1])) {
+                rebalance(parent, parent->m_count - 1u);
+                if (parent == m_root && parent->m_count == 1) {
+                    collapse_root();
+                    node = m_root;
+                    continue;
+                }
+            }
+            node = parent->m_children[parent->m_count - 1];
+        }
+    }
+
+    /**
+     * @brief Mirror of fix_right_spine for the nodes along the left edge of the tree.
+     */
+    template <typename Tp>
+    void tree_sequence<Tp>::fix_left_spine() noexcept {
+        while (m_root->m_height && m_root->m_count == 1)
+            collapse_root();
+
+        auto node = m_root;
+        while (node->m_height) {
+            auto parent = static_cast<internal_t*>(node);
+            if (underfull(parent->m_children[0])) {
+                rebalance(parent, 0);
+                if (parent == m_root && parent->m_count == 1) {
+                    collapse_root();
+                    node = m_root;
+                    continue;
+                }
+            }
+            node = parent->m_children[0];
+        }
+    }
+
+    /**
+     * @brief Fills the empty sequence with the elements emit constructs, packing them into full
+     * leaves and then building each internal level from the one below, in O(n). emit(dest)
+     * constructs the next element at dest and returns true, or returns false once there are none
+     * left. If an exception is thrown, the sequence is left empty.
+     */
+    template <typename Tp>
+    template <class Emit>
+    void tree_sequence<Tp>::build(Emit emit) {
+        list<node_base_t*> level(m_allocator);
+        list<node_base_t*> parents(m_allocator);
+        leaf_t *tail = nullptr;
+        size_type count = 0;
+
+        try {
+            for (bool more = true; more;) {
+                level.push_back(nullptr);
+                auto leaf = create_leaf();
+                level.back() = leaf;
+
+                leaf->m_prev = tail;
+                if (tail)
+                    tail->m_next = leaf;
+                tail = leaf;
+
+                while (leaf->m_count < leaf_capacity && (more = emit(leaf->data() + leaf->m_count)))
+                    ++leaf->m_count;
+                count += leaf->m_count;
+            }
+
+            // The last leaf is empty if the elements ran out exactly at a leaf boundary
+            if (!tail->m_count) {
+                level.pop_back();
+                auto prev = tail->m_prev;
+                deallocate_node(tail);
+                if (prev)
+                    prev->m_next = nullptr;
+            }
+
+            while (level.size() > 1) {
+                parents.clear();
+                parents.reserve((level.size() + branch_factor - 1) / branch_factor);
+
+                for (size_type i = 0; i < level.size(); i += branch_factor) {
+                    auto node = create_internal();
+                    node->m_height = static_cast<std::uint16_t>(level[i]->m_height + 1);
+                    node->m_count = static_cast<std::uint16_t>(std::min(branch_factor, level.size() - i));
+                    for (size_type j = 0; j < node->m_count; ++j) {
+                        node->m_sizes[j] = subtree_size(level[i + j]);
+                        node->m_children[j] = std::exchange(level[i + j], nullptr);
+                    }
+                    parents.push_back(node);
+                }
+                level.swap(parents);
+            }
+        } catch (...) {
+            for (auto node : level) {
+                if (node)
+                    destroy_subtree(node);
+            }
+            for (auto node : parents) {
+                if (node)
+                    destroy_subtree(node);
+            }
+            throw;
+        }
+
+        if (level.empty())
+            return;
+
+        // Every node is full but those along the right edge
+        m_root = level[0];
+        this->m_size = count;
+        fix_right_spine();
+        refresh_ends();
+    }
+
+    /**
+     * @brief Inserts the elements of middle, a non-empty sequence with the same allocator, at
+     * index pos, leaving middle empty. Short runs are inserted one at a time; longer ones by
+     * splitting at pos and concatenating the three parts, with every node that takes reserved
+     * up front. If an exception is thrown by a long run, the sequence is unchanged.
+     */
+    template <typename Tp>
+    void tree_sequence<Tp>::insert_built(const size_type pos, tree_sequence &middle) {
+        if (!m_root) {
+            swap(middle);
+            return;
+        }
+        if (middle.m_size <= leaf_capacity) {
+            auto index = pos;
+            for (auto &value : middle)
+                emplace(index++, std::move_if_noexcept(value));
+            middle.clear();
+            return;
+        }
+        if (pos == this->m_size) {
+            concat(std::move(middle));
+            return;
+        }
+        if (pos == 0) {
+            middle.concat(std::move(*this));
+            swap(middle);
+            return;
+        }
+
+        // The split takes a node per level and a leaf, and each attach at most one node more than
+        // the difference in heights, which the first attach may raise by one
+        size_type height = std::max(m_root->m_height, middle.m_root->m_height);
+        node_reserve reserve(*this, m_root->m_height + 2 * height + 3, 1);
+
+        tree_sequence tail(m_allocator);
+        split_off(pos, tail, reserve);
+        attach(middle, reserve);
+        attach(tail, reserve);
+    }
+
+    /**
+     * @brief Moves the elements at indices [pos, size()) into the empty tail, for 0 < pos < size(),
+     * taking the nodes it needs (one internal node per level and a leaf) from reserve.
+     */
+    template <typename Tp>
+    void tree_sequence<Tp>::split_off(const size_type pos, tree_sequence &tail, node_reserve &reserve) noexcept {
+        internal_t *path[max_depth];
+        size_type slots[max_depth];
+        size_type depth = 0;
+        size_type index = pos;
+
+        auto node = m_root;
+        while (node->m_height) {
+            auto parent = static_cast<internal_t*>(node);
+            size_type i = 0;
+            while (index >= parent->m_sizes[i])
+                index -= parent->m_sizes[i++];
+
+            path[depth] = parent;
+            slots[depth++] = i;
+            node = parent->m_children[i];
+        }
+
+        auto leaf = static_cast<leaf_t*>(node);
+        auto right_leaf = reserve.take_leaf();
+
+        relocate(leaf->data() + index, leaf->m_count - index, right_leaf->data());
+        right_leaf->m_count = static_cast<std::uint16_t>(leaf->m_count - index);
+        leaf->m_count = static_cast<std::uint16_t>(index);
+
+        right_leaf->m_next = leaf->m_next;
+        if (leaf->m_next)
+            leaf->m_next->m_prev = right_leaf;
+        leaf->m_next = nullptr;
+
+        node_base_t *right = right_leaf;
+        while (depth > 0) {
+            auto parent = path[--depth];
+            auto slot = slots[depth];
+
+            auto sibling = reserve.take();
+            sibling->m_height = parent->m_height;
+            sibling->m_count = static_cast<std::uint16_t>(parent->m_count - slot);
+            sibling->m_sizes[0] = subtree_size(right);
+            sibling->m_children[0] = right;
+            std::copy(parent->m_sizes + slot + 1, parent->m_sizes + parent->m_count, sibling->m_sizes + 1);
+            std::copy(parent->m_children + slot + 1, parent->m_children + parent->m_count, sibling->m_children + 1);
+
+            parent->m_count = static_cast<std::uint16_t>(slot + 1);
+            parent->m_sizes[slot] = subtree_size(parent->m_children[slot]);
+            right = sibling;
+        }
+
+        tail.m_root = right;
+        tail.m_size = this->m_size - pos;
+        this->m_size = pos;
+
+        fix_right_spine();
+        tail.fix_left_spine();
+        refresh_ends();
+        tail.refresh_ends();
+    }
+
+    /**
+     * @brief Follows the edge of the taller of this and other facing the shorter one down to the
+     * level above the shorter root, recording the path. Returns its depth.
+     */
+    template <typename Tp>
+    typename tree_sequence<Tp>::size_type tree_sequence<Tp>::attach_path(const tree_sequence &other, internal_t **path, size_type *slots) const noexcept {
+        bool attach_back = m_root->m_height >= other.m_root->m_height;
+        auto node = attach_back ? m_root : other.m_root;
+        auto short_tree = attach_back ? other.m_root : m_root;
+
+        size_type depth = 0;
+        while (node->m_height > short_tree->m_height) {
+            auto parent = static_cast<internal_t*>(node);
+            size_type i = attach_back ? parent->m_count - 1u : 0;
+            path[depth] = parent;
+            slots[depth++] = i;
+            node = parent->m_children[i];
+        }
+        return depth;
+    }
+
+    /**
+     * @brief Appends the elements of other, a non-empty sequence with the same allocator, by
+     * attaching the shorter tree as a child along the matching edge of the taller one, taking the
+     * nodes it needs from reserve.
+     */
+    template <typename Tp>
+    void tree_sequence<Tp>::attach(tree_sequence &other, node_reserve &reserve) noexcept {
+        internal_t *path[max_depth];
+        size_type slots[max_depth];
+        auto depth = attach_path(other, path, slots);
+
+        bool attach_back = m_root->m_height >= other.m_root->m_height;
+        bool equal_heights = m_root->m_height == other.m_root->m_height;
+        auto tall = attach_back ? m_root : other.m_root;
+        auto short_tree = attach_back ? other.m_root : m_root;
+
+        m_last->m_next = other.m_first;
+        other.m_first->m_prev = m_last;
+
+        size_type pos = 0;
+        if (attach_back && depth > 0)
+            pos = path[depth - 1]->m_count;
+
+        m_root = tall;
+        insert_child(path, slots, depth, short_tree, pos, attach_back ? other.m_size : this->m_size, reserve);
+
+        this->m_size += other.m_size;
+        other.m_root = nullptr;
+        other.m_first = other.m_last = nullptr;
+        other.m_size = 0;
+
+        if (attach_back)
+            fix_right_spine();
+        else
+            fix_left_spine();
+
+        // Equal heights meet under a new root, where the left tree may be the underfull one
+        if (equal_heights && m_root->m_height && underfull(static_cast<internal_t*>(m_root)->m_children[0])) {
+            rebalance(static_cast<internal_t*>(m_root), 0);
+            if (m_root->m_count == 1)
+                collapse_root();
+        }
+        refresh_ends();
+    }
+
+
+    //*** Public ***//
+
+    //* Assignment operator overloads *//
+
+    template <typename Tp>
+    tree_sequence<Tp>& tree_sequence<Tp>::operator=(const tree_sequence<Tp> &other) {
+        if (this != &other) {
+            tree_sequence copy(other, m_allocator);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    template <typename Tp>
+    tree_sequence<Tp>& tree_sequence<Tp>::operator=(tree_sequence<Tp> &&other) {
+        if (this != &other) {
+            if (m_allocator == other.m_allocator) {
+                clear();
+                swap(other);
+            } else {
+                clear();
+                insert(0, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+
+    //* Allocator access *//
+
+    template <typename Tp>
+    typename tree_sequence<Tp>::allocator_type tree_sequence<Tp>::get_allocator() const noexcept {
+        return m_allocator;
+    }
+
+
+    //* Element Access *//
+
+    template <typename Tp>
+    typename tree_sequence<Tp>::reference tree_sequence<Tp>::at(const size_type pos) {
+        check_bounds(pos);
+        return operator[](pos);
+    }
+
+    template <typename Tp>
+    typename tree_sequence<Tp>::const_reference tree_sequence<Tp>::at(const size_type pos) const {
+        check_bounds(pos);
+        return operator[](pos);
+    }
+
+    template <typename Tp>
+    typename tree_sequence<Tp>::reference tree_sequence<Tp>::operator[](const size_type pos) noexcept {
+        auto [leaf, offset] = locate(pos);
+        return leaf->data()[offset];
+    }
+
+    template <typename Tp>
+    typename tree_sequence<Tp>::const_reference tree_sequence<Tp>::operator[](const size_type pos) const noexcept {
+        auto [leaf, offset] = locate(pos);
+        return leaf->data()[offset];
+    }
+
+
+    //* Modifiers *//
+
+    template <typename Tp>
+    void tree_sequence<Tp>::clear() noexcept {
+        if (m_root)
+            destroy_subtree(m_root);
+
+        m_root = nullptr;
+        m_first = m_last = nullptr;
+        this->m_size = 0;
+    }
+
+    template <typename Tp>
+    typename tree_sequence<Tp>::iterator tree_sequence<Tp>::insert(const size_type pos, const Tp &value) {
+        return emplace(pos, value);
+    }
+
+    template <typename Tp>
+    typename tree_sequence<Tp>::iterator tree_sequence<Tp>::insert(const size_type pos, Tp &&value) {
+        return emplace(pos, std::move(value));
+    }
+
+    /**
+     * @brief Inserts count copies of value at index pos. The copies are built into leaves of their
+     * own and spliced in, in O(count + log n).
+     */
+    template <typename Tp>
+    void tree_sequence<Tp>::insert(size_type pos, size_type count, const Tp &value) {
+        if (pos > this->m_size)
+            throw std::out_of_range("Index out of bounds.");
+
+        tree_sequence middle(m_allocator);
+        middle.build([&](Tp *dest) {
+            if (!count)
+                return false;
+            m_allocator.construct(dest, value);
+            --count;
+            return true;
+        });
+        if (middle.m_root)
+            insert_built(pos, middle);
+    }
+
+    /**
+     * @brief Inserts the elements of [first, last) at index pos. The elements are read into leaves
+     * of their own before the sequence is touched, so the range may refer to it, and then spliced
+     * in, in O(distance + log n).
+     */
+    template <typename Tp>
+    template <class InputIt, typename>
+    void tree_sequence<Tp>::insert(size_type pos, InputIt first, InputIt last) {
+        if (pos > this->m_size)
+            throw std::out_of_range("Index out of bounds.");
+
+        tree_sequence middle(m_allocator);
+        middle.build([&](Tp *dest) {
+            if (first == last)
+                return false;
+            m_allocator.construct(dest, *first);
+            ++first;
+            return true;
+        });
+        if (middle.m_root)
+            insert_built(pos, middle);
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::insert(const size_type pos, std::initializer_list<Tp> init) {
+        insert(pos, init.begin(), init.end());
+    }
+
+    /**
+     * @brief Constructs an element in place so that it ends up at index pos. A full leaf is split,
+     * and at either end of the sequence the split leaves the old leaf full so that appending or
+     * prepending in order packs the leaves densely. If an exception is thrown, the sequence is unchanged.
+     */
+    template <typename Tp>
+    template <class... Args>
+    typename tree_sequence<Tp>::iterator tree_sequence<Tp>::emplace(const size_type pos, Args &&...args) {
+        if (pos > this->m_size)
+            throw std::out_of_range("Index out of bounds.");
+
+        if (!m_root) {
+            auto leaf = create_leaf();
+            try {
+                m_allocator.construct(leaf->data(), std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate_node(leaf);
+                throw;
+            }
+
+            leaf->m_count = 1;
+            m_root = m_first = m_last = leaf;
+            this->m_size = 1;
+            return iterator(leaf, 0);
+        }
+
+        internal_t *path[max_depth];
+        size_type slots[max_depth];
+        size_type depth = 0;
+        size_type index = pos;
+
+        auto node = m_root;
+        while (node->m_height) {
+            auto parent = static_cast<internal_t*>(node);
+            size_type i = 0;
+            while (i + 1 < parent->m_count && index > parent->m_sizes[i])
+                index -= parent->m_sizes[i++];
+
+            path[depth] = parent;
+            slots[depth++] = i;
+            node = parent->m_children[i];
+        }
+
+        auto leaf = static_cast<leaf_t*>(node);
+        if (leaf->m_count < leaf_capacity) {
+            auto data = leaf->data();
+            relocate(data + index, leaf->m_count - index, data + index + 1);
+            try {
+                m_allocator.construct(data + index, std::forward<Args>(args)...);
+            } catch (...) {
+                relocate(data + index + 1, leaf->m_count - index, data + index);
+                throw;
+            }
+
+            ++leaf->m_count;
+            for (size_type d = 0; d < depth; ++d)
+                ++path[d]->m_sizes[slots[d]];
+            ++this->m_size;
+            return iterator(leaf, index);
+        }
+
+        // Everything that can throw happens before the tree is modified
+        Tp value(std::forward<Args>(args)...);
+        node_reserve reserve(*this, full_suffix(path, depth));
+        auto sibling = create_leaf();
+
+        size_type half = leaf_capacity / 2;
+        if (index == leaf_capacity && !leaf->m_next)
+            half = leaf_capacity;
+        else if (index == 0 && !leaf->m_prev)
+            half = 0;
+
+        relocate(leaf->data() + half, leaf_capacity - half, sibling->data());
+        sibling->m_count = static_cast<std::uint16_t>(leaf_capacity - half);
+        leaf->m_count = static_cast<std::uint16_t>(half);
+
+        sibling->m_prev = leaf;
+        sibling->m_next = leaf->m_next;
+        if (leaf->m_next)
+            leaf->m_next->m_prev = sibling;
+        leaf->m_next = sibling;
+
+        auto target = leaf;
+        if (index > half || half == leaf_capacity) {
+            target = sibling;
+            index -= half;
+        }
+
+        auto data = target->data();
+        relocate(data + index, target->m_count - index, data + index + 1);
+        m_allocator.construct(data + index, std::move(value));
+        ++target->m_count;
+
+        insert_child(path, slots, depth, sibling, depth > 0 ? slots[depth - 1] + 1 : 0, 1, reserve);
+        ++this->m_size;
+        refresh_ends();
+        return iterator(target, index);
+    }
+
+    /**
+     * @brief Removes the element at index pos and returns an iterator to the element that followed it.
+     */
+    template <typename Tp>
+    typename tree_sequence<Tp>::iterator tree_sequence<Tp>::erase(const size_type pos) {
+        check_bounds(pos);
+
+        internal_t *path[max_depth];
+        size_type slots[max_depth];
+        size_type depth = 0;
+        size_type index = pos;
+
+        auto node = m_root;
+        while (node->m_height) {
+            auto parent = static_cast<internal_t*>(node);
+            size_type i = 0;
+            while (index >= parent->m_sizes[i])
+                index -= parent->m_sizes[i++];
+
+            --parent->m_sizes[i];
+            path[depth] = parent;
+            slots[depth++] = i;
+            node = parent->m_children[i];
+        }
+
+        auto leaf = static_cast<leaf_t*>(node);
+        auto data = leaf->data();
+        std::allocator_traits<allocator_type>::destroy(m_allocator, data + index);
+        relocate(data + index + 1, leaf->m_count - index - 1, data + index);
+        --leaf->m_count;
+        --this->m_size;
+
+        while (depth > 0 && underfull(node)) {
+            --depth;
+            rebalance(path[depth], slots[depth]);
+            node = path[depth];
+        }
+
+        while (m_root->m_height && m_root->m_count == 1)
+            collapse_root();
+        if (m_root->m_count == 0) {
+            deallocate_node(m_root);
+            m_root = nullptr;
+        }
+
+        refresh_ends();
+        return iterator_at(pos);
+    }
+
+    /**
+     * @brief Removes the elements at indices [first, last) and returns an iterator to the element
+     * that followed them. Short ranges are erased one element at a time; longer ones are split off
+     * at both ends and the remainders concatenated, in O(log n) plus the cost of destroying them.
+     */
+    template <typename Tp>
+    typename tree_sequence<Tp>::iterator tree_sequence<Tp>::erase(const size_type first, const size_type last) {
+        if (first > last || last > this->m_size)
+            throw std::out_of_range("Index out of bounds.");
+
+        if (last - first <= leaf_capacity) {
+            for (auto count = last - first; count > 0; --count)
+                erase(first);
+            return iterator_at(first);
+        }
+        if (last - first == this->m_size) {
+            clear();
+            return end();
+        }
+
+        // Each split takes a node per level and a leaf, and the attach at most one node per level more
+        node_reserve reserve(*this, 3 * m_root->m_height + 1, 2);
+
+        tree_sequence middle(m_allocator);
+        tree_sequence tail(m_allocator);
+        if (last < this->m_size)
+            split_off(last, tail, reserve);
+        if (first > 0)
+            split_off(first, middle, reserve);
+        else
+            swap(middle);
+
+        if (!m_root)
+            swap(tail);
+        else if (tail.m_root)
+            attach(tail, reserve);
+        return iterator_at(first);
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::push_back(const Tp &value) {
+        emplace(this->m_size, value);
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::push_back(Tp &&value) {
+        emplace(this->m_size, std::move(value));
+    }
+
+    template <typename Tp>
+    template <class... Args>
+    typename tree_sequence<Tp>::reference tree_sequence<Tp>::emplace_back(Args &&...args) {
+        return *emplace(this->m_size, std::forward<Args>(args)...);
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::pop_back() {
+        erase(this->m_size - 1);
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::push_front(const Tp &value) {
+        emplace(0, value);
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::push_front(Tp &&value) {
+        emplace(0, std::move(value));
+    }
+
+    template <typename Tp>
+    template <class... Args>
+    typename tree_sequence<Tp>::reference tree_sequence<Tp>::emplace_front(Args &&...args) {
+        return *emplace(0, std::forward<Args>(args)...);
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::pop_front() {
+        erase(0);
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::swap(tree_sequence<Tp> &other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
+        if (m_allocator == other.m_allocator) {
+            using std::swap;
+            swap(m_root, other.m_root);
+            swap(m_first, other.m_first);
+            swap(m_last, other.m_last);
+            swap(this->m_size, other.m_size);
+        }
+    }
+
+
+    //* Operations *//
+
+    /**
+     * @brief Removes the elements at indices [pos, size()) and returns them as a new sequence using
+     * the same allocator, in O(log n). The path to pos is cut in two, and the nodes along the new
+     * edges are then rebalanced against their neighbours. If an exception is thrown, the sequence is unchanged.
+     */
+    template <typename Tp>
+    tree_sequence<Tp> tree_sequence<Tp>::split(const size_type pos) {
+        if (pos > this->m_size)
+            throw std::out_of_range("Index out of bounds.");
+
+        tree_sequence tail(m_allocator);
+        if (pos == this->m_size)
+            return tail;
+        if (pos == 0) {
+            tail.swap(*this);
+            return tail;
+        }
+
+        node_reserve reserve(*this, m_root->m_height, 1);
+        split_off(pos, tail, reserve);
+        return tail;
+    }
+
+    template <typename Tp>
+    void tree_sequence<Tp>::concat(tree_sequence<Tp> &other) {
+        concat(std::move(other));
+    }
+
+    /**
+     * @brief Appends the elements of other, leaving it empty. With equal allocators, the shorter tree
+     * is attached as a child along the matching edge of the taller one in O(log n); otherwise the
+     * elements are first moved into leaves of this allocator. If an exception is thrown, both
+     * sequences are unchanged.
+     */
+    template <typename Tp>
+    void tree_sequence<Tp>::concat(tree_sequence<Tp> &&other) {
+        if (this == &other || other.empty())
+            return;
+
+        if (m_allocator != other.m_allocator) {
+            tree_sequence moved(m_allocator);
+            auto it = other.begin();
+            moved.build([&](Tp *dest) {
+                if (it == other.end())
+                    return false;
+                m_allocator.construct(dest, std::move_if_noexcept(*it));
+                ++it;
+                return true;
+            });
+            concat(std::move(moved));
+            other.clear();
+            return;
+        }
+
+        if (!m_root) {
+            swap(other);
+            return;
+        }
+
+        internal_t *path[max_depth];
+        size_type slots[max_depth];
+        auto depth = attach_path(other, path, slots);
+
+        node_reserve reserve(*this, full_suffix(path, depth));
+        attach(other, reserve);
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_TREE_SEQUENCE_H
@@ -0,0 +1,275 @@
+#ifndef DSL_WORK_STEALING_DEQUE_H
+#define DSL_WORK_STEALING_DEQUE_H
+
+
+#include "concurrency_base.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+
+namespace dsl {
+
+    namespace details {
+
+        /**
+         * @brief Circular storage of a work-stealing deque, indexed by the deque's unbounded
+         * 64-bit positions modulo a power-of-two capacity. The slots are allocated behind the
+         * header. A buffer replaced by a larger one is kept on the retired chain, as thieves
+         * may still be reading from it.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        struct ws_buffer {
+            std::int64_t m_mask;
+            ws_buffer *m_retired;
+
+            static constexpr std::size_t slots_offset() noexcept {
+                return (sizeof(ws_buffer) + alignof(std::atomic<Tp>) - 1) / alignof(std::atomic<Tp>) * alignof(std::atomic<Tp>);
+            }
+
+            static constexpr std::size_t allocation_size(const std::int64_t capacity) noexcept {
+                return slots_offset() + static_cast<std::size_t>(capacity) * sizeof(std::atomic<Tp>);
+            }
+
+            static constexpr std::size_t alignment() noexcept {
+                return alignof(ws_buffer) > alignof(std::atomic<Tp>) ? alignof(ws_buffer) : alignof(std::atomic<Tp>);
+            }
+
+            [[nodiscard]] std::int64_t capacity() const noexcept {
+                return m_mask + 1;
+            }
+
+            std::atomic<Tp>* slots() noexcept {
+                return std::launder(reinterpret_cast<std::atomic<Tp>*>(reinterpret_cast<std::byte*>(this) + slots_offset()));
+            }
+
+            Tp load(const std::int64_t index) noexcept {
+                return slots()[index & m_mask].load(std::memory_order_relaxed);
+            }
+
+            void store(const std::int64_t index, const Tp &value) noexcept {
+                slots()[index & m_mask].store(value, std::memory_order_relaxed);
+            }
+        };
+
+    }   // namespace details
+
+
+    /**
+     * @brief Chase-Lev work-stealing deque. A single owner thread pushes and pops at the bottom
+     * without locks, while any number of thieves steal from the top, contending with the owner
+     * only through a compare-and-swap on the last element. The circular storage doubles when
+     * full; retired buffers are freed with the deque, since a thief may read a buffer after it
+     * has been replaced. They total less than the current buffer.
+     *
+     * Elements are read speculatively by thieves, so Tp must be trivially copyable (typically
+     * a pointer to a task).
+     *
+     * @tparam Tp
+     */
+    template <typename Tp>
+    class work_stealing_deque {
+        static_assert(std::is_trivially_copyable_v<Tp>, "Elements of a work_stealing_deque must be trivially copyable.");
+
+    private:
+        using buffer_t = details::ws_buffer<Tp>;
+
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = Tp;
+        using size_type = std::size_t;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit work_stealing_deque(const size_type capacity = 64, allocator_type allocator = {})
+            : m_top(0)
+            , m_bottom(0)
+            , m_buffer(nullptr)
+            , m_allocator(allocator)
+        {
+            std::int64_t rounded = 2;
+            while (static_cast<size_type>(rounded) < capacity)
+                rounded <<= 1;
+            m_buffer.store(create_buffer(rounded, nullptr), std::memory_order_relaxed);
+        }
+
+        work_stealing_deque(const work_stealing_deque&) = delete;
+        work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+
+        //* Destructor *//
+
+        ~work_stealing_deque() {
+            for (auto buffer = m_buffer.load(std::memory_order_relaxed); buffer; ) {
+                auto retired = buffer->m_retired;
+                destroy_buffer(buffer);
+                buffer = retired;
+            }
+        }
+
+
+        //* Capacity *//
+
+        // Exact for the owner; a snapshot that may already be stale for any other thread
+        [[nodiscard]] size_type size() const noexcept {
+            auto b = m_bottom.load(std::memory_order_relaxed);
+            auto t = m_top.load(std::memory_order_relaxed);
+            return b > t ? static_cast<size_type>(b - t) : 0;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        [[nodiscard]] size_type capacity() const noexcept {
+            return static_cast<size_type>(m_buffer.load(std::memory_order_relaxed)->capacity());
+        }
+
+
+        //* Modifiers *//
+
+        // Owner only
+        void push(const Tp&);
+        std::optional<Tp> pop() noexcept;
+
+        // Any thread
+        std::optional<Tp> steal() noexcept;
+
+
+    private:
+
+        //*** Members ***//
+
+        alignas(details::cache_line_size) std::atomic<std::int64_t> m_top;
+        alignas(details::cache_line_size) std::atomic<std::int64_t> m_bottom;
+        std::atomic<buffer_t*> m_buffer;
+        allocator_type m_allocator;
+
+
+        //*** Functions ***//
+
+        buffer_t* create_buffer(std::int64_t, buffer_t*);
+        void destroy_buffer(buffer_t*) noexcept;
+        buffer_t* grow(buffer_t*, std::int64_t, std::int64_t);
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    template <typename Tp>
+    typename work_stealing_deque<Tp>::buffer_t* work_stealing_deque<Tp>::create_buffer(const std::int64_t capacity, buffer_t *retired) {
+        auto memory = m_allocator.resource()->allocate(buffer_t::allocation_size(capacity), buffer_t::alignment());
+        auto buffer = ::new (memory) buffer_t{ capacity - 1, retired };
+
+        auto slots = reinterpret_cast<std::byte*>(buffer) + buffer_t::slots_offset();
+        for (std::int64_t i = 0; i < capacity; ++i)
+            ::new (static_cast<void*>(slots + i * sizeof(std::atomic<Tp>))) std::atomic<Tp>();
+        return buffer;
+    }
+
+    template <typename Tp>
+    void work_stealing_deque<Tp>::destroy_buffer(buffer_t *buffer) noexcept {
+        m_allocator.resource()->deallocate(buffer, buffer_t::allocation_size(buffer->capacity()), buffer_t::alignment());
+    }
+
+    /**
+     * @brief Publishes a buffer of twice the capacity holding the elements in [top, bottom),
+     * which keep their positions. Owner only.
+     */
+    template <typename Tp>
+    typename work_stealing_deque<Tp>::buffer_t* work_stealing_deque<Tp>::grow(buffer_t *buffer, const std::int64_t top, const std::int64_t bottom) {
+        auto larger = create_buffer(buffer->capacity() * 2, buffer);
+        for (auto i = top; i < bottom; ++i)
+            larger->store(i, buffer->load(i));
+
+        m_buffer.store(larger, std::memory_order_release);
+        return larger;
+    }
+
+
+    //*** Public ***//
+
+    //* Modifiers *//
+
+    template <typename Tp>
+    void work_stealing_deque<Tp>::push(const Tp &value) {
+        auto b = m_bottom.load(std::memory_order_relaxed);
+        auto t = m_top.load(std::memory_order_acquire);
+        auto buffer = m_buffer.load(std::memory_order_relaxed);
+
+        if (b - t > buffer->m_mask)
+            buffer = grow(buffer, t, b);
+
+        buffer->store(b, value);
+        m_bottom.store(b + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Takes the most recently pushed element. The bottom is reserved first, so that a
+     * thief racing for the last element is detected through top.
+     */
+    template <typename Tp>
+    std::optional<Tp> work_stealing_deque<Tp>::pop() noexcept {
+        auto b = m_bottom.load(std::memory_order_relaxed) - 1;
+        auto buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = m_top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        auto value = buffer->load(b);
+        if (t == b) {
+            // Last element: whoever advances top first takes it
+            auto won = m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won)
+                return std::nullopt;
+        }
+
+        return value;
+    }
+
+    /**
+     * @brief Takes the least recently pushed element. Fails, without retrying, when the deque is
+     * empty or another thread won the race for the element.
+     */
+    template <typename Tp>
+    std::optional<Tp> work_stealing_deque<Tp>::steal() noexcept {
+        auto t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto b = m_bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+            return std::nullopt;
+
+        auto value = m_buffer.load(std::memory_order_acquire)->load(t);
+        if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return std::nullopt;
+
+        return value;
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_WORK_STEALING_DEQUE_H
@@ -0,0 +1,439 @@
+#ifndef DSL_WORK_STEALING_POOL_H
+#define DSL_WORK_STEALING_POOL_H
+
+
+#include "work_stealing_deque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace dsl {
+
+    namespace details {
+
+        /**
+         * @brief Type-erased unit of work queued in a work_stealing_pool. Queues hold pointers, so
+         * that the deques only move trivially copyable values.
+         */
+        struct pool_task {
+            void (*m_execute)(pool_task*);
+        };
+
+        /**
+         * @brief Task submitted without a join, which owns its callable and frees itself once run.
+         */
+        template <class F>
+        struct detached_pool_task : pool_task {
+            explicit detached_pool_task(F &&f)
+                : pool_task{ &execute }
+                , m_function(std::move(f)) {}
+
+            static void execute(pool_task *task) {
+                std::unique_ptr<detached_pool_task> self(static_cast<detached_pool_task*>(task));
+                self->m_function();
+            }
+
+            F m_function;
+        };
+
+        /**
+         * @brief Task forked by join. It lives on the stack of the joining thread, which waits for
+         * m_done before returning, and hands back any exception thrown by the callable.
+         */
+        template <class F>
+        struct forked_pool_task : pool_task {
+            explicit forked_pool_task(F &f) noexcept
+                : pool_task{ &execute }
+                , m_function(&f)
+                , m_error()
+                , m_done(false) {}
+
+            static void execute(pool_task *task) {
+                auto self = static_cast<forked_pool_task*>(task);
+                try {
+                    (*self->m_function)();
+                } catch (...) {
+                    self->m_error = std::current_exception();
+                }
+                self->m_done.store(true, std::memory_order_release);
+            }
+
+            F *m_function;
+            std::exception_ptr m_error;
+            std::atomic<bool> m_done;
+        };
+
+    }   // namespace details
+
+
+    /**
+     * @brief Thread pool in which each worker owns a work_stealing_deque. Work forked by a worker
+     * goes to the bottom of its own deque, so it is taken back in LIFO order while it is still
+     * hot in the cache, and idle workers steal from the top of the others' deques. Work from
+     * outside the pool enters through a shared queue, and workers with nothing to do sleep.
+     *
+     * join(f, g) is the fork/join primitive: it forks g, runs f, then keeps running other tasks
+     * until g has completed, so recursive joins never block a worker.
+     */
+    class work_stealing_pool {
+    public:
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit work_stealing_pool(const std::size_t thread_count = std::thread::hardware_concurrency());
+
+        work_stealing_pool(const work_stealing_pool&) = delete;
+        work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+
+        //* Destructor *//
+
+        ~work_stealing_pool();
+
+
+        //* Access *//
+
+        [[nodiscard]] std::size_t thread_count() const noexcept {
+            return m_workers.size();
+        }
+
+
+        //* Modifiers *//
+
+        template <class F>
+        void submit(F&&);
+
+        template <class F>
+        void run(F&&);
+
+        template <class F, class G>
+        void join(F&&, G&&);
+
+        void wait_idle();
+
+
+    private:
+
+        //*** Member Types ***//
+
+        struct alignas(details::cache_line_size) worker {
+            worker(work_stealing_pool *pool, const std::uint64_t seed)
+                : m_pool(pool)
+                , m_deque()
+                , m_seed(seed) {}
+
+            work_stealing_pool *m_pool;
+            work_stealing_deque<details::pool_task*> m_deque;
+            std::uint64_t m_seed;
+        };
+
+
+        //*** Members ***//
+
+        std::vector<std::unique_ptr<worker>> m_workers;
+        std::vector<std::thread> m_threads;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake_cv;
+        std::condition_variable m_idle_cv;
+        std::deque<details::pool_task*> m_injected;
+        std::atomic<std::size_t> m_injected_count;
+        std::atomic<std::size_t> m_sleeping;
+        std::atomic<std::size_t> m_pending;
+        std::uint64_t m_epoch;
+        bool m_stopping;
+
+
+        //*** Functions ***//
+
+        static worker*& current_worker() noexcept {
+            thread_local worker *current = nullptr;
+            return current;
+        }
+
+        worker* local_worker() const noexcept;
+        void push(details::pool_task*);
+        void execute(details::pool_task*);
+        details::pool_task* find_task(worker&);
+        bool has_work() const noexcept;
+        void work(worker&);
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    // Returns the worker running on the calling thread if it belongs to this pool
+    inline work_stealing_pool::worker* work_stealing_pool::local_worker() const noexcept {
+        auto current = current_worker();
+        return current && current->m_pool == this ? current : nullptr;
+    }
+
+    /**
+     * @brief Queues task on the calling worker's deque, or on the shared queue from any other
+     * thread, and wakes a sleeping worker if there is one.
+     */
+    inline void work_stealing_pool::push(details::pool_task *task) {
+        if (auto w = local_worker()) {
+            w->m_deque.push(task);
+
+            // Pairs with the fence in work(): either the sleeper sees the task or we see the sleeper
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_sleeping.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_epoch;
+                m_wake_cv.notify_one();
+            }
+        } else {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_injected.push_back(task);
+            m_injected_count.fetch_add(1, std::memory_order_relaxed);
+            ++m_epoch;
+            m_wake_cv.notify_one();
+        }
+    }
+
+    inline void work_stealing_pool::execute(details::pool_task *task) {
+        task->m_execute(task);
+
+        if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_idle_cv.notify_all();
+        }
+    }
+
+    /**
+     * @brief Takes a task from the bottom of the worker's own deque, then from the shared queue,
+     * then from the top of the other deques, starting at a random victim.
+     */
+    inline details::pool_task* work_stealing_pool::find_task(worker &self) {
+        if (auto task = self.m_deque.pop())
+            return *task;
+
+        if (m_injected_count.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_injected.empty()) {
+                auto task = m_injected.front();
+                m_injected.pop_front();
+                m_injected_count.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        // xorshift64
+        self.m_seed ^= self.m_seed << 13;
+        self.m_seed ^= self.m_seed >> 7;
+        self.m_seed ^= self.m_seed << 17;
+
+        auto count = m_workers.size();
+        auto start = static_cast<std::size_t>(self.m_seed % count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto &victim = *m_workers[(start + i) % count];
+            if (&victim == &self)
+                continue;
+            if (auto task = victim.m_deque.steal())
+                return *task;
+        }
+
+        return nullptr;
+    }
+
+    inline bool work_stealing_pool::has_work() const noexcept {
+        if (m_injected_count.load(std::memory_order_relaxed))
+            return true;
+
+        return std::any_of(m_workers.begin(), m_workers.end(), [](const auto &w) { return !w->m_deque.empty(); });
+    }
+
+    inline void work_stealing_pool::work(worker &self) {
+        current_worker() = &self;
+
+        // Number of fruitless searches before a worker goes to sleep
+        constexpr int spin_limit = 64;
+
+        for (int misses = 0;;) {
+            if (auto task = find_task(self)) {
+                execute(task);
+                misses = 0;
+                continue;
+            }
+
+            if (++misses < spin_limit) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto epoch = m_epoch;
+            m_sleeping.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (!has_work()) {
+                if (m_stopping) {
+                    m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+                    return;
+                }
+                m_wake_cv.wait(lock, [&] { return m_epoch != epoch || m_stopping; });
+            }
+
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            misses = 0;
+        }
+    }
+
+
+    //*** Public ***//
+
+    //* Constructors *//
+
+    inline work_stealing_pool::work_stealing_pool(const std::size_t thread_count)
+        : m_injected_count(0)
+        , m_sleeping(0)
+        , m_pending(0)
+        , m_epoch(0)
+        , m_stopping(false)
+    {
+        auto count = std::max<std::size_t>(thread_count, 1);
+        for (std::size_t i = 0; i < count; ++i)
+            m_workers.push_back(std::make_unique<worker>(this, 0x9E3779B97F4A7C15ull * (i + 1)));
+
+        m_threads.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            m_threads.emplace_back([this, i] { work(*m_workers[i]); });
+    }
+
+
+    //* Destructor *//
+
+    /**
+     * @brief Completes every submitted task, then stops and joins the workers.
+     */
+    inline work_stealing_pool::~work_stealing_pool() {
+        wait_idle();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake_cv.notify_all();
+
+        for (auto &thread : m_threads)
+            thread.join();
+    }
+
+
+    //* Modifiers *//
+
+    /**
+     * @brief Queues f to run on the pool without waiting for it. An exception escaping f
+     * terminates the program.
+     */
+    template <class F>
+    void work_stealing_pool::submit(F &&f) {
+        using task_t = details::detached_pool_task<std::decay_t<F>>;
+
+        auto task = std::make_unique<task_t>(std::decay_t<F>(std::forward<F>(f)));
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        push(task.get());
+        task.release();
+    }
+
+    /**
+     * @brief Runs f on the pool and waits for it, rethrowing any exception it throws. Called from
+     * a worker, f simply runs inline.
+     */
+    template <class F>
+    void work_stealing_pool::run(F &&f) {
+        if (local_worker()) {
+            f();
+            return;
+        }
+
+        std::mutex mutex;
+        std::condition_variable done_cv;
+        bool done = false;
+        std::exception_ptr error;
+
+        submit([&] {
+            try {
+                f();
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+            done_cv.notify_one();
+        });
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cv.wait(lock, [&] { return done; });
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    /**
+     * @brief Runs f and g, potentially in parallel, and returns once both have completed. g is
+     * forked to the calling worker's deque where an idle worker may steal it; meanwhile the caller
+     * runs f and then, rather than blocking, runs other tasks until g is done. Called from outside
+     * the pool, the whole join runs on the pool. The first exception thrown is rethrown.
+     */
+    template <class F, class G>
+    void work_stealing_pool::join(F &&f, G &&g) {
+        auto self = local_worker();
+        if (!self) {
+            run([&] { join(f, g); });
+            return;
+        }
+
+        details::forked_pool_task<std::remove_reference_t<G>> forked(g);
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        push(&forked);
+
+        std::exception_ptr error;
+        try {
+            f();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        while (!forked.m_done.load(std::memory_order_acquire)) {
+            if (auto task = find_task(*self))
+                execute(task);
+            else
+                std::this_thread::yield();
+        }
+
+        if (!error)
+            error = forked.m_error;
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    /**
+     * @brief Blocks until every task submitted so far, and all the work they forked, has completed.
+     */
+    inline void work_stealing_pool::wait_idle() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle_cv.wait(lock, [this] { return m_pending.load(std::memory_order_acquire) == 0; });
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_WORK_STEALING_POOL_H
@@ -0,0 +1,860 @@
+#ifndef DSL_XOR_LINKED_LIST_H
+#define DSL_XOR_LINKED_LIST_H
+
+
+#include "list_base.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+
+
+namespace dsl {
+
+    template <typename Tp> class xor_linked_list;
+
+    namespace details {
+
+        /**
+         * @brief Base representation for a node in an xor-linked list. Stores the bitwise
+         * XOR of the addresses of the previous and next nodes in a single word, where a
+         * missing neighbour is encoded as a null address.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        struct xor_node_base {
+            xor_node_base() : m_link(0) {}
+
+            // Explicitly disallow copy behaviour
+            xor_node_base(const xor_node_base&) = delete;
+            xor_node_base& operator=(const xor_node_base&) = delete;
+
+            std::uintptr_t m_link;
+        };
+
+        /**
+         * @brief Node in an xor-linked list. Derives the base representation and wraps
+         * the value type in an anonymous union to help align raw bytes.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        struct xor_node : xor_node_base<Tp> {
+            union {
+                Tp m_value;
+            };
+        };
+
+        /**
+         * @brief Decodes the neighbour of a node given the address of the other neighbour.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        xor_node_base<Tp>* xor_neighbour(const xor_node_base<Tp> *node, const xor_node_base<Tp> *other) noexcept {
+            return reinterpret_cast<xor_node_base<Tp>*>(node->m_link ^ reinterpret_cast<std::uintptr_t>(other));
+        }
+
+        /**
+         * @brief Replaces the neighbour old_node of a node with new_node. A null node is left untouched.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        void xor_relink(xor_node_base<Tp> *node, const xor_node_base<Tp> *old_node, const xor_node_base<Tp> *new_node) noexcept {
+            if (node)
+                node->m_link ^= reinterpret_cast<std::uintptr_t>(old_node) ^ reinterpret_cast<std::uintptr_t>(new_node);
+        }
+
+
+        /**
+         * @brief Iterator with const pointer and reference member types.
+         * Adheres to the named requirements of LegacyBidirectionalIterator.
+         *
+         * An xor-linked list cannot be traversed from a single node, so the iterator
+         * holds a cursor pair: the current node and the node preceding it. The iterator
+         * is invalidated once the two nodes of its pair are no longer adjacent.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        class xor_const_iterator : public iterator_base<Tp> {
+        public:
+
+            //*** Member Types ***//
+
+            using value_type = typename iterator_base<Tp>::value_type;
+            using difference_type = typename iterator_base<Tp>::difference_type;
+
+            using iterator_category = std::bidirectional_iterator_tag;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+
+            //*** Member Functions ***//
+
+            xor_const_iterator() noexcept
+                : m_prev(nullptr)
+                , m_curr(nullptr) {}
+
+            [[nodiscard]] pointer operator->() const noexcept {
+                return std::addressof(static_cast<xor_node<Tp>*>(m_curr)->m_value);
+            }
+
+            [[nodiscard]] reference operator*() const noexcept {
+                return static_cast<xor_node<Tp>*>(m_curr)->m_value;
+            }
+
+            xor_const_iterator& operator++() noexcept {
+                auto next = xor_neighbour(m_curr, m_prev);
+                m_prev = m_curr;
+                m_curr = next;
+                return *this;
+            }
+
+            xor_const_iterator operator++(int) noexcept {
+                xor_const_iterator it(*this);
+                ++(*this);
+                return it;
+            }
+
+            xor_const_iterator& operator--() noexcept {
+                auto prev = xor_neighbour(m_prev, m_curr);
+                m_curr = m_prev;
+                m_prev = prev;
+                return *this;
+            }
+
+            xor_const_iterator operator--(int) noexcept {
+                xor_const_iterator it(*this);
+                --(*this);
+                return it;
+            }
+
+            bool operator==(const xor_const_iterator &other) const noexcept {
+                return m_curr == other.m_curr && m_prev == other.m_prev;
+            }
+
+            bool operator!=(const xor_const_iterator &other) const noexcept {
+                return !operator==(other);
+            }
+
+
+        protected:
+            friend class xor_linked_list<Tp>;
+
+            xor_node_base<Tp> *m_prev;
+            xor_node_base<Tp> *m_curr;
+
+            // Non-public explicit constructor to enable iterator construction for derived classes and friend classes
+            xor_const_iterator(const xor_node_base<Tp> *prev, const xor_node_base<Tp> *curr) noexcept
+                : m_prev(const_cast<xor_node_base<Tp>*>(prev))
+                , m_curr(const_cast<xor_node_base<Tp>*>(curr)) {}
+        };
+
+
+        /**
+         * @brief Iterator with non-const pointer and reference member types.
+         * Adheres to the named requirements of LegacyBidirectionalIterator.
+         *
+         * @tparam Tp
+         */
+        template <typename Tp>
+        class xor_iterator : public xor_const_iterator<Tp> {
+        public:
+
+            //*** Member Types ***//
+
+            using base_t = xor_const_iterator<Tp>;
+            using value_type = typename base_t::value_type;
+
+            using pointer = value_type*;
+            using reference = value_type&;
+
+
+            //*** Member Functions ***//
+
+            xor_iterator() noexcept
+                : xor_const_iterator<Tp>() {}
+
+            [[nodiscard]] pointer operator->() const noexcept {
+                return std::addressof(static_cast<xor_node<Tp>*>(this->m_curr)->m_value);
+            }
+
+            [[nodiscard]] reference operator*() const noexcept {
+                return static_cast<xor_node<Tp>*>(this->m_curr)->m_value;
+            }
+
+            xor_iterator& operator++() noexcept {
+                base_t::operator++();
+                return *this;
+            }
+
+            xor_iterator operator++(int) noexcept {
+                xor_iterator it(*this);
+                ++(*this);
+                return it;
+            }
+
+            xor_iterator& operator--() noexcept {
+                base_t::operator--();
+                return *this;
+            }
+
+            xor_iterator operator--(int) noexcept {
+                xor_iterator it(*this);
+                --(*this);
+                return it;
+            }
+
+
+        private:
+            friend class xor_linked_list<Tp>;
+
+            xor_iterator(const xor_node_base<Tp> *prev, const xor_node_base<Tp> *curr) noexcept
+                : xor_const_iterator<Tp>(prev, curr) {}
+        };
+
+    }   // namespace details
+
+
+    /**
+     * @brief Doubly-linked list storing a single link word per node (the XOR of the
+     * neighbouring node addresses). Supports bidirectional iteration from either end
+     * and O(1) insertion, removal and splicing at a known cursor pair, at the cost of
+     * iterators being invalidated whenever one of their two nodes is relinked.
+     *
+     * @tparam Tp
+     */
+    template <typename Tp>
+    class xor_linked_list : public details::list_base<xor_linked_list<Tp>, Tp> {
+    public:
+
+        //*** Member Types ***//
+
+        using value_type = typename details::list_base<xor_linked_list<Tp>, Tp>::value_type;
+        using size_type = typename details::list_base<xor_linked_list<Tp>, Tp>::size_type;
+        using difference_type = typename details::list_base<xor_linked_list<Tp>, Tp>::difference_type;
+
+        using reference = typename details::list_base<xor_linked_list<Tp>, Tp>::reference;
+        using const_reference = typename details::list_base<xor_linked_list<Tp>, Tp>::const_reference;
+
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+        using pointer = std::allocator_traits<allocator_type>::pointer;
+        using const_pointer = std::allocator_traits<allocator_type>::const_pointer;
+
+        using iterator = typename details::xor_iterator<Tp>;
+        using const_iterator = typename details::xor_const_iterator<Tp>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+        //*** Member Functions ***//
+
+        //* Constructors *//
+
+        explicit xor_linked_list(allocator_type allocator = {})
+            : details::list_base<xor_linked_list<Tp>, Tp>()
+            , m_allocator(allocator)
+            , m_head(nullptr)
+            , m_tail(nullptr)
+        {}
+
+        xor_linked_list(const size_type count,
+                        const Tp &value,
+                        allocator_type allocator = {})
+            : xor_linked_list(allocator)
+        { insert(end(), count, value); }
+
+        explicit xor_linked_list(const size_type count,
+                                 allocator_type allocator = {})
+            : xor_linked_list(count, Tp(), allocator)
+        {}
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        xor_linked_list(InputIt first, InputIt last,
+                        allocator_type allocator = {})
+            : xor_linked_list(allocator)
+        { insert(end(), first, last); }
+
+        xor_linked_list(std::initializer_list<Tp> init,
+                        allocator_type allocator = {})
+            : xor_linked_list(init.begin(), init.end(), allocator)
+        {}
+
+
+        //* Copy Constructors *//
+
+        xor_linked_list(const xor_linked_list &other,
+                        allocator_type allocator)
+            : xor_linked_list(other.begin(), other.end(), allocator)
+        {}
+
+        xor_linked_list(const xor_linked_list &other)
+            : xor_linked_list(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator()))
+        {}
+
+
+        //* Move Constructors *//
+
+        xor_linked_list(xor_linked_list &&other,
+                        allocator_type allocator)
+            : xor_linked_list(allocator)
+        { operator=(std::move(other)); }
+
+        xor_linked_list(xor_linked_list &&other) noexcept
+            : xor_linked_list(other.get_allocator())
+        { swap(other); }
+
+
+        //* Destructor *//
+        ~xor_linked_list() {
+            clear();
+        }
+
+
+        //* Assignment operator overloads *//
+
+        xor_linked_list& operator=(const xor_linked_list&);
+        xor_linked_list& operator=(xor_linked_list&&);
+
+
+        //* Assign and allocator access *//
+
+        void assign(const size_type, const Tp&);
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        void assign(InputIt, InputIt);
+
+        void assign(std::initializer_list<Tp>);
+
+        allocator_type get_allocator() const noexcept;
+
+
+        //* Element Access *//
+
+        reference front() {
+            return static_cast<node_t*>(m_head)->m_value;
+        }
+
+        const_reference front() const {
+            return static_cast<node_t*>(m_head)->m_value;
+        }
+
+        reference back() {
+            return static_cast<node_t*>(m_tail)->m_value;
+        }
+
+        const_reference back() const {
+            return static_cast<node_t*>(m_tail)->m_value;
+        }
+
+
+        //* Iterators *//
+
+        iterator begin() noexcept {
+            return iterator(nullptr, m_head);
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator(nullptr, m_head);
+        }
+
+        const_iterator cbegin() const noexcept {
+            return const_iterator(nullptr, m_head);
+        }
+
+        iterator end() noexcept {
+            return iterator(m_tail, nullptr);
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(m_tail, nullptr);
+        }
+
+        const_iterator cend() const noexcept {
+            return const_iterator(m_tail, nullptr);
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept {
+            return const_reverse_iterator(cend());
+        }
+
+        reverse_iterator rend() noexcept {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator(cbegin());
+        }
+
+
+        //* Modifiers *//
+
+        void clear() noexcept;
+
+        iterator insert(const_iterator, const Tp&);
+        iterator insert(const_iterator, Tp&&);
+        iterator insert(const_iterator, size_type, const Tp&);
+
+        template <class InputIt, typename = details::require_input_iterator<InputIt>>
+        iterator insert(const_iterator, InputIt, InputIt);
+
+        iterator insert(const_iterator, std::initializer_list<Tp>);
+
+        template <class... Args>
+        iterator emplace(const_iterator, Args&&...);
+
+        iterator erase(const_iterator);
+        iterator erase(const_iterator, const_iterator);
+
+        void push_back(const Tp&);
+        void push_back(Tp&&);
+
+        template <class... Args>
+        reference emplace_back(Args&&...);
+
+        void pop_back();
+
+        void push_front(const Tp&);
+        void push_front(Tp&&);
+
+        template <class... Args>
+        reference emplace_front(Args&&...);
+
+        void pop_front();
+
+        void resize(const size_type);
+        void resize(const size_type, const Tp&);
+
+        void swap(xor_linked_list&) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value);
+
+
+        //* Operations *//
+
+        void splice(const_iterator, xor_linked_list&);
+        void splice(const_iterator, xor_linked_list&&);
+        void splice(const_iterator, xor_linked_list&, const_iterator);
+        void splice(const_iterator, xor_linked_list&&, const_iterator);
+        void splice(const_iterator, xor_linked_list&, const_iterator, const_iterator);
+        void splice(const_iterator, xor_linked_list&&, const_iterator, const_iterator);
+
+        void reverse() noexcept;
+
+
+    private:
+
+        //*** Using Directives ***//
+
+        using node_base_t = typename details::xor_node_base<Tp>;
+        using node_t = typename details::xor_node<Tp>;
+
+
+        //*** Members ***//
+
+        allocator_type m_allocator;
+        node_base_t *m_head;
+        node_base_t *m_tail;
+
+
+        //*** Functions ***//
+
+        template <class... Args>
+        node_t* create_node(Args&&...);
+        void destroy_node(node_base_t*) noexcept;
+
+        void link_range(node_base_t*, node_base_t*, node_base_t*, node_base_t*) noexcept;
+        void unlink_range(node_base_t*, node_base_t*, node_base_t*, node_base_t*) noexcept;
+    };
+
+
+
+    //****** Member Function Implementations ******//
+
+    //*** Private ***//
+
+    template <typename Tp>
+    template <class... Args>
+    typename xor_linked_list<Tp>::node_t* xor_linked_list<Tp>::create_node(Args &&...args) {
+        auto node = static_cast<node_t*>(m_allocator.resource()->allocate(sizeof(node_t), alignof(node_t)));
+
+        try {
+            m_allocator.construct(std::addressof(node->m_value), std::forward<Args>(args)...);
+        } catch (...) {
+            m_allocator.resource()->deallocate(node, sizeof(node_t), alignof(node_t));
+            throw;
+        }
+
+        node->m_link = 0;
+        return node;
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::destroy_node(node_base_t *node) noexcept {
+        auto pNode = static_cast<node_t*>(node);
+        std::allocator_traits<allocator_type>::destroy(m_allocator, std::addressof(pNode->m_value));
+        m_allocator.resource()->deallocate(pNode, sizeof(node_t), alignof(node_t));
+    }
+
+    /**
+     * @brief Links the detached chain first..last (whose outer links are null) between
+     * the adjacent nodes prev and next, either of which may be null at the list ends.
+     */
+    template <typename Tp>
+    void xor_linked_list<Tp>::link_range(node_base_t *prev, node_base_t *next, node_base_t *first, node_base_t *last) noexcept {
+        details::xor_relink<Tp>(first, nullptr, prev);
+        details::xor_relink<Tp>(last, nullptr, next);
+        details::xor_relink<Tp>(prev, next, first);
+        details::xor_relink<Tp>(next, prev, last);
+
+        if (!prev)
+            m_head = first;
+        if (!next)
+            m_tail = last;
+    }
+
+    /**
+     * @brief Detaches the chain first..last, bounded by prev and next, and nulls its outer links.
+     */
+    template <typename Tp>
+    void xor_linked_list<Tp>::unlink_range(node_base_t *prev, node_base_t *next, node_base_t *first, node_base_t *last) noexcept {
+        details::xor_relink<Tp>(prev, first, next);
+        details::xor_relink<Tp>(next, last, prev);
+        details::xor_relink<Tp>(first, prev, nullptr);
+        details::xor_relink<Tp>(last, next, nullptr);
+
+        if (!prev)
+            m_head = next;
+        if (!next)
+            m_tail = prev;
+    }
+
+
+    //*** Public ***//
+
+    //* Assignment Operator Overloads *//
+
+    template <typename Tp>
+    xor_linked_list<Tp>& xor_linked_list<Tp>::operator=(const xor_linked_list<Tp> &other) {
+        if (this != &other)
+            assign(other.begin(), other.end());
+        return *this;
+    }
+
+    template <typename Tp>
+    xor_linked_list<Tp>& xor_linked_list<Tp>::operator=(xor_linked_list<Tp> &&other) {
+        if (this != &other) {
+            if (m_allocator == other.m_allocator) {
+                clear();
+                swap(other);
+            } else {
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+
+    //* Assign and allocator access *//
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::assign(const size_type count, const Tp &value) {
+        auto it = begin();
+        size_type i = 0;
+        for (; i < count && it != end(); ++i, ++it)
+            *it = value;
+
+        if (i < count)
+            insert(end(), count - i, value);
+        else
+            erase(it, end());
+    }
+
+    template <typename Tp>
+    template <class InputIt, typename>
+    void xor_linked_list<Tp>::assign(InputIt first, InputIt last) {
+        auto it = begin();
+        for (; first != last && it != end(); ++first, ++it)
+            *it = *first;
+
+        if (first != last)
+            insert(end(), first, last);
+        else
+            erase(it, end());
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::assign(std::initializer_list<Tp> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    template <typename Tp>
+    typename xor_linked_list<Tp>::allocator_type xor_linked_list<Tp>::get_allocator() const noexcept {
+        return m_allocator;
+    }
+
+
+    //* Modifiers *//
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::clear() noexcept {
+        node_base_t *prev = nullptr;
+        auto curr = m_head;
+
+        while (curr) {
+            auto next = details::xor_neighbour(curr, prev);
+            prev = curr;
+            destroy_node(curr);
+            curr = next;
+        }
+
+        m_head = m_tail = nullptr;
+        this->m_size = 0;
+    }
+
+    template <typename Tp>
+    typename xor_linked_list<Tp>::iterator xor_linked_list<Tp>::insert(const_iterator pos, const Tp &value) {
+        return emplace(pos, value);
+    }
+
+    template <typename Tp>
+    typename xor_linked_list<Tp>::iterator xor_linked_list<Tp>::insert(const_iterator pos, Tp &&value) {
+        return emplace(pos, std::move(value));
+    }
+
+    template <typename Tp>
+    typename xor_linked_list<Tp>::iterator xor_linked_list<Tp>::insert(const_iterator pos, const size_type count, const Tp &value) {
+        if (count == 0)
+            return iterator(pos.m_prev, pos.m_curr);
+
+        auto first = emplace(pos, value);
+        auto it = first;
+        for (size_type i = 1; i < count; ++i)
+            it = emplace(std::next(it), value);
+        return first;
+    }
+
+    template <typename Tp>
+    template <class InputIt, typename>
+    typename xor_linked_list<Tp>::iterator xor_linked_list<Tp>::insert(const_iterator pos, InputIt first, InputIt last) {
+        if (first == last)
+            return iterator(pos.m_prev, pos.m_curr);
+
+        auto result = emplace(pos, *first);
+        auto it = result;
+        for (++first; first != last; ++first)
+            it = emplace(std::next(it), *first);
+        return result;
+    }
+
+    template <typename Tp>
+    typename xor_linked_list<Tp>::iterator xor_linked_list<Tp>::insert(const_iterator pos, std::initializer_list<Tp> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    template <typename Tp>
+    template <class... Args>
+    typename xor_linked_list<Tp>::iterator xor_linked_list<Tp>::emplace(const_iterator pos, Args &&...args) {
+        node_base_t *node = create_node(std::forward<Args>(args)...);
+        link_range(pos.m_prev, pos.m_curr, node, node);
+
+        ++this->m_size;
+        return iterator(pos.m_prev, node);
+    }
+
+    template <typename Tp>
+    typename xor_linked_list<Tp>::iterator xor_linked_list<Tp>::erase(const_iterator pos) {
+        auto next = details::xor_neighbour(pos.m_curr, pos.m_prev);
+        unlink_range(pos.m_prev, next, pos.m_curr, pos.m_curr);
+        destroy_node(pos.m_curr);
+
+        --this->m_size;
+        return iterator(pos.m_prev, next);
+    }
+
+    template <typename Tp>
+    typename xor_linked_list<Tp>::iterator xor_linked_list<Tp>::erase(const_iterator first, const_iterator last) {
+        if (first == last)
+            return iterator(last.m_prev, last.m_curr);
+
+        auto prev = first.m_prev;
+        auto curr = first.m_curr;
+        auto past = last.m_curr;
+
+        unlink_range(prev, past, curr, last.m_prev);
+
+        node_base_t *before = nullptr;
+        while (curr) {
+            auto next = details::xor_neighbour(curr, before);
+            before = curr;
+            destroy_node(curr);
+            curr = next;
+            --this->m_size;
+        }
+
+        return iterator(prev, past);
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::push_back(const Tp &value) {
+        emplace_back(value);
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::push_back(Tp &&value) {
+        emplace_back(std::move(value));
+    }
+
+    template <typename Tp>
+    template <class... Args>
+    typename xor_linked_list<Tp>::reference xor_linked_list<Tp>::emplace_back(Args &&...args) {
+        return *emplace(end(), std::forward<Args>(args)...);
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::pop_back() {
+        erase(std::prev(end()));
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::push_front(const Tp &value) {
+        emplace_front(value);
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::push_front(Tp &&value) {
+        emplace_front(std::move(value));
+    }
+
+    template <typename Tp>
+    template <class... Args>
+    typename xor_linked_list<Tp>::reference xor_linked_list<Tp>::emplace_front(Args &&...args) {
+        return *emplace(begin(), std::forward<Args>(args)...);
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::pop_front() {
+        erase(begin());
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::resize(const size_type count) {
+        if (count < this->m_size)
+            erase(std::prev(end(), this->m_size - count), end());
+        else
+            while (this->m_size < count)
+                emplace_back();
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::resize(const size_type count, const Tp &value) {
+        if (count < this->m_size)
+            erase(std::prev(end(), this->m_size - count), end());
+        else if (count > this->m_size)
+            insert(end(), count - this->m_size, value);
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::swap(xor_linked_list<Tp> &other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
+        if (m_allocator == other.m_allocator) {
+            using std::swap;
+            swap(m_head, other.m_head);
+            swap(m_tail, other.m_tail);
+            swap(this->m_size, other.m_size);
+        }
+    }
+
+
+    //* Operations *//
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::splice(const_iterator pos, xor_linked_list<Tp> &other) {
+        if (this == &other || other.empty())
+            return;
+
+        auto first = other.m_head;
+        auto last = other.m_tail;
+        auto count = other.m_size;
+
+        other.m_head = other.m_tail = nullptr;
+        other.m_size = 0;
+
+        link_range(pos.m_prev, pos.m_curr, first, last);
+        this->m_size += count;
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::splice(const_iterator pos, xor_linked_list<Tp> &&other) {
+        splice(pos, other);
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::splice(const_iterator pos, xor_linked_list<Tp> &other, const_iterator it) {
+        splice(pos, other, it, std::next(it));
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::splice(const_iterator pos, xor_linked_list<Tp> &&other, const_iterator it) {
+        splice(pos, other, it);
+    }
+
+    /**
+     * @brief Moves the nodes in [first, last) of other before pos without copying or reallocating.
+     * Relinking is O(1); when other is a different list, the range is additionally walked once to
+     * keep both sizes accurate. Iterators to pos, first, last and their neighbours are invalidated.
+     */
+    template <typename Tp>
+    void xor_linked_list<Tp>::splice(const_iterator pos, xor_linked_list<Tp> &other, const_iterator first, const_iterator last) {
+        if (first == last || pos == first || pos == last)
+            return;
+
+        if (this != &other) {
+            auto count = static_cast<size_type>(std::distance(first, last));
+            other.m_size -= count;
+            this->m_size += count;
+        }
+
+        auto range_first = first.m_curr;
+        auto range_last = last.m_prev;
+        other.unlink_range(first.m_prev, last.m_curr, range_first, range_last);
+
+        // The cursor pair at pos remains addressable, since only the links of its nodes (not their identity) changed
+        link_range(pos.m_prev, pos.m_curr, range_first, range_last);
+    }
+
+    template <typename Tp>
+    void xor_linked_list<Tp>::splice(const_iterator pos, xor_linked_list<Tp> &&other, const_iterator first, const_iterator last) {
+        splice(pos, other, first, last);
+    }
+
+    /**
+     * @brief Reverses the order of the elements in O(1). Since every link word is symmetric
+     * in its two neighbours, only the head and tail need to be exchanged.
+     */
+    template <typename Tp>
+    void xor_linked_list<Tp>::reverse() noexcept {
+        using std::swap;
+        swap(m_head, m_tail);
+    }
+
+}   // namespace dsl
+
+
+#endif // DSL_XOR_LINKED_LIST_H
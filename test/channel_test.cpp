@@ -0,0 +1,162 @@
+// Tests for channel on both executors, meant to be run under ThreadSanitizer and AddressSanitizer
+// as well as in plain builds (see DSL_LIST_SANITIZE in CMakeLists.txt). Requires C++20.
+
+#include "channel.h"
+#include "executor.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <optional>
+#include <vector>
+
+
+namespace {
+
+    using channel_t = dsl::channel<std::uint64_t>;
+
+    constexpr std::size_t producer_count = 3;
+    constexpr std::size_t consumer_count = 3;
+    constexpr std::size_t per_producer = 2000;
+
+    // State shared by the producers and consumers of one run
+    struct exchange {
+        using counters_t = std::vector<std::atomic<std::uint32_t>>;
+
+        counters_t received = counters_t(producer_count * per_producer);
+        std::atomic<std::size_t> running{ producer_count };
+        std::latch finished{ producer_count + consumer_count };
+    };
+
+    // Sends per_producer values; the last producer to finish closes the channel
+    dsl::detached_task produce(channel_t &channel, const std::size_t id, exchange &state) {
+        for (std::size_t i = 0; i < per_producer; ++i) {
+            auto sent = co_await channel.send(id * per_producer + i);
+            EXPECT_TRUE(sent);
+        }
+        if (state.running.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            channel.close();
+        state.finished.count_down();
+    }
+
+    // Receives until the channel is closed and drained, counting each value it is handed
+    dsl::detached_task consume(channel_t &channel, exchange &state) {
+        while (auto value = co_await channel.receive())
+            state.received[*value].fetch_add(1, std::memory_order_relaxed);
+        state.finished.count_down();
+    }
+
+    void start(dsl::executor &ex, channel_t &channel, exchange &state) {
+        for (std::size_t c = 0; c < consumer_count; ++c)
+            dsl::spawn(ex, consume(channel, state));
+        for (std::size_t p = 0; p < producer_count; ++p)
+            dsl::spawn(ex, produce(channel, p, state));
+    }
+
+    void expect_each_received_once(const exchange &state) {
+        for (std::size_t i = 0; i < state.received.size(); ++i)
+            ASSERT_EQ(state.received[i].load(), 1u) << "value " << i;
+    }
+
+
+    class ChannelOnRunLoop : public ::testing::TestWithParam<std::size_t> {};
+
+    TEST_P(ChannelOnRunLoop, EveryValueArrivesOnce) {
+        dsl::run_loop loop;
+        channel_t channel(loop, GetParam());
+        exchange state;
+
+        start(loop, channel, state);
+        loop.run();
+
+        EXPECT_TRUE(state.finished.try_wait());
+        EXPECT_TRUE(channel.is_closed());
+        expect_each_received_once(state);
+    }
+
+    class ChannelOnThreadPool : public ::testing::TestWithParam<std::size_t> {};
+
+    TEST_P(ChannelOnThreadPool, EveryValueArrivesOnce) {
+        dsl::thread_pool pool(4);
+        channel_t channel(pool, GetParam());
+        exchange state;
+
+        start(pool, channel, state);
+        state.finished.wait();
+
+        EXPECT_TRUE(channel.is_closed());
+        expect_each_received_once(state);
+    }
+
+    // Rendezvous, bounded and unbounded channels
+    INSTANTIATE_TEST_SUITE_P(Capacities, ChannelOnRunLoop, ::testing::Values(0, 1, 16, channel_t::unbounded));
+    INSTANTIATE_TEST_SUITE_P(Capacities, ChannelOnThreadPool, ::testing::Values(0, 1, 16, channel_t::unbounded));
+
+
+    dsl::detached_task send_one(channel_t &channel, const std::uint64_t value, std::optional<bool> &result) {
+        result = co_await channel.send(value);
+    }
+
+    // Empty until the receive completes
+    using receive_result = std::optional<std::optional<std::uint64_t>>;
+
+    const receive_result closed(std::in_place, std::nullopt);
+
+    dsl::detached_task receive_one(channel_t &channel, receive_result &result) {
+        result = co_await channel.receive();
+    }
+
+    TEST(Channel, CloseWakesSuspendedSenders) {
+        dsl::run_loop loop;
+        channel_t channel(loop, 1);
+        std::vector<std::optional<bool>> sent(3);
+
+        for (std::size_t i = 0; i < sent.size(); ++i)
+            dsl::spawn(loop, send_one(channel, i, sent[i]));
+        loop.run();
+
+        // The first value is buffered and the other senders wait for room
+        EXPECT_EQ(sent[0], std::optional<bool>(true));
+        EXPECT_FALSE(sent[1].has_value());
+        EXPECT_FALSE(sent[2].has_value());
+
+        channel.close();
+        loop.run();
+        EXPECT_EQ(sent[1], std::optional<bool>(false));
+        EXPECT_EQ(sent[2], std::optional<bool>(false));
+
+        // Receives drain the buffer, then report the channel closed
+        receive_result first, second;
+        dsl::spawn(loop, receive_one(channel, first));
+        dsl::spawn(loop, receive_one(channel, second));
+        loop.run();
+        EXPECT_EQ(first, receive_result(0u));
+        EXPECT_EQ(second, closed);
+    }
+
+    TEST(Channel, CloseWakesSuspendedReceivers) {
+        dsl::run_loop loop;
+        channel_t channel(loop, 0);
+        std::vector<receive_result> received(3);
+
+        for (auto &result : received)
+            dsl::spawn(loop, receive_one(channel, result));
+        loop.run();
+        for (auto &result : received)
+            EXPECT_FALSE(result.has_value());
+
+        channel.close();
+        loop.run();
+        for (auto &result : received)
+            EXPECT_EQ(result, closed);
+
+        std::optional<bool> sent;
+        dsl::spawn(loop, send_one(channel, 7, sent));
+        loop.run();
+        EXPECT_EQ(sent, std::optional<bool>(false));
+    }
+
+}
@@ -0,0 +1,118 @@
+// Stress tests for concurrent_append_list, meant to be run under ThreadSanitizer and
+// AddressSanitizer as well as in plain builds (see DSL_LIST_SANITIZE in CMakeLists.txt).
+
+#include "concurrent_append_list.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+    constexpr std::size_t writer_count = 8;
+    constexpr std::size_t per_writer = 20000;
+
+    // Each value records its writer and its position in that writer's sequence
+    std::uint64_t encode(const std::size_t writer, const std::size_t seq) {
+        return (static_cast<std::uint64_t>(writer) << 32) | seq;
+    }
+
+
+    TEST(ConcurrentAppendList, EightWritersPublishEveryValueOnce) {
+        dsl::concurrent_append_list<std::uint64_t> list(4);
+        std::atomic<bool> start{ false };
+        std::atomic<std::size_t> done{ 0 };
+
+        std::vector<std::thread> writers;
+        for (std::size_t w = 0; w < writer_count; ++w) {
+            writers.emplace_back([&, w] {
+                while (!start.load(std::memory_order_acquire));
+                for (std::size_t i = 0; i < per_writer; ++i)
+                    list.push_back(encode(w, i));
+                done.fetch_add(1, std::memory_order_release);
+            });
+        }
+
+        // A reader checks the published prefix while the writers run: every value in it is
+        // constructed, and each writer's values appear in the order it pushed them
+        std::thread reader([&] {
+            std::vector<std::size_t> next(writer_count, 0);
+            std::size_t checked = 0;
+            while (done.load(std::memory_order_acquire) < writer_count || checked < list.size()) {
+                for (auto size = list.size(); checked < size; ++checked) {
+                    auto value = list[checked];
+                    auto writer = static_cast<std::size_t>(value >> 32);
+                    ASSERT_LT(writer, writer_count);
+                    ASSERT_EQ(value & 0xffffffffu, next[writer]++);
+                }
+            }
+        });
+
+        start.store(true, std::memory_order_release);
+        for (auto &writer : writers)
+            writer.join();
+        reader.join();
+
+        ASSERT_EQ(list.size(), writer_count * per_writer);
+
+        std::vector<std::size_t> counts(writer_count, 0);
+        std::size_t iterated = 0;
+        for (auto value : list) {
+            ++counts[static_cast<std::size_t>(value >> 32)];
+            ++iterated;
+        }
+        EXPECT_EQ(iterated, writer_count * per_writer);
+        for (auto count : counts)
+            EXPECT_EQ(count, per_writer);
+    }
+
+    TEST(ConcurrentAppendList, ElementsWithStorageAreDestroyed) {
+        dsl::concurrent_append_list<std::unique_ptr<std::size_t>> list(2);
+
+        std::vector<std::thread> writers;
+        for (std::size_t w = 0; w < writer_count; ++w) {
+            writers.emplace_back([&, w] {
+                for (std::size_t i = 0; i < per_writer / 8; ++i)
+                    list.emplace_back(std::make_unique<std::size_t>(w));
+            });
+        }
+        for (auto &writer : writers)
+            writer.join();
+
+        std::size_t sum = 0;
+        for (const auto &value : list)
+            sum += *value;
+        EXPECT_EQ(sum, per_writer / 8 * (writer_count * (writer_count - 1) / 2));
+    }
+
+    TEST(ConcurrentAppendList, IteratorTakenBeforeSegmentExists) {
+        dsl::concurrent_append_list<int> list(4);
+        auto it = list.begin();
+
+        for (int i = 0; i < 12; ++i)
+            list.push_back(i);
+
+        // it was sought before any segment was allocated, and finds the elements once they are
+        EXPECT_EQ(*it, 0);
+        auto end = list.end();
+        int expected = 0;
+        for (; it != end; ++it)
+            EXPECT_EQ(*it, expected++);
+        EXPECT_EQ(expected, 12);
+
+        // The same holds for an iterator at the start of a segment not yet allocated
+        auto boundary = list.end();
+        for (int i = 12; i < 40; ++i)
+            list.push_back(i);
+        EXPECT_EQ(*boundary, 12);
+        ++boundary;
+        EXPECT_EQ(*boundary, 13);
+    }
+
+}   // namespace
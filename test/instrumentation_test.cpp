@@ -0,0 +1,234 @@
+// Checks the events that the containers report to their instrumentation policies: the positions of
+// bulk insertions into list, and balanced node allocations in the linked lists.
+
+#include "doubly_linked_list.h"
+#include "list.h"
+#include "singly_linked_list.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <sstream>
+#include <vector>
+
+
+namespace {
+
+    struct tracked {
+        int value;
+
+        tracked(const int value = 0) : value(value) {}
+    };
+
+    struct counted {
+        int value;
+
+        counted(const int value = 0) : value(value) {}
+    };
+
+    struct node_value {
+        int value;
+
+        node_value(const int value = 0) : value(value) {}
+    };
+
+    using pmr_singly = dsl::singly_linked_list<node_value, std::pmr::polymorphic_allocator<node_value>>;
+    using pmr_doubly = dsl::doubly_linked_list<node_value, std::pmr::polymorphic_allocator<node_value>>;
+
+    std::vector<dsl::event_record> recorded;
+
+    void record(const dsl::event_record &event) noexcept {
+        recorded.push_back(event);
+    }
+
+}
+
+// The specializations must precede the first use of the list members
+template <>
+struct dsl::instrumentation_policy<dsl::list<tracked>> : dsl::callback_policy {};
+
+template <>
+struct dsl::instrumentation_policy<dsl::list<counted>> : dsl::thread_counters_policy {};
+
+template <>
+struct dsl::instrumentation_policy<pmr_singly> : dsl::thread_counters_policy {};
+
+template <>
+struct dsl::instrumentation_policy<pmr_doubly> : dsl::thread_counters_policy {};
+
+
+namespace {
+
+    std::vector<dsl::event_record> insertions() {
+        std::vector<dsl::event_record> result;
+        for (auto &event : recorded) {
+            if (event.kind == dsl::container_event::insertion)
+                result.push_back(event);
+        }
+        return result;
+    }
+
+    class ListInstrumentation : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            recorded.clear();
+            dsl::callback_policy::set_callback(record);
+        }
+
+        void TearDown() override {
+            dsl::callback_policy::set_callback(nullptr);
+        }
+    };
+
+
+    TEST_F(ListInstrumentation, RangeInsertReportsTheInsertionIndex) {
+        dsl::list<tracked> list{ 1, 2, 3, 4 };
+        std::vector<tracked> values{ 7, 8 };
+        recorded.clear();
+
+        list.insert(list.cbegin() + 1, values.begin(), values.end());
+
+        auto events = insertions();
+        ASSERT_EQ(events.size(), 1u);
+        EXPECT_EQ(events[0].container, &list);
+        EXPECT_EQ(events[0].position, 1u);
+        EXPECT_EQ(events[0].count, 6u);
+    }
+
+    TEST_F(ListInstrumentation, InputRangeInsertReportsTheInsertionIndex) {
+        dsl::list<tracked> list{ 1, 2, 3, 4 };
+        std::istringstream in("7 8 9");
+        recorded.clear();
+
+        list.insert(list.cbegin() + 2, std::istream_iterator<int>(in), std::istream_iterator<int>());
+
+        auto events = insertions();
+        ASSERT_EQ(events.size(), 1u);
+        EXPECT_EQ(events[0].position, 2u);
+        EXPECT_EQ(events[0].count, 7u);
+        EXPECT_EQ(list[2].value, 7);
+        EXPECT_EQ(list[5].value, 3);
+    }
+
+    TEST_F(ListInstrumentation, EmptyRangeInsertReportsNothing) {
+        dsl::list<tracked> list{ 1, 2 };
+        std::vector<tracked> values;
+        recorded.clear();
+
+        list.insert(list.cbegin(), values.begin(), values.end());
+
+        EXPECT_TRUE(insertions().empty());
+    }
+
+    TEST_F(ListInstrumentation, CountInsertReportsTheInsertionIndex) {
+        dsl::list<tracked> list{ 1, 2, 3, 4 };
+        recorded.clear();
+
+        list.insert(list.cbegin() + 3, 5, tracked(9));
+
+        auto events = insertions();
+        ASSERT_EQ(events.size(), 1u);
+        EXPECT_EQ(events[0].position, 3u);
+        EXPECT_EQ(events[0].count, 9u);
+    }
+
+    TEST_F(ListInstrumentation, FillResizeReportsTheOldEnd) {
+        dsl::list<tracked> list{ 1, 2, 3 };
+        recorded.clear();
+
+        list.resize(6, tracked(0));
+
+        auto events = insertions();
+        ASSERT_EQ(events.size(), 1u);
+        EXPECT_EQ(events[0].position, 3u);
+        EXPECT_EQ(events[0].count, 6u);
+    }
+
+    TEST(ListInstrumentationCounters, MiddleRangeInsertIsNotABackInsertion) {
+        dsl::list<counted> list{ 1, 2, 3, 4 };
+        std::vector<counted> values{ 7, 8 };
+        dsl::thread_counters_policy::reset();
+
+        list.insert(list.cbegin() + 1, values.begin(), values.end());
+
+        auto &counters = dsl::thread_counters_policy::counters();
+        EXPECT_EQ(counters.insertions, 1u);
+        EXPECT_EQ(counters.front_insertions, 0u);
+        EXPECT_EQ(counters.back_insertions, 0u);
+    }
+
+
+
+    // Fails every allocation after the first budget ones
+    class limited_resource : public std::pmr::memory_resource {
+    public:
+        explicit limited_resource(const std::size_t budget) : m_budget(budget) {}
+
+    private:
+        std::size_t m_budget;
+
+        void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+            if (m_budget == 0)
+                throw std::bad_alloc();
+            --m_budget;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *p, const std::size_t bytes, const std::size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    template <class LinkedList>
+    class LinkedListInstrumentation : public ::testing::Test {};
+
+    using linked_lists = ::testing::Types<pmr_singly, pmr_doubly>;
+    TYPED_TEST_SUITE(LinkedListInstrumentation, linked_lists);
+
+    TYPED_TEST(LinkedListInstrumentation, CompactBalancesNodeEvents) {
+        auto &counters = dsl::thread_counters_policy::counters();
+        std::pmr::unsynchronized_pool_resource pool;
+        dsl::thread_counters_policy::reset();
+        {
+            TypeParam list{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+            EXPECT_EQ(counters.node_allocations, 10u);
+
+            list.compact(&pool);
+            EXPECT_EQ(counters.node_allocations, 20u);
+            EXPECT_EQ(counters.node_deallocations, 10u);
+        }
+        EXPECT_EQ(counters.node_deallocations, 20u);
+    }
+
+    TYPED_TEST(LinkedListInstrumentation, ArenaClearBalancesNodeEvents) {
+        std::pmr::monotonic_buffer_resource arena;
+        auto &counters = dsl::thread_counters_policy::counters();
+        dsl::thread_counters_policy::reset();
+
+        TypeParam list({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }, &arena);
+        list.clear();
+        EXPECT_TRUE(list.empty());
+        EXPECT_EQ(counters.node_allocations, 10u);
+        EXPECT_EQ(counters.node_deallocations, 10u);
+    }
+
+    TYPED_TEST(LinkedListInstrumentation, FailedCompactBalancesNodeEvents) {
+        TypeParam list{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+        auto &counters = dsl::thread_counters_policy::counters();
+        dsl::thread_counters_policy::reset();
+
+        limited_resource resource(4);
+        EXPECT_THROW(list.compact(&resource), std::bad_alloc);
+        EXPECT_EQ(counters.node_allocations, 4u);
+        EXPECT_EQ(counters.node_deallocations, 4u);
+        EXPECT_EQ(list.size(), 10u);
+    }
+
+}
@@ -0,0 +1,152 @@
+// Stress tests for snapshot_list, meant to be run under ThreadSanitizer and AddressSanitizer as
+// well as in plain builds (see DSL_LIST_SANITIZE in CMakeLists.txt).
+
+#include "snapshot_list.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+    constexpr std::size_t reader_count = 4;
+    constexpr std::size_t version_length = 64;
+
+    // Version v holds version_length copies of v, so a torn read shows up as a mismatch
+    dsl::list<std::uint64_t> make_version(const std::uint64_t v) {
+        return dsl::list<std::uint64_t>(version_length, v);
+    }
+
+    std::size_t count_retired_after_reclaim(dsl::snapshot_list<std::uint64_t> &list) {
+        list.reclaim();
+        return list.retired_count();
+    }
+
+
+    TEST(SnapshotList, ReadersSeeWholeVersionsWhileAWriterCommits) {
+        constexpr std::uint64_t commit_count = 5000;
+        dsl::snapshot_list<std::uint64_t> list(make_version(0));
+        std::atomic<bool> done{ false };
+        std::atomic<std::size_t> torn{ 0 };
+        std::atomic<std::size_t> reversed{ 0 };
+
+        std::vector<std::thread> readers;
+        for (std::size_t r = 0; r < reader_count; ++r) {
+            readers.emplace_back([&] {
+                std::uint64_t last = 0;
+                while (!done.load(std::memory_order_acquire)) {
+                    auto snapshot = list.read();
+                    auto version = snapshot[0];
+                    if (snapshot.size() != version_length)
+                        torn.fetch_add(1, std::memory_order_relaxed);
+                    for (auto value : snapshot) {
+                        if (value != version)
+                            torn.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    // Versions are published in order, so a thread never sees an older one again
+                    if (version < last)
+                        reversed.fetch_add(1, std::memory_order_relaxed);
+                    last = version;
+                }
+            });
+        }
+
+        for (std::uint64_t v = 1; v <= commit_count; ++v) {
+            list.update([&](auto &draft) {
+                for (auto &value : draft)
+                    value = v;
+            });
+        }
+        done.store(true, std::memory_order_release);
+        for (auto &reader : readers)
+            reader.join();
+
+        EXPECT_EQ(torn.load(), 0u);
+        EXPECT_EQ(reversed.load(), 0u);
+        EXPECT_EQ(list.read()[0], commit_count);
+        EXPECT_EQ(count_retired_after_reclaim(list), 0u);
+    }
+
+    TEST(SnapshotList, NestedAndCopiedSnapshotsKeepTheirVersion) {
+        dsl::snapshot_list<std::uint64_t> list(make_version(0));
+        {
+            auto outer = list.read();
+            {
+                auto copy = outer;
+                list.update([](auto &draft) { draft.assign(version_length, 1); });
+                auto nested = list.read();
+                list.update([](auto &draft) { draft.assign(version_length, 2); });
+
+                EXPECT_EQ(outer[0], 0u);
+                EXPECT_EQ(copy[version_length - 1], 0u);
+                EXPECT_EQ(nested[0], 1u);
+                EXPECT_EQ(count_retired_after_reclaim(list), 2u);
+            }
+            // The outer snapshot still pins the thread's epoch
+            EXPECT_EQ(outer[0], 0u);
+            EXPECT_EQ(count_retired_after_reclaim(list), 2u);
+        }
+        EXPECT_EQ(count_retired_after_reclaim(list), 0u);
+        EXPECT_EQ(list.read()[0], 2u);
+    }
+
+    TEST(SnapshotList, ExitedThreadsReuseTheirRecords) {
+        dsl::snapshot_list<std::uint64_t> list(make_version(0));
+        std::set<const dsl::details::epoch_record*> records;
+
+        // Each thread releases its record on exit, so the next one claims the same record
+        for (int i = 0; i < 32; ++i) {
+            std::thread([&] {
+                auto snapshot = list.read();
+                EXPECT_EQ(snapshot.size(), version_length);
+                records.insert(&dsl::details::epoch_domain::instance().local_record());
+            }).join();
+            list.update([&](auto &draft) { draft[0] = static_cast<std::uint64_t>(i); });
+        }
+
+        EXPECT_EQ(records.size(), 1u);
+        EXPECT_EQ(count_retired_after_reclaim(list), 0u);
+    }
+
+    TEST(SnapshotList, RetiredVersionsAreReclaimedAfterTheReaderReleases) {
+        dsl::snapshot_list<std::uint64_t> list(make_version(0));
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool reading = false, release = false;
+
+        std::thread reader([&] {
+            auto snapshot = list.read();
+            std::unique_lock<std::mutex> lock(mutex);
+            reading = true;
+            cv.notify_all();
+            cv.wait(lock, [&] { return release; });
+            EXPECT_EQ(snapshot[0], 0u);
+        });
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return reading; });
+        }
+        for (std::uint64_t v = 1; v <= 10; ++v)
+            list.update([&](auto &draft) { draft.assign(version_length, v); });
+        EXPECT_EQ(count_retired_after_reclaim(list), 10u);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            release = true;
+        }
+        cv.notify_all();
+        reader.join();
+
+        EXPECT_EQ(count_retired_after_reclaim(list), 0u);
+    }
+
+}
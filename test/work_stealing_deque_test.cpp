@@ -0,0 +1,157 @@
+// Stress tests for work_stealing_deque and work_stealing_pool, meant to be run under
+// ThreadSanitizer as well as in plain builds (see DSL_LIST_SANITIZE in CMakeLists.txt).
+
+#include "work_stealing_deque.h"
+#include "work_stealing_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+    constexpr std::size_t thief_count = 4;
+
+    // Runs the thieves until stop is set and the deque is drained, recording each stolen item
+    std::vector<std::thread> start_thieves(dsl::work_stealing_deque<std::uint32_t> &deque,
+                                           std::vector<std::atomic<std::uint32_t>> &taken,
+                                           std::atomic<bool> &stop) {
+        std::vector<std::thread> thieves;
+        for (std::size_t i = 0; i < thief_count; ++i) {
+            thieves.emplace_back([&] {
+                while (!stop.load(std::memory_order_acquire) || !deque.empty()) {
+                    if (auto item = deque.steal())
+                        taken[*item].fetch_add(1, std::memory_order_relaxed);
+                    else
+                        std::this_thread::yield();
+                }
+            });
+        }
+        return thieves;
+    }
+
+
+    TEST(WorkStealingDeque, EveryItemIsTakenOnceWhileTheBufferGrows) {
+        constexpr std::uint32_t item_count = 200000;
+        dsl::work_stealing_deque<std::uint32_t> deque(2);
+        std::vector<std::atomic<std::uint32_t>> taken(item_count);
+        std::atomic<bool> stop{ false };
+        auto thieves = start_thieves(deque, taken, stop);
+
+        // Bursts of pushes outgrow the buffer while thieves read from it; some are popped back
+        for (std::uint32_t next = 0; next < item_count; ) {
+            for (int i = 0; i < 256 && next < item_count; ++i)
+                deque.push(next++);
+            for (int i = 0; i < 64; ++i) {
+                if (auto item = deque.pop())
+                    taken[*item].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        while (auto item = deque.pop())
+            taken[*item].fetch_add(1, std::memory_order_relaxed);
+
+        stop.store(true, std::memory_order_release);
+        for (auto &thief : thieves)
+            thief.join();
+
+        EXPECT_GT(deque.capacity(), 2u);
+        for (std::uint32_t i = 0; i < item_count; ++i)
+            ASSERT_EQ(taken[i].load(), 1u) << "item " << i;
+    }
+
+    TEST(WorkStealingDeque, LastElementGoesToExactlyOneThread) {
+        constexpr std::uint32_t item_count = 100000;
+        dsl::work_stealing_deque<std::uint32_t> deque;
+        std::vector<std::atomic<std::uint32_t>> taken(item_count);
+        std::atomic<bool> stop{ false };
+        auto thieves = start_thieves(deque, taken, stop);
+
+        // A single element at a time, so that every pop races the thieves for the last one
+        for (std::uint32_t i = 0; i < item_count; ++i) {
+            deque.push(i);
+            if (auto item = deque.pop())
+                taken[*item].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        stop.store(true, std::memory_order_release);
+        for (auto &thief : thieves)
+            thief.join();
+
+        EXPECT_TRUE(deque.empty());
+        for (std::uint32_t i = 0; i < item_count; ++i)
+            ASSERT_EQ(taken[i].load(), 1u) << "item " << i;
+    }
+
+
+    std::uint64_t parallel_sum(dsl::work_stealing_pool &pool, const std::uint64_t first, const std::uint64_t last) {
+        if (last - first <= 64) {
+            std::uint64_t sum = 0;
+            for (auto i = first; i < last; ++i)
+                sum += i;
+            return sum;
+        }
+
+        auto middle = first + (last - first) / 2;
+        std::uint64_t left = 0, right = 0;
+        pool.join([&] { left = parallel_sum(pool, first, middle); },
+                  [&] { right = parallel_sum(pool, middle, last); });
+        return left + right;
+    }
+
+    TEST(WorkStealingPool, ForkJoinSum) {
+        dsl::work_stealing_pool pool(4);
+        constexpr std::uint64_t n = 1 << 18;
+
+        for (int round = 0; round < 4; ++round) {
+            std::uint64_t sum = 0;
+            pool.run([&] { sum = parallel_sum(pool, 0, n); });
+            EXPECT_EQ(sum, n * (n - 1) / 2);
+        }
+    }
+
+    TEST(WorkStealingPool, JoinWaitsForAStolenTask) {
+        dsl::work_stealing_pool pool(2);
+
+        for (int round = 0; round < 3; ++round) {
+            // Long enough for the other worker to go to sleep, so that the fork must wake it
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+            std::atomic<bool> forked_started{ false };
+            std::thread::id joiner, thief;
+            pool.run([&] {
+                joiner = std::this_thread::get_id();
+                // f cannot finish until g runs, so g must be stolen by the other worker
+                pool.join([&] {
+                              while (!forked_started.load(std::memory_order_acquire))
+                                  std::this_thread::yield();
+                          },
+                          [&] {
+                              thief = std::this_thread::get_id();
+                              forked_started.store(true, std::memory_order_release);
+                          });
+            });
+            EXPECT_NE(joiner, thief);
+        }
+    }
+
+    TEST(WorkStealingPool, SleepingWorkersWakeForSubmittedTasks) {
+        dsl::work_stealing_pool pool(4);
+        std::atomic<std::size_t> ran{ 0 };
+
+        for (int round = 0; round < 3; ++round) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            for (int i = 0; i < 1000; ++i)
+                pool.submit([&] { ran.fetch_add(1, std::memory_order_relaxed); });
+            pool.wait_idle();
+            EXPECT_EQ(ran.load(), static_cast<std::size_t>(1000 * (round + 1)));
+        }
+    }
+
+}